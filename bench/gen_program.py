@@ -0,0 +1,219 @@
+import random
+import sys
+from dataclasses import dataclass, field, fields, replace
+from typing import List
+
+# Shape of a synthetic program: how many globals, how deep the if/while nesting goes (and how likely a statement is to
+# open one), how many statements a function body holds and how many calls each function makes (always to functions
+# declared before it, so it is well formed)
+@dataclass
+class Shape:
+    globals: int = 32
+    arrays: int = 4
+    depth: int = 3
+    nesting: float = 0.35
+    statements: int = 24
+    calls: int = 4
+    params: int = 3
+
+shapes = {
+    "mixed":   Shape(),
+    "globals": Shape(globals=2000, arrays=200, depth=2, statements=16, calls=2),
+    "deep":    Shape(depth=32, nesting=0.9, statements=64, calls=2),
+    "long":    Shape(depth=2, statements=600, calls=8),
+    "calls":   Shape(depth=1, statements=12, calls=40, params=6),
+}
+
+arraySize = 8
+relationals = ["<", "<=", ">", ">=", "==", "!="]
+
+@dataclass
+class Function:
+    name: str
+    isVoid: bool
+    params: int
+
+@dataclass
+class Generator:
+    shape: Shape
+    rand: random.Random
+    lines: List[str] = field(default_factory=list)
+    functions: List[Function] = field(default_factory=list)
+    scalars: List[str] = field(default_factory=list)
+    vectors: List[str] = field(default_factory=list)
+    budget: int = 0
+
+    def emit(self, indent: int, text: str):
+        self.lines.append("    " * indent + text)
+
+    def operand(self) -> str:
+        pick = self.rand.random()
+        if (pick < 0.2):
+            return str(self.rand.randint(0, 99))
+        if (pick < 0.3 and len(self.vectors) > 0):
+            return f"{self.rand.choice(self.vectors)}[{self.rand.randint(0, arraySize - 1)}]"
+        return self.rand.choice(self.scalars)
+
+    def expression(self, depth: int = 2) -> str:
+        if (depth == 0 or self.rand.random() < 0.3):
+            return self.operand()
+
+        op = self.rand.choice(["+", "+", "-", "-", "*", "/", "<<", ">>"])
+        if (op == "/"):
+            return f"{self.expression(depth - 1)} / {self.rand.randint(1, 9)}"
+        if (op in ("<<", ">>")):
+            return f"(({self.expression(depth - 1)}) {op} {self.rand.randint(1, 3)})"
+        return f"{self.expression(depth - 1)} {op} {self.expression(depth - 1)}"
+
+    def condition(self) -> str:
+        test = f"{self.expression(1)} {self.rand.choice(relationals)} {self.expression(1)}"
+        if (self.rand.random() < 0.25):
+            test += f" {self.rand.choice(['&&', '||'])} {self.expression(1)} {self.rand.choice(relationals)} {self.expression(1)}"
+        return test
+
+    def call(self, callee: Function) -> str:
+        args = [self.expression(1) for _ in range(callee.params)]
+        return f"{callee.name}({', '.join(args + [self.rand.choice(self.vectors)])})"
+
+    def statement(self, indent: int, depth: int, locals: List[str], calls: List[Function]):
+        pick = self.rand.random()
+        self.budget -= 1
+
+        if (len(calls) > 0 and pick < 0.25):
+            callee = calls.pop()
+            if (callee.isVoid):
+                self.emit(indent, f"{self.call(callee)};")
+            else:
+                self.emit(indent, f"{self.rand.choice(locals)} = {self.call(callee)};")
+        elif (depth < self.shape.depth and self.budget > 0 and self.rand.random() < self.shape.nesting):
+            if (pick < 0.6):
+                self.ifStatement(indent, depth, locals, calls)
+            else:
+                self.whileStatement(indent, depth, locals, calls)
+        elif (pick < 0.55):
+            vector = self.rand.choice(self.vectors)
+            self.emit(indent, f"{vector}[{self.rand.randint(0, arraySize - 1)}] = {self.expression()};")
+        elif (pick < 0.75 and self.shape.globals > 0):
+            target = f"g{self.rand.randrange(self.shape.globals)}"
+            self.emit(indent, f"{target} = {target} + {self.expression()};")
+        else:
+            self.emit(indent, f"{self.rand.choice(locals)} = {self.expression()};")
+
+    def ifStatement(self, indent: int, depth: int, locals: List[str], calls: List[Function]):
+        self.emit(indent, f"if ({self.condition()}) {{")
+        self.block(indent + 1, depth + 1, locals, calls)
+        if (self.rand.random() < 0.5):
+            self.emit(indent, "} else {")
+            self.block(indent + 1, depth + 1, locals, calls)
+        self.emit(indent, "}")
+
+    def whileStatement(self, indent: int, depth: int, locals: List[str], calls: List[Function]):
+        counter = f"c{depth}"
+        self.emit(indent, f"{counter} = 0;")
+        self.emit(indent, f"while ({counter} < {self.rand.randint(2, 9)}) {{")
+        self.block(indent + 1, depth + 1, locals, calls)
+        self.emit(indent + 1, f"{counter} = {counter} + 1;")
+        self.emit(indent, "}")
+
+    # A block always holds one statement and, budget allowing, up to two more; nested blocks draw from the same
+    # per-function budget, so deep shapes grow one long chain of nesting rather than an exponential tree
+    def block(self, indent: int, depth: int, locals: List[str], calls: List[Function]):
+        for i in range(self.rand.randint(1, 3)):
+            if (i > 0 and self.budget <= 0):
+                break
+            self.statement(indent, depth, locals, calls)
+
+    def function(self, index: int):
+        isVoid = (index % 4 == 3)
+        params = [f"p{i}" for i in range(self.shape.params)]
+        locals = [f"t{i}" for i in range(4)]
+        counters = [f"c{i}" for i in range(self.shape.depth)]
+        signature = ", ".join([f"int {p}" for p in params] + ["int v[]"])
+
+        self.emit(0, f"{'void' if isVoid else 'int'} f{index}({signature})")
+        self.emit(0, "{")
+        for name in locals + counters:
+            self.emit(1, f"int {name};")
+        for name in locals:
+            self.emit(1, f"{name} = {self.rand.randint(0, 9)};")
+
+        self.scalars = params + locals + [f"g{i}" for i in range(min(self.shape.globals, 64))]
+        self.vectors = ["v"] + [f"a{self.rand.randrange(self.shape.arrays)}" for _ in range(min(self.shape.arrays, 2))]
+
+        # Calls go to any of the (up to) 64 functions declared right before this one
+        earlier = self.functions[-64:]
+        calls = [self.rand.choice(earlier) for _ in range(self.shape.calls)] if (len(earlier) > 0) else []
+
+        self.budget = self.shape.statements
+        while (self.budget > 0 or len(calls) > 0):
+            self.statement(1, 0, locals, calls)
+
+        if (not isVoid):
+            self.emit(1, f"return {self.expression()};")
+        self.emit(0, "}")
+        self.emit(0, "")
+
+        self.functions.append(Function(f"f{index}", isVoid, self.shape.params))
+
+    def program(self, lines: int):
+        for i in range(self.shape.globals):
+            self.emit(0, f"int g{i};")
+        for i in range(self.shape.arrays):
+            self.emit(0, f"int a{i}[{arraySize}];")
+        self.emit(0, "")
+
+        while (len(self.lines) < lines - 8 or len(self.functions) == 0):
+            self.function(len(self.functions))
+
+        self.emit(0, "void main(void)")
+        self.emit(0, "{")
+        self.emit(1, "int r;")
+        self.emit(1, "r = input();")
+        for callee in self.functions[-4:]:
+            args = ", ".join(["r"] * callee.params + ["a0"])
+            if (callee.isVoid):
+                self.emit(1, f"{callee.name}({args});")
+            else:
+                self.emit(1, f"output({callee.name}({args}));")
+        self.emit(0, "}")
+
+def generateProgram(shape: Shape, lines: int, seed: int) -> List[str]:
+    generator = Generator(replace(shape, arrays=max(shape.arrays, 1), params=max(shape.params, 1)), random.Random(seed))
+    generator.program(lines)
+    return generator.lines
+
+def main(argv: List[str]):
+    # Usage: gen_program.py [--lines n] [--shape mixed|globals|deep|long|calls] [--globals n] [--arrays n] [--depth n]
+    #                       [--nesting p] [--statements n] [--calls n] [--params n] [--seed n] [-o file]
+    options = {}
+    arguments = iter(argv)
+
+    for arg in arguments:
+        if (arg.startswith("--") or arg == "-o"):
+            options[arg.lstrip("-")] = next(arguments, None)
+        else:
+            print(f"> Misc Error\n     Unknown argument \"{arg}\".")
+            sys.exit(1)
+
+    if (options.get("shape", "mixed") not in shapes):
+        print(f"> Misc Error\n     Unknown shape \"{options['shape']}\" (one of: {', '.join(shapes)}).")
+        sys.exit(1)
+
+    shape = shapes[options.get("shape", "mixed")]
+    # Each Shape field takes its own type from the command line (--nesting is a probability, the rest are counts)
+    try:
+        shape = replace(shape, **{f.name: f.type(options[f.name]) for f in fields(Shape) if f.name in options})
+    except (TypeError, ValueError):
+        print(f"> Misc Error\n     Invalid value in {' '.join(argv)}.")
+        sys.exit(1)
+
+    source = generateProgram(shape, int(options.get("lines", 1000)), int(options.get("seed", 1)))
+
+    if ("o" in options):
+        with open(options["o"], "w") as file:
+            file.write("\n".join(source) + "\n")
+    else:
+        print("\n".join(source))
+
+if __name__ == "__main__":
+    main(sys.argv[1:])
@@ -0,0 +1,108 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Semantic Analysis and Intermediate Code Generation benchmark for a C- Compiler
+ *  File: ir_bench.c
+ *---------------------------------*/
+
+#define _DEFAULT_SOURCE
+
+#include "globals.h"
+#include "context.h"
+#include "utils.h"
+
+#include <spawn.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+extern char **environ;
+
+/*--------------------------------------------/
+ *  Allocate and Set → Global Significant Variables (no tracing while timing)
+ *---------------------------------*/
+
+ char *INPUT_DIR = "inputs";
+ char *OUTPUT_DIR = "outputs";
+ char *BACKEND_DIR = "src";
+ char *PYTHON = "python3";
+ int OPT_LEVEL = 1;
+ bool MIDCODE_TEXT = false;
+
+#define REPEATS 5
+
+/*  GENERATOR → Synthetic program generator (run from the repository root, as the Makefile does)  */
+#define GENERATOR "bench/gen_program.py"
+
+/*  generateProgram() → Writes a synthetic C- program of about "lines" lines and the given shape with GENERATOR (the same
+ *  programs "make stress" times) and returns how many lines it came out with  */
+static long generateProgram(const char *path, int lines, const char *shape) {
+    char count[16];
+    snprintf(count, sizeof(count), "%d", lines);
+
+    char *args[] = { PYTHON, GENERATOR, "--shape", (char *)shape, "--lines", count, "-o", (char *)path, NULL };
+    pid_t pid;
+    int status = posix_spawnp(&pid, PYTHON, NULL, NULL, args, environ);
+
+    if (status != 0 || waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        printf("> Misc Error\n     \"%s\" could not generate \"%s\".\n", GENERATOR, path);
+        exit(EXIT_FAILURE);
+    }
+
+    return countLines(path);
+}
+
+/*  benchmark() → Compiles a source up to the Intermediate Code, keeping the best semanticAnalysis() and midCodeGenerate() times (s);
+ *  the latter covers codeGen() and all that follows it (the -O1 passes, register allocation and writing the list)  */
+static void benchmark(const char *source, const char *midcode, double *semantic, double *ir, int *quads) {
+    *semantic = *ir = -1;
+
+    for (int r = 0; r < REPEATS; r++) {
+        CompilerContext *ctx = newContext();
+        ctx->listing = fopen("/dev/null", "w");
+
+        if (!openSource(ctx, source, midcode)) {
+            printf("> Misc Error\n     Invalid file.\n");
+            exit(EXIT_FAILURE);
+        }
+
+        syntaxAnalysis(ctx);
+
+        double start = now();
+        semanticAnalysis(ctx);
+        double middle = now();
+        midCodeGenerate(ctx);
+        double end = now();
+
+        if (*semantic < 0 || middle - start < *semantic) *semantic = middle - start;
+        if (*ir < 0 || end - middle < *ir) *ir = end - middle;
+        *quads = ctx->quadruples.count;
+
+        freeContext(ctx);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    /* Usage: ir_bench [max. lines] [shape]  */
+    int maxLines = (argc > 1) ? atoi(argv[1]) : 40000;
+    const char *shape = (argc > 2) ? argv[2] : "mixed";
+    char source[64], midcode[64];
+
+    snprintf(source, sizeof(source), "/tmp/ir_bench_%d.cm", (int)getpid());
+    snprintf(midcode, sizeof(midcode), "/tmp/ir_bench_%d.ir", (int)getpid());
+
+    printf("\n> Semantic Analysis and Intermediate Code Generation benchmark (%s programs, best of %d)\n", shape, REPEATS);
+    printf("%10s %10s %14s %14s %20s\n", "lines", "quads", "semantic (ms)", "IR + opt (ms)", "quads/ms (IR + opt)");
+
+    for (int target = 625; target <= maxLines; target *= 2) {
+        long lines = generateProgram(source, target, shape);
+        int quads = 0;
+        double semantic, ir;
+
+        benchmark(source, midcode, &semantic, &ir, &quads);
+
+        printf("%10ld %10d %14.3f %14.3f %20.1f\n", lines, quads, semantic * 1e3, ir * 1e3, quads / (ir * 1e3));
+        fflush(stdout);
+    }
+
+    remove(source);
+    remove(midcode);
+    return 0;
+}
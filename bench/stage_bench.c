@@ -0,0 +1,269 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Per-stage time and memory benchmark for a C- Compiler
+ *  File: stage_bench.c
+ *---------------------------------*/
+
+#define _DEFAULT_SOURCE
+
+#include "globals.h"
+#include "context.h"
+#include "utils.h"
+#include "parser.tab.h"
+
+#include <fcntl.h>
+#include <malloc.h>
+#include <spawn.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+extern char **environ;
+
+/*--------------------------------------------/
+ *  Allocate and Set → Global Significant Variables (no tracing while timing)
+ *---------------------------------*/
+
+ char *INPUT_DIR = "inputs";
+ char *OUTPUT_DIR = "outputs";
+ char *BACKEND_DIR = "src";
+ char *PYTHON = "python3";
+ int OPT_LEVEL = 1;
+ bool MIDCODE_TEXT = false;
+
+typedef enum {
+    StageScanner, StageParser, StageSemantic, StageMidCode, StageAssembly, StageBinary, STAGES
+} Stage;
+
+static const char *stageNames[STAGES] = { "scanner", "parser", "semantic", "midcode", "assembly", "binary" };
+
+/*  (struct StageResult) StageResult → Best wall time (s) and peak resident set size (KiB) of one stage, or why it failed
+ *  (a Python stage rejecting the program, e.g. a branch too far for its 16 bit offset)  */
+typedef struct {
+    double time;
+    long rss;
+    bool failed;
+    char reason[160];
+} StageResult;
+
+/*  folder → Scratch folder the stages write into (/tmp/stage_bench_<pid>), removed however the benchmark ends  */
+static char folder[64];
+
+/*  removeFolder() → Removes the scratch folder and what the stages left in it  */
+static void removeFolder(void) {
+    char path[600];
+    const char *outputs[] = { "midcode.ir", "assembly.txt", "binary.bin", "stage.log" };
+
+    for (int i = 0; i < 4; i++) {
+        snprintf(path, sizeof(path), "%s/%s", folder, outputs[i]);
+        remove(path);
+    }
+    rmdir(folder);
+}
+
+/*  resetPeakRSS() → Hands the freed heap back to the system and resets the process' peak RSS (VmHWM) to its current RSS,
+ *  so the next reading covers a single stage; where /proc/self/clear_refs is not writable, readings fall back to the peak
+ *  since the process started  */
+static void resetPeakRSS(void) {
+    malloc_trim(0);
+
+    int fd = open("/proc/self/clear_refs", O_WRONLY);
+
+    if (fd >= 0) {
+        if (write(fd, "5", 1) < 0) { /* not supported → cumulative peak */ }
+        close(fd);
+    }
+}
+
+/*  keep() → Keeps the best time of a stage over the repeats, and its highest peak RSS  */
+static void keep(StageResult *result, double time, long rss) {
+    if (result->time < 0 || time < result->time) result->time = time;
+    if (rss > result->rss) result->rss = rss;
+}
+
+/*  openContext() → A fresh context over a source, with every message thrown away  */
+static CompilerContext *openContext(const char *source, const char *midcode) {
+    CompilerContext *ctx = newContext();
+    ctx->listing = fopen("/dev/null", "w");
+
+    if (!openSource(ctx, source, midcode)) {
+        printf("> Misc Error\n     Invalid file \"%s\".\n", source);
+        exit(EXIT_FAILURE);
+    }
+    return ctx;
+}
+
+/*  scanOnly() → Runs the scanner alone over a source, returning the number of tokens  */
+static long scanOnly(const char *source, const char *midcode) {
+    CompilerContext *ctx = openContext(source, midcode);
+    YYSTYPE lval;
+    long tokens = 0;
+
+    scannerInit(ctx);
+    while (getToken(&lval, ctx) != 0) tokens++;
+    scannerDestroy(ctx);
+
+    freeContext(ctx);
+    return tokens;
+}
+
+/*  lastLine() → Last non empty line a stage printed to its log (its error, when it failed)  */
+static void lastLine(const char *log, char *line, size_t size) {
+    FILE *file = fopen(log, "r");
+    char buffer[512];
+
+    snprintf(line, size, "no output");
+    if (file == NULL) return;
+
+    while (fgets(buffer, sizeof(buffer), file) != NULL) {
+        buffer[strcspn(buffer, "\n")] = '\0';
+
+        char *text = buffer + strspn(buffer, " ");
+        if (*text != '\0') snprintf(line, size, "%s", text);
+    }
+    fclose(file);
+}
+
+/*  runStage() → Runs one of the Python back end stages, returning its wall time (s) and its own peak RSS (KiB); when it
+ *  fails, returns -1 and marks "result" failed with the last line it printed  */
+static double runStage(const char *script, const char *input, const char *output, long *rss, StageResult *result) {
+    char path[512], log[600];
+    snprintf(path, sizeof(path), "%s/%s", BACKEND_DIR, script);
+    snprintf(log, sizeof(log), "%s/stage.log", folder);
+
+    char *args[] = { PYTHON, path, (char *)input, (char *)output, NULL };
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, log, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    double start = now();
+    pid_t pid;
+    int status = posix_spawnp(&pid, PYTHON, &actions, NULL, args, environ);
+    posix_spawn_file_actions_destroy(&actions);
+
+    struct rusage usage;
+    if (status != 0 || wait4(pid, &status, 0, &usage) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        result->failed = true;
+        lastLine(log, result->reason, sizeof(result->reason));
+        return -1;
+    }
+
+    *rss = usage.ru_maxrss;
+    return now() - start;
+}
+
+/*  benchmark() → Runs every stage over a source "repeats" times, keeping the best time of each one  */
+static void benchmark(const char *source, int repeats, StageResult results[STAGES], long *tokens, int *quads) {
+    char midcode[600], assembly[600], binary[600];
+
+    snprintf(midcode, sizeof(midcode), "%s/midcode.ir", folder);
+    snprintf(assembly, sizeof(assembly), "%s/assembly.txt", folder);
+    snprintf(binary, sizeof(binary), "%s/binary.bin", folder);
+
+    for (int s = 0; s < STAGES; s++) results[s] = (StageResult){ -1, 0, false, "" };
+
+    for (int r = 0; r < repeats; r++) {
+        double start, end;
+        long rss;
+
+        resetPeakRSS();
+        start = now();
+        *tokens = scanOnly(source, midcode);
+        keep(&results[StageScanner], now() - start, peakRSS());
+
+        /* syntaxAnalysis() scans as it parses → the parser is charged with what is left after the scanner  */
+        CompilerContext *ctx = openContext(source, midcode);
+
+        resetPeakRSS();
+        start = now();
+        syntaxAnalysis(ctx);
+        end = now() - start - results[StageScanner].time;
+        keep(&results[StageParser], (end > 0) ? end : 0, peakRSS());
+
+        resetPeakRSS();
+        start = now();
+        semanticAnalysis(ctx);
+        keep(&results[StageSemantic], now() - start, peakRSS());
+
+        resetPeakRSS();
+        start = now();
+        midCodeGenerate(ctx);
+        keep(&results[StageMidCode], now() - start, peakRSS());
+
+        *quads = ctx->quadruples.count;
+        freeContext(ctx);
+
+        /* A program the back end rejects fails the same way on every repeat: record why and move on   */
+        double time = runStage("assembly_codegen.py", midcode, assembly, &rss, &results[StageAssembly]);
+        if (time < 0) {
+            results[StageBinary].failed = true;
+            snprintf(results[StageBinary].reason, sizeof(results[StageBinary].reason), "no assembly to encode");
+            break;
+        }
+        keep(&results[StageAssembly], time, rss);
+
+        time = runStage("binary_codegen.py", assembly, binary, &rss, &results[StageBinary]);
+        if (time < 0) break;
+        keep(&results[StageBinary], time, rss);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    int repeats = 3;
+    bool csv = false;
+
+    /* Usage: stage_bench [-r repeats] [-c] source.cm ...  */
+    int first = 1;
+    for (; first < argc && argv[first][0] == '-'; first++) {
+        if (strcmp(argv[first], "-r") == 0 && first + 1 < argc) repeats = atoi(argv[++first]);
+        else if (strcmp(argv[first], "-c") == 0) csv = true;
+    }
+
+    if (first == argc || repeats < 1) {
+        printf("> Misc Error\n     Usage: stage_bench [-r repeats] [-c] source.cm ...\n");
+        return EXIT_FAILURE;
+    }
+
+    snprintf(folder, sizeof(folder), "/tmp/stage_bench_%d", (int)getpid());
+    if (mkdir(folder, 0755) != 0) {
+        printf("> Misc Error\n     Could not create the folder \"%s\".\n", folder);
+        return EXIT_FAILURE;
+    }
+    atexit(removeFolder);
+
+    if (csv) printf("source,lines,tokens,quads,stage,ms,rss_kib\n");
+    else printf("\n> Per-stage benchmark (best of %d; peak RSS of the stage alone, Python stages in their own process)\n", repeats);
+
+    for (int i = first; i < argc; i++) {
+        StageResult results[STAGES];
+        long lines = countLines(argv[i]), tokens = 0;
+        int quads = 0;
+
+        benchmark(argv[i], repeats, results, &tokens, &quads);
+
+        if (csv) {
+            for (int s = 0; s < STAGES; s++) {
+                if (results[s].failed) printf("%s,%ld,%ld,%d,%s,failed,\n", argv[i], lines, tokens, quads, stageNames[s]);
+                else printf("%s,%ld,%ld,%d,%s,%.3f,%ld\n", argv[i], lines, tokens, quads, stageNames[s], results[s].time * 1e3, results[s].rss);
+            }
+        } else {
+            double total = 0;
+
+            printf("\n  %s → %ld line(s), %ld token(s), %d quadruple(s)\n", argv[i], lines, tokens, quads);
+            printf("  %10s %12s %14s %16s\n", "stage", "time (ms)", "lines/ms", "peak RSS (KiB)");
+            for (int s = 0; s < STAGES; s++) {
+                if (results[s].failed) {
+                    printf("  %10s %12s   %s\n", stageNames[s], "failed", results[s].reason);
+                    continue;
+                }
+                total += results[s].time;
+                printf("  %10s %12.3f %14.1f %16ld\n", stageNames[s], results[s].time * 1e3, lines / (results[s].time * 1e3 + 1e-9), results[s].rss);
+            }
+            printf("  %10s %12.3f %14.1f%s\n", "total", total * 1e3, lines / (total * 1e3), (results[StageBinary].failed) ? "   (stages that ran)" : "");
+        }
+        fflush(stdout);
+    }
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Arena Allocator for a C- Compiler
+ *  File: arena.c
+ *---------------------------------*/
+
+#include "arena.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ALIGNMENT _Alignof(max_align_t)
+
+/*  newBlock() → Chains a new zeroed block, big enough for at least "size" bytes  */
+static ArenaBlock *newBlock(Arena *arena, size_t size) {
+    size_t blockSize = (size > ARENA_BLOCK_SIZE) ? size : ARENA_BLOCK_SIZE;
+    ArenaBlock *block = calloc(1, sizeof(ArenaBlock) + blockSize);
+
+    if (block == NULL) {
+        printf("> Misc Error\n     Out of memory error. (Arena)\n");
+        exit(EXIT_FAILURE);
+    }
+
+    block->size = blockSize;
+    block->next = arena->blocks;
+
+    arena->blocks = block;
+    arena->reserved += sizeof(ArenaBlock) + blockSize;
+    arena->blocksCount++;
+
+    return block;
+}
+
+/*  arenaAlloc() → Returns "size" zeroed bytes from the arena (aligned to max_align_t)  */
+void *arenaAlloc(Arena *arena, size_t size) {
+    ArenaBlock *block = arena->blocks;
+
+    size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+    if (block == NULL || block->used + size > block->size) block = newBlock(arena, size);
+
+    void *p = block->data + block->used;
+    block->used += size;
+    arena->allocated += size;
+    arena->allocations++;
+
+    return p;
+}
+
+/*  arenaStrdup() → Copies a string into the arena  */
+char *arenaStrdup(Arena *arena, const char *s) {
+    size_t length = strlen(s) + 1;
+    char *copy = arenaAlloc(arena, length);
+
+    memcpy(copy, s, length);
+    return copy;
+}
+
+/*  arenaRelease() → Releases every block of the arena at once  */
+void arenaRelease(Arena *arena) {
+    ArenaBlock *block = arena->blocks;
+
+    while (block != NULL) {
+        ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+
+    arena->blocks = NULL;
+    arena->allocated = 0;
+    arena->reserved = 0;
+    arena->blocksCount = 0;
+}
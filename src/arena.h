@@ -0,0 +1,47 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Arena Allocator interface for a C- Compiler
+ *  File: arena.h
+ *---------------------------------*/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+/*--------------------------------------------/
+ *  Arena structure
+ *---------------------------------*/
+
+#define ARENA_BLOCK_SIZE (64 * 1024)
+
+/*  ArenaBlock → One chunk of memory of an arena, blocks are chained from the newest to the oldest  */
+typedef struct ArenaBlock {
+    struct ArenaBlock *next;
+    size_t size;
+    size_t used;
+    char data[];
+} ArenaBlock;
+
+/*  Arena → Bump allocator owning every AST node, symbol and string of one compilation, released all at once  */
+typedef struct {
+    ArenaBlock *blocks;
+    size_t allocated;
+    size_t reserved;
+    long allocations;
+    int blocksCount;
+} Arena;
+
+/*--------------------------------------------/
+ *  Arena functions
+ *---------------------------------*/
+
+/*  arenaAlloc() → Returns "size" zeroed bytes from the arena (aligned to max_align_t)  */
+void *arenaAlloc(Arena *arena, size_t size);
+
+/*  arenaStrdup() → Copies a string into the arena  */
+char *arenaStrdup(Arena *arena, const char *s);
+
+/*  arenaRelease() → Releases every block of the arena at once  */
+void arenaRelease(Arena *arena);
+
+#endif
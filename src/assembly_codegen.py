@@ -1,14 +1,34 @@
+import sys
 from dataclasses import dataclass
-from typing import List, Optional
+from typing import Callable, List, Optional, Tuple
 
-traceAssembly = True
+import ir_file
+import metrics
+import tracelog
+
+# Trace log the quadruples read and the instructions generated are appended to (None → not traced)
+traceFile = None
+
+# Address of every label and of every function's entry, once assemble() has run (simulator.py reads the latter)
+labelAddresses = {}
+functionAddresses = {}
+
+# Sections (the global declarations, then one per function) and the references left unresolved by assemble()
+sections = []
+relocations = []
+
+# Fixed registers the intermediate code refers to by number, and the names the assembly gives them
+registerAliases = {"r2": "$rf", "r3": "$io", "r4": "$hd", "r26": "$pc"}
+
+# Operand of a quadruple: its AddrType (ir_file.addrVoid, addrConst, addrString or addrTemp) and its text ("---" when void)
+Operand = Tuple[int, str]
 
 @dataclass
 class Quadruple:
     op: str
-    addr_src: str
-    addr_tgt: str
-    addr_dst: str
+    addr_src: Operand
+    addr_tgt: Operand
+    addr_dst: Operand
 
 @dataclass
 class Instruction:
@@ -18,34 +38,55 @@ class Instruction:
     addr_dst: str
 
 def traceAssembler(items: List):
-    if traceAssembly:
-        print("\n> Assembly Code Tracing ----------------------------------------------------")
-        print("----------------------------------------------------------------------------")
-        for i, item in enumerate(items):
+    if (traceFile is not None):
+        tracelog.section(traceFile, "assembly")
+        for item in items:
             if isinstance(item, Quadruple):
-                print(f"        > Quad. [{i:02}]: ({item.op}, {item.addr_src}, {item.addr_tgt}, {item.addr_dst})")
+                traceFile.write(f"Q\t{item.op}\t{item.addr_src[1]}\t{item.addr_tgt[1]}\t{item.addr_dst[1]}\n")
             elif isinstance(item, Instruction):
-                print(f"        > Instr. [{i:02}]: ({item.instr}, {item.addr_src}, {item.addr_tgt}, {item.addr_dst})")
+                traceFile.write(f"I\t{item.instr}\t{item.addr_src}\t{item.addr_tgt}\t{item.addr_dst}\n")
+
 
+# textOperand() → An operand of the text midcode, typed by how it is spelled (the binary file carries the type itself)
+def textOperand(text: str) -> Operand:
+    if (text == "---"):
+        return (ir_file.addrVoid, text)
+    if (text.lstrip("-").isdigit()):
+        return (ir_file.addrConst, text)
+    return (ir_file.addrString, text)
 
+# midcodeTranslate() → Reads the quadruples the front end wrote: the binary midcode.ir (see ir_file.py), whose operands
+# keep the type the front end gave them, or the text midcode.txt dump ("op|src|tgt|dst" lines)
 def midcodeTranslate(path: str) -> List[Quadruple]:
     global source
 
     quads = []
 
+    if (ir_file.isIRFile(path)):
+        ir = ir_file.readIRFile(path)
+        source = ir.source
+
+        for op, srcType, tgtType, dstType, src, tgt, dst in ir.quads:
+            quads.append(Quadruple(ir.ops[op], (srcType, ir_file.operandText(ir, srcType, src)),
+                                   (tgtType, ir_file.operandText(ir, tgtType, tgt)),
+                                   (dstType, ir_file.operandText(ir, dstType, dst))))
+        traceAssembler(quads)
+        return quads
+
     with open(path, 'r') as midcode:
         source = next(midcode).strip()
 
         for line in midcode:
             parts = line.strip().split('|')
             if len(parts) == 4:
-                quad = Quadruple(*[p.strip() for p in parts])
+                quad = Quadruple(parts[0].strip(), *[textOperand(p.strip()) for p in parts[1:]])
                 quads.append(quad)
     traceAssembler(quads)
     return quads
 
 def assemblyCodeGenerate(quads: List[Quadruple]) -> List[Instruction]:
-    global_variables = 0
+    global functionAddresses
+
     global_variable = False
 
     current_function = None
@@ -53,169 +94,176 @@ def assemblyCodeGenerate(quads: List[Quadruple]) -> List[Instruction]:
     local_offset = 0
     global_offset = 0
 
-    labels = {}
-
     registers = []
 
     instructions = []
+    functions = []
+
+    # Global declarations run first, whatever function they follow; "j main" skips the functions before main
+    prelude = []
+    mainFirst = True
 
     for quad in quads:
         operator = quad.op.upper()
-        src = quad.addr_src
-        tgt = quad.addr_tgt
-        dst = quad.addr_dst
+        srcType, src = quad.addr_src
+        tgtType, tgt = quad.addr_tgt
+        _, dst = quad.addr_dst
+
+        # Immediate forms are picked by the operand's type, never by how its text looks
+        srcConst = (srcType == ir_file.addrConst)
+        tgtConst = (tgtType == ir_file.addrConst)
 
         match operator:
             case "ADD":
-                if (src.isdigit() and tgt.isdigit()):
+                if (srcConst and tgtConst):
                     instructions.append(Instruction("movei", src, "-", dst))
                     instructions.append(Instruction("addi", dst, dst, tgt))
-                elif (not src.isdigit() and tgt.isdigit()):
+                elif (not srcConst and tgtConst):
                     instructions.append(Instruction("addi", src, dst, tgt))
-                elif (src.isdigit() and not tgt.isdigit()):
+                elif (srcConst and not tgtConst):
                     instructions.append(Instruction("addi", tgt, dst, src))
                 else:
                     instructions.append(Instruction("add", src, tgt, dst))
 
             case "SUB":
-                if (src.isdigit() and tgt.isdigit()):
+                if (srcConst and tgtConst):
                     instructions.append(Instruction("movei", src, "-", dst))
                     instructions.append(Instruction("subi", dst, dst, tgt))
-                elif (not src.isdigit() and tgt.isdigit()):
+                elif (not srcConst and tgtConst):
                     instructions.append(Instruction("subi", src, dst, tgt))
-                elif (src.isdigit() and not tgt.isdigit()):
+                elif (srcConst and not tgtConst):
                     instructions.append(Instruction("subi", tgt, dst, src))
                 else:
                     instructions.append(Instruction("sub", src, tgt, dst))
 
             case "MUL":
-                if (src.isdigit() and tgt.isdigit()):
+                if (srcConst and tgtConst):
                     instructions.append(Instruction("movei", src, "-", dst))
                     instructions.append(Instruction("muli", dst, dst, tgt))
-                elif (not src.isdigit() and tgt.isdigit()):
+                elif (not srcConst and tgtConst):
                     instructions.append(Instruction("muli", src, dst, tgt))
-                elif (src.isdigit() and not tgt.isdigit()):
+                elif (srcConst and not tgtConst):
                     instructions.append(Instruction("muli", tgt, dst, src))
                 else:
                     instructions.append(Instruction("mul", src, tgt, dst))
 
             case "DIV":
-                if (src.isdigit() and tgt.isdigit()):
+                if (srcConst and tgtConst):
                     instructions.append(Instruction("movei", src, "-", dst))
                     instructions.append(Instruction("divi", dst, dst, tgt))
-                elif (not src.isdigit() and tgt.isdigit()):
+                elif (not srcConst and tgtConst):
                     instructions.append(Instruction("divi", src, dst, tgt))
-                elif (src.isdigit() and not tgt.isdigit()):
+                elif (srcConst and not tgtConst):
                     instructions.append(Instruction("divi", tgt, dst, src))
                 else:
                     instructions.append(Instruction("div", src, tgt, dst))
 
             case "OR":
-                if (src.isdigit() and tgt.isdigit()):
+                if (srcConst and tgtConst):
                     instructions.append(Instruction("movei", src, "-", dst))
                     instructions.append(Instruction("ori", dst, dst, tgt))
-                elif (not src.isdigit() and tgt.isdigit()):
+                elif (not srcConst and tgtConst):
                     instructions.append(Instruction("ori", src, dst, tgt))
-                elif (src.isdigit() and not tgt.isdigit()):
+                elif (srcConst and not tgtConst):
                     instructions.append(Instruction("ori", tgt, dst, src))
                 else:
                     instructions.append(Instruction("or", src, tgt, dst))
 
             case "AND":
-                if (src.isdigit() and tgt.isdigit()):
+                if (srcConst and tgtConst):
                     instructions.append(Instruction("movei", src, "-", dst))
                     instructions.append(Instruction("andi", dst, dst, tgt))
-                elif (not src.isdigit() and tgt.isdigit()):
+                elif (not srcConst and tgtConst):
                     instructions.append(Instruction("andi", src, dst, tgt))
-                elif (src.isdigit() and not tgt.isdigit()):
+                elif (srcConst and not tgtConst):
                     instructions.append(Instruction("andi", tgt, dst, src))
                 else:
                     instructions.append(Instruction("and", src, tgt, dst))
 
             case "LSHIFT":
-                if (src.isdigit() and tgt.isdigit()):
+                if (srcConst and tgtConst):
                     instructions.append(Instruction("movei", src, "-", dst))
                     instructions.append(Instruction("sll", dst, tgt, dst))
-                elif (not src.isdigit() and tgt.isdigit()):
+                elif (not srcConst and tgtConst):
                     instructions.append(Instruction("sll", src, tgt, dst))
-                elif (src.isdigit() and not tgt.isdigit()):
+                elif (srcConst and not tgtConst):
                     instructions.append(Instruction("sll", src, "ERROR", dst))
                 else:
                     instructions.append(Instruction("sll", src, "ERROR", dst))
 
             case "RSHIFT":
-                if (src.isdigit() and tgt.isdigit()):
+                if (srcConst and tgtConst):
                     instructions.append(Instruction("movei", src, "-", dst))
                     instructions.append(Instruction("srl", dst, tgt, dst))
-                elif (not src.isdigit() and tgt.isdigit()):
+                elif (not srcConst and tgtConst):
                     instructions.append(Instruction("srl", src, tgt, dst))
-                elif (src.isdigit() and not tgt.isdigit()):
+                elif (srcConst and not tgtConst):
                     instructions.append(Instruction("srl", src, "ERROR", dst))
                 else:
                     instructions.append(Instruction("srl", src, "ERROR", dst))
 
             case "SGT":
-                if (src.isdigit() and tgt.isdigit()):
+                if (srcConst and tgtConst):
                     instructions.append(Instruction("movei", src, "-", dst))
                     instructions.append(Instruction("sgti", dst, dst, tgt))
-                elif (not src.isdigit() and tgt.isdigit()):
+                elif (not srcConst and tgtConst):
                     instructions.append(Instruction("sgti", src, dst, tgt))
-                elif (src.isdigit() and not tgt.isdigit()):
+                elif (srcConst and not tgtConst):
                     instructions.append(Instruction("sgti", tgt, dst, src))
                 else:
                     instructions.append(Instruction("sgt", src, tgt, dst))
 
             case "SLT":
-                if (src.isdigit() and tgt.isdigit()):
+                if (srcConst and tgtConst):
                     instructions.append(Instruction("movei", src, "-", dst))
                     instructions.append(Instruction("slti", dst, dst, tgt))
-                elif (not src.isdigit() and tgt.isdigit()):
+                elif (not srcConst and tgtConst):
                     instructions.append(Instruction("slti", src, dst, tgt))
-                elif (src.isdigit() and not tgt.isdigit()):
+                elif (srcConst and not tgtConst):
                     instructions.append(Instruction("slti", tgt, dst, src))
                 else:
                     instructions.append(Instruction("slt", src, tgt, dst))
 
             case "SGET":
-                if (src.isdigit() and tgt.isdigit()):
+                if (srcConst and tgtConst):
                     instructions.append(Instruction("movei", src, "-", dst))
                     instructions.append(Instruction("segti", dst, dst, tgt))
-                elif (not src.isdigit() and tgt.isdigit()):
+                elif (not srcConst and tgtConst):
                     instructions.append(Instruction("segti", src, dst, tgt))
-                elif (src.isdigit() and not tgt.isdigit()):
+                elif (srcConst and not tgtConst):
                     instructions.append(Instruction("segti", tgt, dst, src))
                 else:
                     instructions.append(Instruction("segt", src, tgt, dst))
 
             case "SLET":
-                if (src.isdigit() and tgt.isdigit()):
+                if (srcConst and tgtConst):
                     instructions.append(Instruction("movei", src, "-", dst))
                     instructions.append(Instruction("selti", dst, dst, tgt))
-                elif (not src.isdigit() and tgt.isdigit()):
+                elif (not srcConst and tgtConst):
                     instructions.append(Instruction("selti", src, dst, tgt))
-                elif (src.isdigit() and not tgt.isdigit()):
+                elif (srcConst and not tgtConst):
                     instructions.append(Instruction("selti", tgt, dst, src))
                 else:
                     instructions.append(Instruction("selt", src, tgt, dst))
 
             case "SET":
-                if (src.isdigit() and tgt.isdigit()):
+                if (srcConst and tgtConst):
                     instructions.append(Instruction("movei", src, "-", dst))
                     instructions.append(Instruction("seti", dst, dst, tgt))
-                elif (not src.isdigit() and tgt.isdigit()):
+                elif (not srcConst and tgtConst):
                     instructions.append(Instruction("seti", src, dst, tgt))
-                elif (src.isdigit() and not tgt.isdigit()):
+                elif (srcConst and not tgtConst):
                     instructions.append(Instruction("seti", tgt, dst, src))
                 else:
                     instructions.append(Instruction("set", src, tgt, dst))
 
             case "SDT":
-                if (src.isdigit() and tgt.isdigit()):
+                if (srcConst and tgtConst):
                     instructions.append(Instruction("movei", src, "-", dst))
                     instructions.append(Instruction("sdti", dst, dst, tgt))
-                elif (not src.isdigit() and tgt.isdigit()):
+                elif (not srcConst and tgtConst):
                     instructions.append(Instruction("sdti", src, dst, tgt))
-                elif (src.isdigit() and not tgt.isdigit()):
+                elif (srcConst and not tgtConst):
                     instructions.append(Instruction("sdti", tgt, dst, src))
                 else:
                     instructions.append(Instruction("sdt", src, tgt, dst))
@@ -234,10 +282,9 @@ def assemblyCodeGenerate(quads: List[Quadruple]) -> List[Instruction]:
 
                 if src == "global":
                     variable_offsets.setdefault("global", {})[tgt] = global_offset
-                    instructions.append(Instruction("addi", "$gp", "$aux", str(global_offset+1)))
-                    instructions.append(Instruction("store", "$gp", "$aux", str(global_offset)))
+                    prelude.append(Instruction("addi", "$gp", "$aux", str(global_offset+1)))
+                    prelude.append(Instruction("store", "$gp", "$aux", str(global_offset)))
                     global_offset += array_size
-                    global_variables += 2
                 else:
                     variable_offsets.setdefault(current_function, {})[tgt] = local_offset
                     if (dst == "0"):
@@ -251,7 +298,7 @@ def assemblyCodeGenerate(quads: List[Quadruple]) -> List[Instruction]:
             case "STOREVAR":
                 if dst in variable_offsets.get("global", {}):
                     offset = variable_offsets["global"][dst]
-                    if (src.isdigit()):
+                    if (srcConst):
                         instructions.append(Instruction("movei", src, "-", "$aux"))
                         instructions.append(Instruction("store", "$gp", "$aux", str(offset)))
                     else:
@@ -259,7 +306,7 @@ def assemblyCodeGenerate(quads: List[Quadruple]) -> List[Instruction]:
                     global_variable = False
                 else:
                     offset = variable_offsets[tgt][dst]
-                    if (src.isdigit()):
+                    if (srcConst):
                         instructions.append(Instruction("movei", src, "-", "$aux"))
                         instructions.append(Instruction("store", "$fp", "$aux", str(offset)))
                     else:
@@ -267,14 +314,14 @@ def assemblyCodeGenerate(quads: List[Quadruple]) -> List[Instruction]:
 
             case "STOREARRAY":
                 if (global_variable):
-                    if (src.isdigit()):
+                    if (srcConst):
                         instructions.append(Instruction("movei", src, "-", "$aux"))
                         instructions.append(Instruction("store", dst, "$aux", "0"))
                     else:
                         instructions.append(Instruction("store", dst, src, "0"))
                     global_variable = False
                 else:
-                    if (src.isdigit()):
+                    if (srcConst):
                         instructions.append(Instruction("movei", src, "-", "$aux"))
                         instructions.append(Instruction("store", dst, "$aux", "0"))
                     else:
@@ -300,49 +347,54 @@ def assemblyCodeGenerate(quads: List[Quadruple]) -> List[Instruction]:
                 instructions.append(Instruction("beq", src, "$zero", tgt))
 
             case "LABEL":
-                if "main" in labels:
-                    labels[src] = len(instructions)
-                else:
-                    labels[src] = len(instructions) + 1
+                instructions.append(Instruction("label", src, "-", "-"))
 
             case "JUMP":
                 instructions.append(Instruction("j", src, "-", "-"))
 
             case "FUNBGN":
                 if (src.lower() == "main"):
-                    labels[src.lower()] = len(instructions) + 1
-                    if (labels[src.lower()] > 1):
-                        instructions.insert(global_variables, Instruction("j", labels[src.lower()], "-", "-"))
+                    mainFirst = (len(instructions) == 0)
+                    instructions.append(Instruction("label", "main", "-", "-"))
                     local_offset = 0
                 else:
-                    labels[src] = len(instructions) + 1
-                    instructions.append(Instruction("store", "$fp", "$ra", "1"))
+                    instructions.append(Instruction("label", src, "-", "-"))
+                    # Leaf functions (no calls) never overwrite $ra: its slot is kept, not stored
+                    if (dst != "leaf"):
+                        instructions.append(Instruction("store", "$fp", "$ra", "1"))
                     instructions.append(Instruction("addi", "$sp", "$sp", "1"))
                     local_offset = 2
 
                 current_function = src
                 variable_offsets[current_function] = {}
+                functions.append(src)
 
             case "FUNEND":
                 if (src.lower() != "main"):
-                    instructions.append(Instruction("load", "$fp", "$ra", "1"))
+                    if (dst != "leaf"):
+                        instructions.append(Instruction("load", "$fp", "$ra", "1"))
                     instructions.append(Instruction("jr", "$ra", "-", "-"))
 
             case "PARAM":
                 registers.append(src)
 
             case "CALL":
+                # A call takes (and consumes) its own parameters only: the last "tgt" queued ones
+                count = int(tgt)
+                params = registers[len(registers)-count:]
+                del registers[len(registers)-count:]
+
                 if (src.lower() == "halt"):
                     instructions.append(Instruction("halt", "-", "-", "-"))
                 elif (src.lower() == "execute"):
                     instructions.append(Instruction("store", "$zero", "$fp", "29"))
                     instructions.append(Instruction("store", "$zero", "$sp", "30"))
-                    instructions.append(Instruction("dmset", registers[-1], "-", "-"))
+                    instructions.append(Instruction("dmset", params[-1], "-", "-"))
                     instructions.append(Instruction("movei", "127", "-", "$fp"))
                     instructions.append(Instruction("movei", "127", "-", "$sp"))
                     instructions.append(Instruction("pcbkp", "-", "$so", "-"))
                     instructions.append(Instruction("addi", "$so", "$so", "2"))
-                    instructions.append(Instruction("jimset", "$zero", registers[-2], "-"))
+                    instructions.append(Instruction("jimset", "$zero", params[-2], "-"))
                     instructions.append(Instruction("dmset", "$zero", "-", "-"))
                     instructions.append(Instruction("load", "$zero", "$fp", "29"))
                     instructions.append(Instruction("load", "$zero", "$sp", "30"))
@@ -350,7 +402,7 @@ def assemblyCodeGenerate(quads: List[Quadruple]) -> List[Instruction]:
                 elif (src.lower() == "setupprogram"):
                     instructions.append(Instruction("store", "$zero", "$fp", "29"))
                     instructions.append(Instruction("store", "$zero", "$sp", "30"))
-                    instructions.append(Instruction("dmset", registers[-1], "-", "-"))
+                    instructions.append(Instruction("dmset", params[-1], "-", "-"))
                     instructions.append(Instruction("movei", "127", "-", "$fp"))
                     instructions.append(Instruction("movei", "127", "-", "$sp"))
                     instructions.append(Instruction("store", "$zero", "$fp", "29"))
@@ -392,13 +444,13 @@ def assemblyCodeGenerate(quads: List[Quadruple]) -> List[Instruction]:
                     instructions.append(Instruction("store", "$zero", "$fp", "29"))
                     instructions.append(Instruction("store", "$zero", "$sp", "30"))
                     instructions.append(Instruction("store", "$zero", "$ra", "31"))
-                    instructions.append(Instruction("dmset", registers[-2], "-", "-"))
+                    instructions.append(Instruction("dmset", params[-2], "-", "-"))
                     # # Setting up for Jump -----------------------------------------
-                    instructions.append(Instruction("move", registers[-4], "-", "$pc"))
-                    instructions.append(Instruction("move", registers[-3], "-", "$off"))
+                    instructions.append(Instruction("move", params[-4], "-", "$pc"))
+                    instructions.append(Instruction("move", params[-3], "-", "$off"))
                     # # Setting Timer -----------------------------------------------
-                    instructions.append(Instruction("addi", registers[-1], registers[-1], "30"))
-                    instructions.append(Instruction("setTimer", registers[-1], "-", "-"))
+                    instructions.append(Instruction("addi", params[-1], params[-1], "30"))
+                    instructions.append(Instruction("setTimer", params[-1], "-", "-"))
                     # # Loading Program Context ------------------------------------!
                         # IGNORE $zero
                     instructions.append(Instruction("load", "$zero", "$aux", "1"))
@@ -504,7 +556,7 @@ def assemblyCodeGenerate(quads: List[Quadruple]) -> List[Instruction]:
                     instructions.append(Instruction("load", "$zero", "$fp", "29"))
                     instructions.append(Instruction("load", "$zero", "$sp", "30"))
                     instructions.append(Instruction("load", "$zero", "$ra", "31"))
-                    instructions.append(Instruction("subi", registers[-1], registers[-1], "30"))
+                    instructions.append(Instruction("subi", params[-1], params[-1], "30"))
                     # # ---> Quantum Ended - So we assume PC has the value of where ended
                 elif (src.lower() == "peek"):
                     instructions.append(Instruction("peek", "-", "-", "$io"))
@@ -513,37 +565,45 @@ def assemblyCodeGenerate(quads: List[Quadruple]) -> List[Instruction]:
                 elif (src.lower() == "uart"):
                     instructions.append(Instruction("uart", "-", "-", "$io"))
                 elif (src.lower() == "output"):
-                    instructions.append(Instruction("out", registers[-1], "-", "-"))
+                    instructions.append(Instruction("out", params[-1], "-", "-"))
                 elif (src.lower() == "loadhd"):
-                    instructions.append(Instruction("loadHD", registers[-2], registers[-1], "$hd"))
+                    instructions.append(Instruction("loadHD", params[-2], params[-1], "$hd"))
                 elif (src.lower() == "storehd"):
-                    instructions.append(Instruction("add", registers[-2], registers[-1], registers[-1]))
-                    instructions.append(Instruction("storeHD", registers[-3], registers[-1], "-"))
+                    instructions.append(Instruction("add", params[-2], params[-1], params[-1]))
+                    instructions.append(Instruction("storeHD", params[-3], params[-1], "-"))
                 elif (src.lower() == "hdtoim"):
-                    instructions.append(Instruction("add", registers[-2], registers[-1], registers[-1]))
-                    instructions.append(Instruction("HDtoIM", registers[-3], registers[-1], "-"))
+                    instructions.append(Instruction("add", params[-2], params[-1], params[-1]))
+                    instructions.append(Instruction("HDtoIM", params[-3], params[-1], "-"))
                 elif (src.lower() == "lcdwrite"):
-                    instructions.append(Instruction("writeLCD", registers[-17], registers[-1], "-"))
-                    instructions.append(Instruction("writeLCD", registers[-16], registers[-1], "-"))
-                    instructions.append(Instruction("writeLCD", registers[-15], registers[-1], "-"))
-                    instructions.append(Instruction("writeLCD", registers[-14], registers[-1], "-"))
-                    instructions.append(Instruction("writeLCD", registers[-13], registers[-1], "-"))
-                    instructions.append(Instruction("writeLCD", registers[-12], registers[-1], "-"))
-                    instructions.append(Instruction("writeLCD", registers[-11], registers[-1], "-"))
-                    instructions.append(Instruction("writeLCD", registers[-10], registers[-1], "-"))
-                    instructions.append(Instruction("writeLCD", registers[-9], registers[-1], "-"))
-                    instructions.append(Instruction("writeLCD", registers[-8], registers[-1], "-"))
-                    instructions.append(Instruction("writeLCD", registers[-7], registers[-1], "-"))
-                    instructions.append(Instruction("writeLCD", registers[-6], registers[-1], "-"))
-                    instructions.append(Instruction("writeLCD", registers[-5], registers[-1], "-"))
-                    instructions.append(Instruction("writeLCD", registers[-4], registers[-1], "-"))
-                    instructions.append(Instruction("writeLCD", registers[-3], registers[-1], "-"))
-                    instructions.append(Instruction("writeLCD", registers[-2], registers[-1], "-"))
+                    instructions.append(Instruction("writeLCD", params[-17], params[-1], "-"))
+                    instructions.append(Instruction("writeLCD", params[-16], params[-1], "-"))
+                    instructions.append(Instruction("writeLCD", params[-15], params[-1], "-"))
+                    instructions.append(Instruction("writeLCD", params[-14], params[-1], "-"))
+                    instructions.append(Instruction("writeLCD", params[-13], params[-1], "-"))
+                    instructions.append(Instruction("writeLCD", params[-12], params[-1], "-"))
+                    instructions.append(Instruction("writeLCD", params[-11], params[-1], "-"))
+                    instructions.append(Instruction("writeLCD", params[-10], params[-1], "-"))
+                    instructions.append(Instruction("writeLCD", params[-9], params[-1], "-"))
+                    instructions.append(Instruction("writeLCD", params[-8], params[-1], "-"))
+                    instructions.append(Instruction("writeLCD", params[-7], params[-1], "-"))
+                    instructions.append(Instruction("writeLCD", params[-6], params[-1], "-"))
+                    instructions.append(Instruction("writeLCD", params[-5], params[-1], "-"))
+                    instructions.append(Instruction("writeLCD", params[-4], params[-1], "-"))
+                    instructions.append(Instruction("writeLCD", params[-3], params[-1], "-"))
+                    instructions.append(Instruction("writeLCD", params[-2], params[-1], "-"))
+                elif (dst == "tail"):
+                    # Tail call: the arguments overwrite the caller's own, $ra and $sp go back to what its caller
+                    # left them at, and the callee returns straight there
+                    for index, reg in enumerate(params):
+                        instructions.append(Instruction("store", "$fp", reg, str(2+index)))
+                    instructions.append(Instruction("load", "$fp", "$ra", "1"))
+                    instructions.append(Instruction("addi", "$fp", "$sp", "1"))
+                    instructions.append(Instruction("j", src, "-", "-"))
                 else:
                     instructions.append(Instruction("store", "$sp", "$fp", "0"))
                     instructions.append(Instruction("addi", "$sp", "$fp", "0"))
                     instructions.append(Instruction("addi", "$sp", "$sp", "1"))
-                    for index, reg in enumerate(registers):
+                    for index, reg in enumerate(params):
                         instructions.append(Instruction("store", "$fp", reg, str(2+index)))
                     instructions.append(Instruction("jal", src, "-", "-"))
                     instructions.append(Instruction("addi", "$fp", "$sp", "0"))
@@ -551,7 +611,7 @@ def assemblyCodeGenerate(quads: List[Quadruple]) -> List[Instruction]:
 
             case "MOVE" | "RETURN":
                 if (operator == "MOVE"):
-                    if (src.isdigit()):
+                    if (srcConst):
                         instructions.append(Instruction("movei", src, "-", tgt))
                     else:
                         instructions.append(Instruction("move", src, "-", tgt))
@@ -561,10 +621,8 @@ def assemblyCodeGenerate(quads: List[Quadruple]) -> List[Instruction]:
                 instructions.append(Instruction("addi", "$sp", "$sp", "1"))
 
             case "POP":
-                registers.pop()
-
-                if (dst != "1"):
-                    instructions.append(Instruction("subi", "$sp", "$sp", "1"))
+                instructions.append(Instruction("subi", "$sp", "$sp", "1"))
+                instructions.append(Instruction("load", "$sp", src, "0"))
 
             case "HALT":
                 instructions.append(Instruction("halt", "-", "-", "-"))
@@ -575,62 +633,272 @@ def assemblyCodeGenerate(quads: List[Quadruple]) -> List[Instruction]:
             case _:
                 instructions.append(Instruction("UNKNOWN", "-", "-", "-"))
 
+    if (not mainFirst):
+        prelude.append(Instruction("j", "main", "-", "-"))
+    instructions = prelude + instructions
+
     for instr in instructions:
-        if (isinstance(instr, Instruction)):
-            if instr.addr_src in labels:
-                instr.addr_src = str(labels[instr.addr_src])
-            if instr.addr_tgt in labels:
-                instr.addr_tgt = str(labels[instr.addr_tgt])
-            if instr.addr_dst in labels:
-                instr.addr_dst = str(labels[instr.addr_dst])
-
-            if (instr.addr_src == "r2"):
-                instr.addr_src = "$rf"
-            if (instr.addr_tgt == "r2"):
-                instr.addr_tgt = "$rf"
-            if (instr.addr_dst == "r2"):
-                instr.addr_dst = "$rf"
-
-            if (instr.addr_src == "r3"):
-                instr.addr_src = "$io"
-            if (instr.addr_tgt == "r3"):
-                instr.addr_tgt = "$io"
-            if (instr.addr_dst == "r3"):
-                instr.addr_dst = "$io"
-
-            if (instr.addr_src == "r4"):
-                instr.addr_src = "$hd"
-            if (instr.addr_tgt == "r4"):
-                instr.addr_tgt = "$hd"
-            if (instr.addr_dst == "r4"):
-                instr.addr_dst = "$hd"
-                
-            if (instr.addr_src == "r26"):
-                instr.addr_src = "$pc"
-            if (instr.addr_tgt == "r26"):
-                instr.addr_tgt = "$pc"
-            if (instr.addr_dst == "r26"):
-                instr.addr_dst = "$pc"
+        instr.addr_src = registerAliases.get(instr.addr_src, instr.addr_src)
+        instr.addr_tgt = registerAliases.get(instr.addr_tgt, instr.addr_tgt)
+        instr.addr_dst = registerAliases.get(instr.addr_dst, instr.addr_dst)
+
+    instructions = peepholeOptimize(instructions)
+    instructions = assemble(instructions, functions)
+    functionAddresses = {name: labelAddresses[name] for name in functions}
 
     traceAssembler(instructions)
     return instructions
 
+# Peephole patterns over a window of consecutive instructions: each rewrite returns the instructions replacing the window,
+# or None when it does not apply. Labels are never matched as anything but a label, so no window spans a jump target
+@dataclass
+class PeepholeRule:
+    name: str
+    size: int
+    rewrite: Callable
+
+IMM_MAX = 32767
+
+def isImmediate(value: str) -> bool:
+    return value.lstrip("-").isdigit()
+
+def storeLoad(a: Instruction, b: Instruction):
+    # store B R K; load B R K → the register already holds the value
+    if (a.instr == "store" and b.instr == "load" and a.addr_src == b.addr_src and a.addr_dst == b.addr_dst
+            and a.addr_tgt == b.addr_tgt and b.addr_tgt != b.addr_src):
+        return [a]
+    return None
+
+def storeLoadMove(a: Instruction, b: Instruction):
+    # store B R K; load B S K → S gets R with a move instead of a memory access
+    if (a.instr == "store" and b.instr == "load" and a.addr_src == b.addr_src and a.addr_dst == b.addr_dst
+            and a.addr_tgt != b.addr_tgt and b.addr_tgt != b.addr_src):
+        return [a, Instruction("move", a.addr_tgt, "-", b.addr_tgt)]
+    return None
+
+def loadLoad(a: Instruction, b: Instruction):
+    # load B R K; load B R K → the second reads what the first did
+    if (a.instr == "load" and b.instr == "load" and a.addr_src == b.addr_src and a.addr_dst == b.addr_dst
+            and a.addr_tgt == b.addr_tgt and a.addr_tgt != a.addr_src):
+        return [a]
+    return None
+
+def loadStore(a: Instruction, b: Instruction):
+    # load B R K; store B R K → memory already holds the value
+    if (a.instr == "load" and b.instr == "store" and a.addr_src == b.addr_src and a.addr_dst == b.addr_dst
+            and a.addr_tgt == b.addr_tgt and a.addr_tgt != a.addr_src):
+        return [a]
+    return None
+
+def moveSelf(a: Instruction):
+    # move R - R
+    if (a.instr == "move" and a.addr_src == a.addr_dst):
+        return []
+    return None
+
+def moveBack(a: Instruction, b: Instruction):
+    # move R - S; move S - R → R still holds S
+    if (a.instr == "move" and b.instr == "move" and a.addr_src == b.addr_dst and a.addr_dst == b.addr_src):
+        return [a]
+    return None
+
+def storeZero(a: Instruction, b: Instruction):
+    # movei 0 - $aux; store B $aux K → store B $zero K ($aux is only a scratch for constants)
+    if (a.instr == "movei" and a.addr_src == "0" and a.addr_dst == "$aux" and b.instr == "store"
+            and b.addr_tgt == "$aux" and b.addr_src != "$aux"):
+        return [Instruction("store", b.addr_src, "$zero", b.addr_dst)]
+    return None
+
+def constantReload(a: Instruction, b: Instruction, c: Instruction):
+    # movei C - R; store B R K; movei C - R → R still holds C
+    if (a.instr == "movei" and c.instr == "movei" and a.addr_src == c.addr_src and a.addr_dst == c.addr_dst
+            and b.instr == "store" and b.addr_src != a.addr_dst):
+        return [a, b]
+    return None
+
+def addiMerge(a: Instruction, b: Instruction):
+    # addi R R x; addi R R y → addi R R x+y (back to back ALLOCVARs)
+    if (a.instr == "addi" and b.instr == "addi" and a.addr_src == a.addr_tgt == b.addr_src == b.addr_tgt
+            and isImmediate(a.addr_dst) and isImmediate(b.addr_dst)):
+        value = int(a.addr_dst) + int(b.addr_dst)
+        if (abs(value) <= IMM_MAX):
+            return [Instruction("addi", a.addr_src, a.addr_tgt, str(value))]
+    return None
+
+def addiZero(a: Instruction):
+    # addi R R 0 (or subi)
+    if (a.instr in ("addi", "subi") and a.addr_src == a.addr_tgt and a.addr_dst == "0"):
+        return []
+    return None
+
+def jumpNext(a: Instruction, b: Instruction):
+    # j L; L: (or beq to L) → execution gets there anyway
+    if (b.instr == "label" and ((a.instr == "j" and a.addr_src == b.addr_src) or (a.instr == "beq" and a.addr_dst == b.addr_src))):
+        return [b]
+    return None
+
+def unreachable(a: Instruction, b: Instruction):
+    # j/jr; anything but a label → never executed
+    if (a.instr in ("j", "jr") and b.instr != "label"):
+        return [a]
+    return None
+
+peepholeRules = [
+    PeepholeRule("store-load", 2, storeLoad),
+    PeepholeRule("store-load-move", 2, storeLoadMove),
+    PeepholeRule("load-load", 2, loadLoad),
+    PeepholeRule("load-store", 2, loadStore),
+    PeepholeRule("move-self", 1, moveSelf),
+    PeepholeRule("move-back", 2, moveBack),
+    PeepholeRule("store-zero", 2, storeZero),
+    PeepholeRule("constant-reload", 3, constantReload),
+    PeepholeRule("addi-merge", 2, addiMerge),
+    PeepholeRule("addi-zero", 1, addiZero),
+    PeepholeRule("jump-next", 2, jumpNext),
+    PeepholeRule("unreachable", 2, unreachable),
+]
+
+# Hits of each pattern over the run, the passes it took to reach the fixpoint and the instructions it started from
+peepholeHits = {rule.name: 0 for rule in peepholeRules}
+peepholePasses = 0
+peepholeBefore = 0
+
+# Runs the patterns until a pass rewrites nothing. A pass streams the instructions into a new list and tries the patterns
+# on its tail after each one: a rewrite only changes the tail, so only the windows ending there can match anew
+def peepholeOptimize(instructions: List[Instruction]) -> List[Instruction]:
+    global peepholePasses, peepholeBefore
+
+    peepholeBefore += sum(1 for instr in instructions if instr.instr != "label")
+
+    changed = True
+    while (changed):
+        changed = False
+        peepholePasses += 1
+        output = []
+
+        for instr in instructions:
+            output.append(instr)
+
+            matched = True
+            while (matched):
+                matched = False
+                for rule in peepholeRules:
+                    if (len(output) < rule.size):
+                        continue
+
+                    replacement = rule.rewrite(*output[len(output)-rule.size:])
+                    if (replacement is not None):
+                        del output[len(output)-rule.size:]
+                        output.extend(replacement)
+                        peepholeHits[rule.name] += 1
+                        changed = matched = True
+                        break
+
+        instructions = output
+
+    return instructions
+
+def peepholeReport(after: int):
+    hits = ", ".join(f"{name}: {count}" for name, count in peepholeHits.items() if count > 0)
+    print(f"\n> Peephole: {peepholeBefore - after} of {peepholeBefore} instruction(s) removed in {peepholePasses} pass(es) [{hits}]")
+
+@dataclass
+class Section:
+    name: str
+    start: int
+    size: int
+
+@dataclass
+class Relocation:
+    index: int
+    operand: str
+    symbol: str
+
+# Operand of each instruction that names a symbol (a label or a function) rather than a register or a constant
+symbolOperands = {"j": "addr_src", "jal": "addr_src", "beq": "addr_dst"}
+
+# Labels are kept as "label" pseudo instructions until the peephole stage is done, then assembled in two passes: the
+# first gives every symbol its address and every section its size, the second writes the addresses into the symbol
+# operands. A symbol defined nowhere is kept as it is, with a relocation entry to be fixed once it is known
+def assemble(instructions: List[Instruction], functions: List[str]) -> List[Instruction]:
+    global labelAddresses, sections, relocations
+
+    symbols = {}
+    sections = [Section("global", 0, 0)]
+    address = 0
+
+    for instr in instructions:
+        if (instr.instr != "label"):
+            address += 1
+            continue
+        if (instr.addr_src in symbols):
+            print(f"> Misc Error\n     Symbol \"{instr.addr_src}\" defined twice in [{source}].")
+            sys.exit(1)
+
+        symbols[instr.addr_src] = address
+        if (instr.addr_src in functions):
+            sections.append(Section(instr.addr_src, address, 0))
+
+    for section, following in zip(sections, sections[1:] + [Section("", address, 0)]):
+        section.size = following.start - section.start
+
+    code = []
+    relocations = []
+
+    for instr in instructions:
+        if (instr.instr == "label"):
+            continue
+
+        operand = symbolOperands.get(instr.instr)
+        if (operand is not None):
+            symbol = getattr(instr, operand)
+
+            if (symbol in symbols):
+                setattr(instr, operand, str(symbols[symbol]))
+            elif (not isImmediate(symbol)):
+                relocations.append(Relocation(len(code), operand, symbol))
+        code.append(instr)
+
+    labelAddresses = symbols
+    return code
+
+# assemblySave() → "[index] instr src tgt dst" lines after the source, then a "reloc index operand symbol" line per
+# relocation entry
 def assemblySave(path: str, instructions: List[Instruction]):
     with open(path, 'w') as output:
         output.write(source+"\n")
         for index, instr in enumerate(instructions):
             line = f"[{index}] {instr.instr} {instr.addr_src} {instr.addr_tgt} {instr.addr_dst}\n"
             output.write(line)
+        for reloc in relocations:
+            output.write(f"reloc {reloc.index} {reloc.operand} {reloc.symbol}\n")
 
-def main():
-    path_midcode = "outputs/midcode.txt"
-    path_assembly = "outputs/assembly.txt"
+def main(argv: List[str]):
+    global traceFile
+
+    # Usage: assembly_codegen.py [midcode] [assembly] [--report file] [--trace file]
+    traceFile = tracelog.traceOption(argv)
+    report = metrics.reportOption(argv)
+    paths = [arg for arg in argv if not arg.startswith("-")]
+
+    path_midcode = paths[0] if len(paths) > 0 else "outputs/midcode.ir"
+    path_assembly = paths[1] if len(paths) > 1 else "outputs/assembly.txt"
 
     quadruples = midcodeTranslate(path_midcode)
     instructions = assemblyCodeGenerate(quadruples)
     assemblySave(path_assembly, instructions)
 
+    peepholeReport(len(instructions))
+    metrics.recordPhase(report, "assemblyCodeGenerate", {
+        "instructions": len(instructions),
+        "peepholeRemoved": peepholeBefore - len(instructions),
+        "sections": len(sections),
+        "relocations": len(relocations),
+    })
+    if (traceFile is not None):
+        traceFile.close()
+
     print(f"\n> Assembly code generated... → [{source}]\n")
 
 if __name__ == "__main__":
-    main()
\ No newline at end of file
+    main(sys.argv[1:])
\ No newline at end of file
@@ -0,0 +1,336 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Batch Driver for a C- Compiler
+ *  File: batch.c
+ *---------------------------------*/
+
+#define _DEFAULT_SOURCE
+
+#include "batch.h"
+#include "context.h"
+#include "utils.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <spawn.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+extern char **environ;
+
+#define MAX_UNITS 1024
+
+/*  units[] → Every source scheduled in the current batch  */
+static BatchUnit units[MAX_UNITS];
+static int unitsCount = 0;
+
+/*  binaryExtension → Extension of the binary image, which picks its format in binary_codegen.py (batch flag -f)  */
+static const char *binaryExtension = "bin";
+
+/*  binaryFormats[] → Binary image formats and the extension each one is written with  */
+static const char *binaryFormats[][2] = { { "raw", "bin" }, { "hex", "hex" }, { "mif", "mif" }, { "listing", "txt" } };
+
+/*  backendPath → Folder the Python back end stages are run from (see findBackend())  */
+static char backendPath[1024];
+
+/*  nextUnit → Index of the next unit to be taken by a worker thread  */
+static int nextUnit = 0;
+static pthread_mutex_t unitsLock = PTHREAD_MUTEX_INITIALIZER;
+
+/*  makeDir() → Creates a folder if it does not exist yet  */
+static void makeDir(const char *path) {
+    if (mkdir(path, 0755) != 0 && errno != EEXIST) {
+        printf("> Misc Error\n     Could not create the folder \"%s\".\n", path);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/*  addUnit() → Schedules a source file; its output folder (OUTPUT_DIR/<name>) is set by setFolders() once every option is read  */
+static void addUnit(const char *path) {
+    if (unitsCount == MAX_UNITS) {
+        printf("> Misc Error\n     Too many sources (max. %d).\n", MAX_UNITS);
+        exit(EXIT_FAILURE);
+    }
+
+    BatchUnit *unit = &units[unitsCount++];
+    const char *name = strrchr(path, '/');
+    name = (name == NULL) ? path : name + 1;
+
+    int stem = strlen(name);
+    const char *dot = strrchr(name, '.');
+    if (dot != NULL && dot != name) stem = dot - name;
+
+    snprintf(unit->source, sizeof(unit->source), "%s", path);
+    snprintf(unit->name, sizeof(unit->name), "%.*s", stem, name);
+    unit->lines = countLines(path);
+    unit->status = -1;
+}
+
+/*  setFolders() → Gives every unit its output folder under OUTPUT_DIR; two sources with the same name would write (at
+ *  the same time) into the same folder, so they are rejected  */
+static void setFolders(void) {
+    for (int i = 0; i < unitsCount; i++) {
+        for (int j = 0; j < i; j++) {
+            if (strcmp(units[i].name, units[j].name) == 0) {
+                printf("> Misc Error\n     \"%s\" and \"%s\" would share the output folder \"%s/%s\".\n", units[j].source, units[i].source, OUTPUT_DIR, units[i].name);
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        /* Built apart and copied whole: OUTPUT_DIR may be as long as the command line allows   */
+        char path[sizeof(units[i].outdir)];
+        int length = snprintf(path, sizeof(path), "%s/%s", OUTPUT_DIR, units[i].name);
+
+        if (length < 0 || length >= (int)sizeof(path)) {
+            printf("> Misc Error\n     The output folder \"%s/%s\" is too long (max. %zu characters).\n", OUTPUT_DIR, units[i].name, sizeof(path) - 1);
+            exit(EXIT_FAILURE);
+        }
+        memcpy(units[i].outdir, path, length + 1);
+    }
+}
+
+static int compareNames(const void *a, const void *b) {
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/*  addFolder() → Schedules every ".cm" file of a folder, in name order  */
+static void addFolder(const char *folder) {
+    DIR *dir = opendir(folder);
+    char *names[MAX_UNITS];
+    int count = 0;
+
+    if (!dir) {
+        perror("> Misc Error\n     Could not find the desired folder.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL && count < MAX_UNITS) {
+        const char *ext = strrchr(entry->d_name, '.');
+
+        if (entry->d_type == DT_REG && ext != NULL && strcmp(ext, ".cm") == 0) {
+            names[count++] = strdup(entry->d_name);
+        }
+    }
+    closedir(dir);
+
+    qsort(names, count, sizeof(char *), compareNames);
+
+    for (int i = 0; i < count; i++) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", folder, names[i]);
+        addUnit(path);
+        free(names[i]);
+    }
+}
+
+/*  findBackend() → Where the Python stages are: CMINUS_BACKEND when set, else BACKEND_DIR taken from the folder above the
+ *  executable (build/compiler → src), so the compiler runs from any folder; BACKEND_DIR as given if neither exists  */
+static void findBackend(void) {
+    const char *folder = getenv("CMINUS_BACKEND");
+    char exe[512], probe[1100];
+
+    if (folder != NULL && *folder != '\0') {
+        snprintf(backendPath, sizeof(backendPath), "%s", folder);
+        return;
+    }
+
+    ssize_t size = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+    if (size > 0 && BACKEND_DIR[0] != '/') {
+        exe[size] = '\0';
+        *strrchr(exe, '/') = '\0';
+
+        snprintf(backendPath, sizeof(backendPath), "%s/../%s", exe, BACKEND_DIR);
+        snprintf(probe, sizeof(probe), "%s/assembly_codegen.py", backendPath);
+        if (access(probe, R_OK) == 0) return;
+    }
+
+    snprintf(backendPath, sizeof(backendPath), "%s", BACKEND_DIR);
+}
+
+/*  runStage() → Runs one of the Python back end stages (its output appended to the unit's report.log, its phase to the
+ *  unit's report.json and, when "trace" is not NULL, its trace to that log) and waits for it  */
+static int runStage(const char *script, const char *input, const char *output, const char *log, const char *metrics, const char *trace) {
+    char path[1100];
+    snprintf(path, sizeof(path), "%s/%s", backendPath, script);
+
+    char *args[] = { PYTHON, path, (char *)input, (char *)output, "--report", (char *)metrics, "--trace", (char *)trace, NULL };
+    if (trace == NULL) args[6] = NULL;
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, log, O_WRONLY | O_CREAT | O_APPEND, 0644);
+
+    pid_t pid;
+    int status = posix_spawnp(&pid, PYTHON, &actions, NULL, args, environ);
+    posix_spawn_file_actions_destroy(&actions);
+
+    if (status != 0 || waitpid(pid, &status, 0) < 0) return -1;
+
+    return (WIFEXITED(status)) ? WEXITSTATUS(status) : -1;
+}
+
+/*  compileUnit() → Runs the whole pipeline over one source, with its own compiler context  */
+static int compileUnit(BatchUnit *unit) {
+    char log[600], metrics[600], trace[600], midcode[600], assembly[600], binary[600];
+
+    snprintf(log, sizeof(log), "%s/report.log", unit->outdir);
+    snprintf(metrics, sizeof(metrics), "%s/report.json", unit->outdir);
+    snprintf(trace, sizeof(trace), "%s/trace.log", unit->outdir);
+    snprintf(midcode, sizeof(midcode), "%s/midcode.ir", unit->outdir);
+    snprintf(assembly, sizeof(assembly), "%s/assembly.txt", unit->outdir);
+    snprintf(binary, sizeof(binary), "%s/binary.%s", unit->outdir, binaryExtension);
+
+    CompilerContext *ctx = newContext();
+
+    ctx->listing = fopen(log, "w");
+    if (ctx->listing == NULL) {
+        freeContext(ctx);
+        return 1;
+    }
+
+    if (!openSource(ctx, unit->source, midcode)) {
+        fprintf(ctx->listing, "> Misc Error\n     Invalid file.\n");
+        freeContext(ctx);
+        return 1;
+    }
+
+    traceOpen(ctx, trace);
+
+    phaseBegin(ctx, "syntaxAnalysis");
+    syntaxAnalysis(ctx);
+    phaseEnd(ctx);
+    phaseBegin(ctx, "semanticAnalysis");
+    semanticAnalysis(ctx);
+    phaseEnd(ctx);
+    fprintf(ctx->listing, "\n> End of analysis... → [%s]\n", ctx->source);
+
+    /* A source with errors gets no code: its unit fails right after the analysis   */
+    if (!ctx->failed) {
+        phaseBegin(ctx, "midCodeGenerate");
+        midCodeGenerate(ctx);
+        phaseEnd(ctx);
+    }
+    printMemoryReport(ctx);
+    writeMetrics(ctx, metrics);
+
+    unit->memory = contextMemory(ctx);
+    bool failed = ctx->failed;
+    freeContext(ctx);
+
+    if (failed) return 1;
+
+    if (runStage("assembly_codegen.py", midcode, assembly, log, metrics, tracing(TraceAssembly) ? trace : NULL) != 0) return 2;
+    if (runStage("binary_codegen.py", assembly, binary, log, metrics, tracing(TraceBinary) ? trace : NULL) != 0) return 3;
+
+    return 0;
+}
+
+/*  worker() → Worker thread: takes the next pending unit until there are none left  */
+static void *worker(void *arg) {
+    (void)arg;
+
+    while (true) {
+        pthread_mutex_lock(&unitsLock);
+        int i = (nextUnit < unitsCount) ? nextUnit++ : -1;
+        pthread_mutex_unlock(&unitsLock);
+
+        if (i < 0) return NULL;
+
+        units[i].status = compileUnit(&units[i]);
+    }
+}
+
+/*  batchCompile() → Parses the command line, compiles every source (or the whole INPUT_DIR) in parallel and reports the throughput  */
+int batchCompile(int argc, char *argv[]) {
+    long jobs = sysconf(_SC_NPROCESSORS_ONLN);
+
+    /* Usage: compiler [-j jobs] [-o folder] [-O0 | -O1] [-m] [-f raw|hex|mif|listing] [-t | -T scan,parse,semantic,midcode,assembly,binary] [source | folder ...]  */
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            jobs = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            OUTPUT_DIR = argv[++i];
+        } else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            const char *format = argv[++i];
+
+            binaryExtension = NULL;
+            for (int f = 0; f < 4; f++) {
+                if (strcmp(format, binaryFormats[f][0]) == 0) binaryExtension = binaryFormats[f][1];
+            }
+            if (binaryExtension == NULL) {
+                printf("> Misc Error\n     Unknown binary format \"%s\" (raw, hex, mif or listing).\n", format);
+                exit(EXIT_FAILURE);
+            }
+        } else if (strcmp(argv[i], "-O0") == 0 || strcmp(argv[i], "-O1") == 0) {
+            OPT_LEVEL = argv[i][2] - '0';
+        } else if (strcmp(argv[i], "-m") == 0) {
+            MIDCODE_TEXT = true;
+        } else if (strcmp(argv[i], "-t") == 0) {
+            traceCategories = TraceAll;
+        } else if (strcmp(argv[i], "-T") == 0 && i + 1 < argc) {
+            if (!parseTraceCategories(argv[++i], &traceCategories)) {
+                printf("> Misc Error\n     Unknown trace category in \"%s\".\n", argv[i]);
+                exit(EXIT_FAILURE);
+            }
+        } else if (argv[i][0] == '-') {
+            printf("> Misc Error\n     Unknown option \"%s\".\n", argv[i]);
+            exit(EXIT_FAILURE);
+        } else {
+            struct stat st;
+
+            if (stat(argv[i], &st) == 0 && S_ISDIR(st.st_mode)) addFolder(argv[i]);
+            else addUnit(argv[i]);
+        }
+    }
+
+    if (unitsCount == 0) addFolder(INPUT_DIR);
+    setFolders();
+    findBackend();
+    if (jobs > unitsCount) jobs = unitsCount;
+    if (jobs < 1) jobs = 1;
+
+    makeDir(OUTPUT_DIR);
+    for (int i = 0; i < unitsCount; i++) makeDir(units[i].outdir);
+
+    printf("\n> Batch compilation of %d file(s) with %ld worker(s)...\n", unitsCount, jobs);
+    fflush(stdout);
+
+    double start = now();
+    pthread_t threads[jobs];
+    int failed = 0;
+
+    for (long i = 0; i < jobs; i++) {
+        if (pthread_create(&threads[i], NULL, worker, NULL) != 0) {
+            perror("> Misc Error\n     Could not start a worker.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (long i = 0; i < jobs; i++) pthread_join(threads[i], NULL);
+
+    double elapsed = now() - start;
+    long lines = 0;
+    size_t memory = 0, largest = 0;
+
+    for (int i = 0; i < unitsCount; i++) {
+        lines += units[i].lines;
+        memory += units[i].memory;
+        if (units[i].memory > largest) largest = units[i].memory;
+
+        if (units[i].status == 0) {
+            printf("  [ok]     %-28s → %s\n", units[i].source, units[i].outdir);
+        } else {
+            printf("  [failed] %-28s → %s/report.log\n", units[i].source, units[i].outdir);
+            failed++;
+        }
+    }
+
+    printf("\n----------------------------------------------------------------------------\n");
+    printf("> %d file(s), %ld line(s) in %.3f s → %.2f files/s, %.0f lines/s", unitsCount, lines, elapsed, unitsCount / elapsed, lines / elapsed);
+    printf("\n> Memory: %.1f KiB over all units, %.1f KiB for the largest one, peak RSS %ld KiB", memory / 1024.0, largest / 1024.0, peakRSS());
+    printf("\n----------------------------------------------------------------------------\n");
+
+    return (failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
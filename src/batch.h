@@ -0,0 +1,33 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Batch Driver interface for a C- Compiler
+ *  File: batch.h
+ *---------------------------------*/
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "globals.h"
+
+/*--------------------------------------------/
+ *  Batch Driver structure
+ *---------------------------------*/
+
+/*  BatchUnit → One source scheduled by the batch driver, its name (file name without extension), output folder and result  */
+typedef struct {
+    char source[512];
+    char name[256];
+    char outdir[512];
+    long lines;
+    size_t memory;
+    int status;
+} BatchUnit;
+
+/*--------------------------------------------/
+ *  Batch Driver functions
+ *---------------------------------*/
+
+/*  batchCompile() → Parses the command line, compiles every source (or the whole INPUT_DIR) in parallel and reports the
+ *  throughput; the Python stages are found next to the executable (or in CMINUS_BACKEND), whatever the current folder  */
+int batchCompile(int argc, char *argv[]);
+
+#endif
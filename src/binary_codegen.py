@@ -1,11 +1,20 @@
+import sys
 from dataclasses import dataclass
 from pathlib import Path
-from typing import List
+from typing import List, Optional, Tuple
 
-traceBinary = True
+import metrics
+import tracelog
+
+# Trace log the encoded instructions are appended to (None → not traced)
+traceFile = None
 systemRange = 3066
 programRange = 1024
 
+# The system is laid out as such when its source is named systemName (whatever folder it is in) or "--system" is given
+systemName = "SO"
+system = False
+
 registers = {
     # Special Purpose Registers
     "$zero": "00000",
@@ -44,6 +53,81 @@ registers = {
     "$ra":   "11111",
 }
 
+# Where each operand ("instr src tgt dst") sits in a 32-bit word: rs, rt, rd and shamt are 5 bit fields, imm the signed
+# low 16 bits and addr the low 26 bits; "-" marks an operand the instruction does not have
+fields = {
+    "rs":    (6, 11),
+    "rt":    (11, 16),
+    "rd":    (16, 21),
+    "shamt": (21, 26),
+    "imm":   (16, 32),
+    "addr":  (6, 32),
+}
+
+@dataclass
+class Format:
+    opcode: str
+    funct: Optional[str]
+    operands: Tuple[str, str, str]
+
+# The instruction set: opcode, funct and where each operand goes, driving both encodeWord() and the decoder of
+# simulator.py. R and IO-type words share opcode 000000 and are told apart by funct; nop is the all-zero word (a peek
+# into $zero), which decoders check before anything else
+formats = {
+    "nop":      Format("000000", "000000", ("-", "-", "-")),
+    # IO-Type
+    "peek":     Format("000000", "000000", ("-", "-", "rd")),
+    "in":       Format("000000", "000001", ("-", "-", "rd")),
+    "out":      Format("000000", "000010", ("rs", "-", "-")),
+    # R-Type
+    "move":     Format("000000", "000011", ("rs", "-", "rd")),
+    "add":      Format("000000", "000100", ("rs", "rt", "rd")),
+    "sub":      Format("000000", "000101", ("rs", "rt", "rd")),
+    "mul":      Format("000000", "000110", ("rs", "rt", "rd")),
+    "div":      Format("000000", "000111", ("rs", "rt", "rd")),
+    "and":      Format("000000", "001000", ("rs", "rt", "rd")),
+    "or":       Format("000000", "001001", ("rs", "rt", "rd")),
+    "sll":      Format("000000", "001100", ("rs", "shamt", "rd")),
+    "srl":      Format("000000", "001101", ("rs", "shamt", "rd")),
+    "set":      Format("000000", "010000", ("rs", "rt", "rd")),
+    "sdt":      Format("000000", "010001", ("rs", "rt", "rd")),
+    "sgt":      Format("000000", "010010", ("rs", "rt", "rd")),
+    "slt":      Format("000000", "010011", ("rs", "rt", "rd")),
+    "segt":     Format("000000", "010100", ("rs", "rt", "rd")),
+    "selt":     Format("000000", "010101", ("rs", "rt", "rd")),
+    "loadHD":   Format("000000", "010110", ("rs", "rt", "rd")),
+    "storeHD":  Format("000000", "010111", ("rs", "rt", "-")),
+    "HDtoIM":   Format("000000", "011000", ("rs", "rt", "-")),
+    "setTimer": Format("000000", "011001", ("rs", "-", "-")),
+    "uart":     Format("000000", "011111", ("-", "-", "rd")),
+    "jr":       Format("000000", "100000", ("rs", "-", "-")),
+    "jimset":   Format("000000", "100001", ("rs", "rt", "-")),
+    "dmset":    Format("000000", "100010", ("rs", "-", "-")),
+    "writeLCD": Format("000000", "111111", ("rs", "rt", "-")),
+    # I-Type
+    "load":     Format("000001", None, ("rs", "rt", "imm")),
+    "store":    Format("000010", None, ("rs", "rt", "imm")),
+    "movei":    Format("000011", None, ("imm", "-", "rt")),
+    "addi":     Format("000100", None, ("rs", "rt", "imm")),
+    "subi":     Format("000101", None, ("rs", "rt", "imm")),
+    "muli":     Format("000110", None, ("rs", "rt", "imm")),
+    "divi":     Format("000111", None, ("rs", "rt", "imm")),
+    "andi":     Format("001000", None, ("rs", "rt", "imm")),
+    "ori":      Format("001001", None, ("rs", "rt", "imm")),
+    "beq":      Format("001100", None, ("rs", "rt", "imm")),
+    "seti":     Format("010000", None, ("rs", "rt", "imm")),
+    "sdti":     Format("010001", None, ("rs", "rt", "imm")),
+    "sgti":     Format("010010", None, ("rs", "rt", "imm")),
+    "slti":     Format("010011", None, ("rs", "rt", "imm")),
+    "segti":    Format("010100", None, ("rs", "rt", "imm")),
+    "selti":    Format("010101", None, ("rs", "rt", "imm")),
+    "pcbkp":    Format("011111", None, ("-", "rt", "-")),
+    # J-Type
+    "j":        Format("100000", None, ("addr", "-", "-")),
+    "jal":      Format("100001", None, ("addr", "-", "-")),
+    "halt":     Format("111111", None, ("-", "-", "-")),
+}
+
 @dataclass
 class Instruction:
     instr: str
@@ -52,6 +136,10 @@ class Instruction:
     addr_dst: str
 
 instructions = []
+source = ""
+
+# Symbols assembly_codegen.py left to relocation entries (nothing links them yet)
+unresolved = set()
 
 def assemblyTranslate(path: str) -> List[Instruction]:
    global source
@@ -60,347 +148,263 @@ def assemblyTranslate(path: str) -> List[Instruction]:
         source = next(assembly).strip()
         
         for line in assembly:
+            if (line.startswith("reloc ")):
+                unresolved.add(line.split()[-1])
+                continue
             parts = line.strip().split(' ')[1:]
             if len(parts) == 4:
                 inst = Instruction(*[p.strip() for p in parts])
                 instructions.append(inst)
         return instructions
 
-def valueToBinary(value: str, form: int) -> str:
-    num = int(value)
-    
-    if num < 0:
-        num = (1 << 16) + num
-    
-    if (form == 2):
-        return format(num & 0x1F, '05b')
-    elif (form == 1):
-        return format(num & 0x3FFFFFF, '026b')
-    else:
-        return format(num & 0xFFFF, '016b')
-   
-def binaryCodeGenerate(instructions: List[Instruction]) -> List[str]:
+# Range an operand placed in a field may take: registers are looked up by name, immediates are signed 16 bit values
+# (the machine sign-extends every one of them, andi/ori included; see IMM_MAX), jump targets unsigned 26 bit addresses
+ranges = {
+    "shamt": (0, (1 << 5) - 1),
+    "imm":   (-(1 << 15), (1 << 15) - 1),
+    "addr":  (0, (1 << 26) - 1),
+}
+
+registerNumbers = {name: int(code, 2) for name, code in registers.items()}
+
+# Field of every operand of every instruction, as (operand, shift, mask, kind) with the operand being 0 (src), 1 (tgt)
+# or 2 (dst), and the fixed opcode/funct bits of its word
+encodings = {
+    name: ((int(f.opcode, 2) << 26) | (int(f.funct, 2) if f.funct is not None else 0),
+           [(operand, 32 - fields[place][1], (1 << (fields[place][1] - fields[place][0])) - 1, place)
+            for operand, place in enumerate(f.operands) if place != "-"])
+    for name, f in formats.items()
+}
+
+# encodeWord() → Packs one instruction into its 32 bit word; the error message instead when an operand is unknown or
+# does not fit its field
+def encodeWord(inst: Instruction):
+    encoding = encodings.get(inst.instr)
+    if (encoding is None):
+        return f"unknown instruction \"{inst.instr}\""
+
+    word, places = encoding
+    operands = (inst.addr_src, inst.addr_tgt, inst.addr_dst)
+
+    for operand, shift, mask, place in places:
+        text = operands[operand]
+
+        if (place in ("rs", "rt", "rd")):
+            value = registerNumbers.get(text)
+            if (value is None):
+                return f"unknown register \"{text}\""
+        else:
+            try:
+                value = int(text)
+            except ValueError:
+                if (text in unresolved):
+                    return f"unresolved symbol \"{text}\""
+                return f"\"{text}\" is not a number"
+
+            low, high = ranges[place]
+            if (value < low or value > high):
+                what = {"shamt": "shift amount", "addr": "jump target"}.get(place, "immediate")
+                return f"{what} {value} does not fit in {mask.bit_length()} bits [{low}, {high}]"
+
+        word |= (value & mask) << shift
+    return word
+
+# binaryCodeGenerate() → Encodes every instruction as a 32 bit word, reporting every one that cannot be encoded
+def binaryCodeGenerate(instructions: List[Instruction]) -> List[int]:
     binary = []
+    errors = []
 
-    for inst in instructions:
-        instr = inst.instr
-        src = inst.addr_src
-        tgt = inst.addr_tgt
-        dst = inst.addr_dst
-        
-        match instr:
-            # IO-Type
-            case "peek":
-                opcode = "000000"
-                funct = "000000"
-                binary.append(opcode+"00000"+"00000"+registers[dst]+"00000"+funct)
-            
-            case "in":
-                opcode = "000000"
-                funct = "000001"
-                binary.append(opcode+"00000"+"00000"+registers[dst]+"00000"+funct)
-
-
-            case "out":
-                opcode = "000000"
-                funct = "000010"
-                binary.append(opcode+registers[src]+"00000"+"00000"+"00000"+funct)
-            
-            # # R-Type
-            case "move":
-                opcode = "000000"
-                funct = "000011"
-                shamt = "00000"
-                binary.append(opcode+registers[src]+"00000"+registers[dst]+shamt+funct)
-            
-            case "add":
-                opcode = "000000"
-                funct = "000100"
-                shamt = "00000"
-                binary.append(opcode+registers[src]+registers[tgt]+registers[dst]+shamt+funct)
-            
-            case "sub":
-                opcode = "000000"
-                funct = "000101"
-                shamt = "00000"
-                binary.append(opcode+registers[src]+registers[tgt]+registers[dst]+shamt+funct)
-            
-            case "mul":
-                opcode = "000000"
-                funct = "000110"
-                shamt = "00000"
-                binary.append(opcode+registers[src]+registers[tgt]+registers[dst]+shamt+funct)
-            
-            case "div":
-                opcode = "000000"
-                funct = "000111"
-                shamt = "00000"
-                binary.append(opcode+registers[src]+registers[tgt]+registers[dst]+shamt+funct)
-            
-            case "and":
-                opcode = "000000"
-                funct = "001000"
-                shamt = "00000"
-                binary.append(opcode+registers[src]+registers[tgt]+registers[dst]+shamt+funct)
-            
-            case "or":
-                opcode = "000000"
-                funct = "001001"
-                shamt = "00000"
-                binary.append(opcode+registers[src]+registers[tgt]+registers[dst]+shamt+funct)
-            
-            # case "not":
-            #     continue
-            
-            # case "xor":
-            #     continue
-            
-            case "sll":
-                opcode = "000000"
-                funct = "001100"
-                binary.append(opcode+registers[src]+"00000"+registers[dst]+valueToBinary(tgt, 2)+funct)
-            
-            case "srl":
-                opcode = "000000"
-                funct = "001101"
-                binary.append(opcode+registers[src]+"00000"+registers[dst]+valueToBinary(tgt, 2)+funct)
-            
-            case "set":
-                opcode = "000000"
-                funct = "010000"
-                shamt = "00000"
-                binary.append(opcode+registers[src]+registers[tgt]+registers[dst]+shamt+funct)
-            
-            case "sdt":
-                opcode = "000000"
-                funct = "010001"
-                shamt = "00000"
-                binary.append(opcode+registers[src]+registers[tgt]+registers[dst]+shamt+funct)
-            
-            case "sgt":
-                opcode = "000000"
-                funct = "010010"
-                shamt = "00000"
-                binary.append(opcode+registers[src]+registers[tgt]+registers[dst]+shamt+funct)
-            
-            case "slt":
-                opcode = "000000"
-                funct = "010011"
-                shamt = "00000"
-                binary.append(opcode+registers[src]+registers[tgt]+registers[dst]+shamt+funct)
-            
-            case "segt":
-                opcode = "000000"
-                funct = "010100"
-                shamt = "00000"
-                binary.append(opcode+registers[src]+registers[tgt]+registers[dst]+shamt+funct)
-            
-            case "selt":
-                opcode = "000000"
-                funct = "010101"
-                shamt = "00000"
-                binary.append(opcode+registers[src]+registers[tgt]+registers[dst]+shamt+funct)
-                
-            case "loadHD":
-                opcode = "000000"
-                funct = "010110"
-                shamt = "00000"
-                binary.append(opcode+registers[src]+registers[tgt]+registers[dst]+shamt+funct)
-                
-            case "storeHD":
-                opcode = "000000"
-                funct = "010111"
-                shamt = "00000"
-                binary.append(opcode+registers[src]+registers[tgt]+"00000"+shamt+funct)
-                
-            case "HDtoIM":
-                opcode = "000000"
-                funct = "011000"
-                shamt = "00000"
-                binary.append(opcode+registers[src]+registers[tgt]+"00000"+shamt+funct)
-            
-            case "setTimer":
-                opcode = "000000"
-                funct = "011001"
-                shamt = "00000"
-                binary.append(opcode+registers[src]+"00000"+"00000"+shamt+funct)
-                
-            case "uart":
-                opcode = "000000"
-                funct = "011111"
-                binary.append(opcode+"00000"+"00000"+registers[dst]+"00000"+funct)
-
-            case "jr":
-                opcode = "000000"
-                funct = "100000"
-                shamt = "00000"
-                binary.append(opcode+registers[src]+"00000"+"00000"+shamt+funct)
-                
-            case "jimset":
-                opcode = "000000"
-                funct = "100001"
-                shamt = "00000"
-                
-                if src == "$so":
-                    binary.append(opcode+registers[src]+registers[tgt]+"00000"+shamt+funct+" // --- END OF FILE ---")
-                else:
-                    binary.append(opcode+registers[src]+registers[tgt]+"00000"+shamt+funct)
-            
-            case "dmset":
-                opcode = "000000"
-                funct = "100010"
-                shamt = "00000"
-                binary.append(opcode+registers[src]+"00000"+"00000"+shamt+funct)
-            
-            case "writeLCD":
-                opcode = "000000"
-                funct = "111111"
-                shamt = "00000"
-                binary.append(opcode+registers[src]+registers[tgt]+"00000"+shamt+funct)
-            
-            # # I-Type
-            case "load":
-                opcode = "000001"
-                binary.append(opcode+registers[src]+registers[tgt]+valueToBinary(dst, 0))
-            
-            case "store":
-                opcode = "000010"
-                binary.append(opcode+registers[src]+registers[tgt]+valueToBinary(dst, 0))
-            
-            case "movei":
-                opcode = "000011"
-                binary.append(opcode+"00000"+registers[dst]+valueToBinary(src, 0))
-            
-            case "addi":
-                opcode = "000100"
-                binary.append(opcode+registers[src]+registers[tgt]+valueToBinary(dst, 0))
-            
-            case "subi":
-                opcode = "000101"
-                binary.append(opcode+registers[src]+registers[tgt]+valueToBinary(dst, 0))
-            
-            case "muli":
-                opcode = "000110"
-                binary.append(opcode+registers[src]+registers[tgt]+valueToBinary(dst, 0))
-            
-            case "divi":
-                opcode = "000111"
-                binary.append(opcode+registers[src]+registers[tgt]+valueToBinary(dst, 0))
-            
-            case "andi":
-                opcode = "001000"
-                binary.append(opcode+registers[src]+registers[tgt]+valueToBinary(dst, 0))
-            
-            case "ori":
-                opcode = "001001"
-                binary.append(opcode+registers[src]+registers[tgt]+valueToBinary(dst, 0))
-            
-            case "beq":
-                opcode = "001100"
-                binary.append(opcode+registers[src]+registers[tgt]+valueToBinary(dst, 0))
-            
-            # case "bne":
-            #     continue
-            
-            # case "lui":
-            #     continue
-            
-            case "seti":
-                opcode = "010000"
-                binary.append(opcode+registers[src]+registers[tgt]+valueToBinary(dst, 0))
-            
-            case "sdti":
-                opcode = "010001"
-                binary.append(opcode+registers[src]+registers[tgt]+valueToBinary(dst, 0))
-            
-            case "sgti":
-                opcode = "010010"
-                binary.append(opcode+registers[src]+registers[tgt]+valueToBinary(dst, 0))
-            
-            case "slti":
-                opcode = "010011"
-                binary.append(opcode+registers[src]+registers[tgt]+valueToBinary(dst, 0))
-            
-            case "segti":
-                opcode = "010100"
-                binary.append(opcode+registers[src]+registers[tgt]+valueToBinary(dst, 0))
-            
-            case "selti":
-                opcode = "010101"
-                binary.append(opcode+registers[src]+registers[tgt]+valueToBinary(dst, 0))
-                
-            case "pcbkp":
-                opcode = "011111"
-                binary.append(opcode+"00000"+registers[tgt]+"00000"+"00000"+"000000")
-            
-            # # J-Type
-            case "nop":
-                binary.append("00000000000000000000000000000000")
-            
-            case "j":
-                opcode = "100000"
-                binary.append(opcode+valueToBinary(src, 1))
-            
-            case "jal":
-                opcode = "100001"
-                binary.append(opcode+valueToBinary(src, 1))
-            
-            case "halt":
-                opcode = "111111"
-                binary.append(opcode+"00000000000000000000000000"+" // Halt")
-            
-            case _:
-                binary.append(f"---UNKNOWN---")
+    for index, inst in enumerate(instructions):
+        word = encodeWord(inst)
+
+        if (isinstance(word, str)):
+            errors.append(f"[{index}] {inst.instr} {inst.addr_src} {inst.addr_tgt} {inst.addr_dst} → {word}")
+            word = 0
+        binary.append(word)
+
+    if (len(errors) > 0):
+        print(f"> Misc Error\n     Could not encode {len(errors)} instruction(s) of [{source}]:")
+        for error in errors:
+            print(f"     {error}")
+        sys.exit(1)
     return binary
 
-def binarySave(path: str, bin: List[str]):
+# The program is loaded as a cluster of programRange words (systemRange for the system, whose cluster starts with its
+# size); the words past the code are zero
+def imageLayout(words: List[int]) -> Tuple[List[int], int]:
+    if (system or Path(source).stem == systemName):
+        return [len(words)] + words, 1 + max(systemRange, len(words))
+    return words, max(programRange, len(words))
+
+# saveListing() → The annotated text listing: a line of 32 '0'/'1' per word, with comments, padded up to the cluster size
+def saveListing(path: str, words: List[int], depth: int):
+    image, _ = imageLayout(words)
+    header = len(image) - len(words)
+    lines = []
+
+    if (header > 0):
+        lines.append(f"{format(len(words), '032b')} // --- {source} Size = {len(words)} ")
+    for index, (word, inst) in enumerate(zip(words, instructions)):
+        line = format(word, '032b')
+        if (inst.instr == "halt"):
+            line += " // Halt"
+        if (inst.instr == "jimset" and inst.addr_src == "$so"):
+            line += " // --- END OF FILE ---"
+        if (index == 0):
+            line += f" // --- START OF CLUSTER ({source})"
+        lines.append(line)
+    if (depth > len(image)):
+        lines.extend(["0" * 32] * (depth - len(image) - 1))
+        lines.append(f"{'0' * 32} // --- END OF CLUSTER ({source})")
+
     with open(path, 'w') as output:
-        size = len(bin)
-        
-        if (traceBinary):
-            print("\n> Binary Code Tracing ------------------------------------------------------")
-            print("--------------------------------------------------------------------------- -")
-            if source == "inputs/SO.cm":
-                output.write(f"{format(size, '032b')} // --- {source} Size = {size} \n")
-        for index, (bin_line, inst_line) in enumerate(zip(bin, instructions)):
-            line = f"{bin_line}\n"
-            
-            if (traceBinary):
-                if (index == 0):
-                    line = f"{bin_line} // --- START OF CLUSTER ({source})\n"
-                    print(f"    > [{index}] {inst_line.instr} {inst_line.addr_src} {inst_line.addr_tgt} {inst_line.addr_dst}\n        {line}", end = "")
-                else:
-                    print(f"    > [{index}] {inst_line.instr} {inst_line.addr_src} {inst_line.addr_tgt} {inst_line.addr_dst}\n        {line}", end = "")
-            output.write(line)
-            
-        if source == "inputs/SO.cm":
-            if systemRange > size:
-                for index in range(size, systemRange):
-                    if (index == 0):
-                        output.write(f"{format(size, '032b')} // --- {source} Size = {size} \n")
-                    elif (index == systemRange - 1):
-                        output.write(f"00000000000000000000000000000000 // --- END OF CLUSTER ({source})\n")
-                    else:
-                        output.write("00000000000000000000000000000000\n")
-        else:
-            if programRange > size:
-                for index in range(size, programRange):
-                    if (index == 0):
-                        output.write(f"{format(size, '032b')} // --- {source} Size = {size} \n")
-                    elif (index == programRange - 1):
-                        output.write(f"00000000000000000000000000000000 // --- END OF CLUSTER ({source})\n")
-                    else:
-                        output.write("00000000000000000000000000000000\n")
-
-def main():
-    path_assembly = "outputs/assembly.txt"
-    path_binary = "outputs/binary.txt"
+        output.write("\n".join(lines) + "\n")
+
+# saveRaw() → Packed raw image: 4 bytes per word, big endian; the zero padding is left implicit (the file ends with the
+# code)
+def saveRaw(path: str, words: List[int], depth: int):
+    image, _ = imageLayout(words)
+
+    with open(path, 'wb') as output:
+        output.write(b"".join(word.to_bytes(4, "big") for word in image))
+
+# hexRecord() → An Intel HEX record: byte count, address, type, data and checksum
+def hexRecord(address: int, kind: int, data: bytes) -> str:
+    record = bytes([len(data), (address >> 8) & 0xFF, address & 0xFF, kind]) + data
+    return f":{record.hex().upper()}{(-sum(record)) & 0xFF:02X}\n"
+
+# saveHex() → Intel HEX with word addresses (one 32 bit word per record, as memory initialization tools read it); zero
+# words get no record, so the padding is sparse
+def saveHex(path: str, words: List[int], depth: int):
+    image, _ = imageLayout(words)
+    records = []
+    segment = 0
+
+    for address, word in enumerate(image):
+        if (word == 0):
+            continue
+        if (address >> 16 != segment):
+            segment = address >> 16
+            records.append(hexRecord(0, 4, segment.to_bytes(2, "big")))
+        records.append(hexRecord(address & 0xFFFF, 0, word.to_bytes(4, "big")))
+    records.append(hexRecord(0, 1, b""))
+
+    with open(path, 'w') as output:
+        output.write("".join(records))
+
+# saveMif() → Memory Initialization File of the whole cluster; runs of zero words are written as a single range
+def saveMif(path: str, words: List[int], depth: int):
+    image, _ = imageLayout(words)
+    image = image + [0] * (depth - len(image))
+    lines = [f"DEPTH = {depth};", "WIDTH = 32;", "ADDRESS_RADIX = DEC;", "DATA_RADIX = HEX;", "CONTENT", "BEGIN"]
+
+    address = 0
+    while (address < depth):
+        if (image[address] != 0):
+            lines.append(f"{address} : {image[address]:08X};")
+            address += 1
+            continue
+
+        end = address
+        while (end + 1 < depth and image[end + 1] == 0):
+            end += 1
+        lines.append(f"{address} : 00000000;" if end == address else f"[{address}..{end}] : 00000000;")
+        address = end + 1
+    lines.append("END;")
+
+    with open(path, 'w') as output:
+        output.write("\n".join(lines) + "\n")
+
+# Output formats, picked by "--format" or else by the extension of the output file (raw when it is none of these)
+saveFormats = {
+    "raw":     saveRaw,
+    "hex":     saveHex,
+    "mif":     saveMif,
+    "listing": saveListing,
+}
+extensions = {".bin": "raw", ".hex": "hex", ".mif": "mif", ".txt": "listing"}
+
+def binarySave(path: str, words: List[int], form: Optional[str] = None):
+    if (form is None):
+        form = extensions.get(Path(path).suffix, "raw")
+
+    if (traceFile is not None):
+        tracelog.section(traceFile, "binary")
+        for word, inst in zip(words, instructions):
+            traceFile.write(f"{inst.instr}\t{inst.addr_src}\t{inst.addr_tgt}\t{inst.addr_dst}\t{word:032b}\n")
+
+    _, depth = imageLayout(words)
+    saveFormats[form](path, words, depth)
+
+# loadImage() → The words of a program image in any of the output formats, without the zero padding past its end
+def loadImage(path: str) -> List[int]:
+    form = extensions.get(Path(path).suffix, "raw")
+    words = {}
+
+    if (form == "raw"):
+        data = Path(path).read_bytes()
+        words = {i // 4: int.from_bytes(data[i:i + 4], "big") for i in range(0, len(data) - 3, 4)}
+    elif (form == "hex"):
+        segment = 0
+        for line in Path(path).read_text().split():
+            record = bytes.fromhex(line[1:])
+            address, kind, data = (record[1] << 8) | record[2], record[3], record[4:4 + record[0]]
+            if (kind == 4):
+                segment = int.from_bytes(data, "big") << 16
+            elif (kind == 0):
+                for i in range(0, len(data), 4):
+                    words[segment + address + i // 4] = int.from_bytes(data[i:i + 4], "big")
+    elif (form == "mif"):
+        content = Path(path).read_text().split("BEGIN", 1)[1]
+        for entry in content.split(";"):
+            entry = entry.split("--")[0].strip()
+            if (":" not in entry):
+                continue
+            address, value = [part.strip() for part in entry.split(":")]
+            first, _, last = address.strip("[]").partition("..")
+            for a in range(int(first), int(last or first) + 1):
+                words[a] = int(value, 16)
+    else:
+        for index, line in enumerate(Path(path).read_text().splitlines()):
+            word = line.split("//")[0].strip()
+            if (word != ""):
+                words[index] = int(word, 2)
+
+    image = [0] * (max(words) + 1 if len(words) > 0 else 0)
+    for address, word in words.items():
+        image[address] = word
+    while (len(image) > 0 and image[-1] == 0):
+        image.pop()
+    return image
+
+def main(argv: List[str]):
+    global traceFile, system
+
+    # Usage: binary_codegen.py [assembly] [binary] [--format raw|hex|mif|listing] [--system] [--report file] [--trace file]
+    traceFile = tracelog.traceOption(argv)
+    report = metrics.reportOption(argv)
+    system = "--system" in argv
+    form = None
+    if ("--format" in argv):
+        index = argv.index("--format")
+        form = argv[index + 1] if index + 1 < len(argv) else None
+        del argv[index:index + 2]
+        if (form not in saveFormats):
+            print(f"> Misc Error\n     Unknown binary format \"{form}\" (raw, hex, mif or listing).")
+            sys.exit(1)
+    paths = [arg for arg in argv if not arg.startswith("-")]
+
+    path_assembly = paths[0] if len(paths) > 0 else "outputs/assembly.txt"
+    path_binary = paths[1] if len(paths) > 1 else "outputs/binary.bin"
     
     assembly = assemblyTranslate(path_assembly)
     binary = binaryCodeGenerate(assembly)
-    binarySave(path_binary, binary)
+    binarySave(path_binary, binary, form)
+    metrics.recordPhase(report, "binaryCodeGenerate", {"words": len(binary)})
+    if (traceFile is not None):
+        traceFile.close()
     
     print(f"\n> Binary code generated... → [{source}]\n")
     
 if __name__ == "__main__":
-    main()
\ No newline at end of file
+    main(sys.argv[1:])
\ No newline at end of file
@@ -0,0 +1,227 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Control Flow Graph (basic blocks, edges and dominators) over the Quadruples List for a C- Compiler
+ *  File: cfg.c
+ *---------------------------------*/
+
+#include "context.h"
+#include "utils.h"
+#include "cfg.h"
+
+#include <stdint.h>
+
+/*  nextFunction() → Index of the first FunBGN at or after "from" (or -1), its FunEND going to "last"  */
+int nextFunction(QuadBuffer *quads, int from, int *last) {
+    int first = from;
+
+    while (first < quads->count && quads->op[first] != FunBGN) first++;
+    if (first >= quads->count) return -1;
+
+    *last = first;
+    while (*last + 1 < quads->count && quads->op[*last] != FunEND) (*last)++;
+
+    return first;
+}
+
+/*  LabelRef → Label (interned name) and the block it starts  */
+typedef struct {
+    char *name;
+    int block;
+} LabelRef;
+
+static int compareLabels(const void *a, const void *b) {
+    uintptr_t x = (uintptr_t)((const LabelRef *)a)->name, y = (uintptr_t)((const LabelRef *)b)->name;
+    return (x > y) - (x < y);
+}
+
+/*  linkBlocks() → Successors (fall through and branch target, found by label) and predecessors of every block  */
+static void linkBlocks(CFG *g) {
+    QuadBuffer *q = g->quads;
+    LabelRef *labels = allocOrDie(g->count * sizeof(LabelRef));
+    int labelsCount = 0, edges = 0;
+
+    for (int b = 0; b < g->count; b++) {
+        if (q->op[g->blocks[b].first] == Label) {
+            labels[labelsCount].name = q->src[g->blocks[b].first].content.name;
+            labels[labelsCount++].block = b;
+        }
+    }
+    qsort(labels, labelsCount, sizeof(LabelRef), compareLabels);
+
+    for (int b = 0; b < g->count; b++) {
+        BasicBlock *block = &g->blocks[b];
+        Operation op = q->op[block->last];
+        LabelRef key, *target = NULL;
+
+        block->succ[0] = block->succ[1] = -1;
+
+        if (op == Jump || op == IFfalse) {
+            key.name = (op == Jump) ? q->src[block->last].content.name : q->tgt[block->last].content.name;
+            target = bsearch(&key, labels, labelsCount, sizeof(LabelRef), compareLabels);
+        }
+
+        if (op != Jump && op != FunEND && !isTailCall(q, block->last) && b + 1 < g->count) block->succ[0] = b + 1;
+        if (target != NULL) block->succ[1] = target->block;
+
+        for (int s = 0; s < 2; s++) {
+            if (block->succ[s] >= 0) {
+                g->blocks[block->succ[s]].predsCount++;
+                edges++;
+            }
+        }
+    }
+    free(labels);
+
+    int *preds = allocOrDie(edges * sizeof(int));
+
+    for (int b = 0; b < g->count; b++) {
+        g->blocks[b].preds = preds;
+        preds += g->blocks[b].predsCount;
+        g->blocks[b].predsCount = 0;
+    }
+    for (int b = 0; b < g->count; b++) {
+        for (int s = 0; s < 2; s++) {
+            BasicBlock *succ = (g->blocks[b].succ[s] >= 0) ? &g->blocks[g->blocks[b].succ[s]] : NULL;
+
+            if (succ != NULL) succ->preds[succ->predsCount++] = b;
+        }
+    }
+}
+
+/*  orderBlocks() → Depth first search from the entry: reverse postorder of the reachable blocks  */
+static void orderBlocks(CFG *g) {
+    int *stack = allocOrDie(g->count * sizeof(int));
+    int *next = allocOrDie(g->count * sizeof(int));
+    bool *seen = allocOrDie(g->count * sizeof(bool));
+    int depth = 0, post = g->count;
+
+    g->rpo = allocOrDie(g->count * sizeof(int));
+
+    stack[depth++] = 0;
+    seen[0] = true;
+
+    while (depth > 0) {
+        int b = stack[depth - 1];
+
+        if (next[b] < 2) {
+            int s = g->blocks[b].succ[next[b]++];
+
+            if (s >= 0 && !seen[s]) {
+                seen[s] = true;
+                stack[depth++] = s;
+            }
+        } else {
+            g->rpo[--post] = b;
+            depth--;
+        }
+    }
+
+    /* Reachable blocks were stored at the end: move them to the front   */
+    g->rpoCount = g->count - post;
+    memmove(g->rpo, g->rpo + post, g->rpoCount * sizeof(int));
+
+    for (int b = 0; b < g->count; b++) g->blocks[b].order = -1;
+    for (int n = 0; n < g->rpoCount; n++) g->blocks[g->rpo[n]].order = n;
+
+    free(stack);
+    free(next);
+    free(seen);
+}
+
+/*  buildCFG() → Splits the function [first, last] into basic blocks, links them and orders the reachable ones  */
+void buildCFG(CFG *g, QuadBuffer *quads, int first, int last) {
+    memset(g, 0, sizeof(CFG));
+
+    g->quads = quads;
+    g->first = first;
+    g->last = last;
+    g->blocks = allocOrDie((last - first + 1) * sizeof(BasicBlock));
+    g->blockOf = allocOrDie((last - first + 1) * sizeof(int));
+
+    for (int i = first; i <= last; i++) {
+        bool leader = (i == first) || quads->op[i] == Label || quads->op[i - 1] == Jump || quads->op[i - 1] == IFfalse || isTailCall(quads, i - 1);
+
+        if (leader) {
+            if (g->count > 0) g->blocks[g->count - 1].last = i - 1;
+            g->blocks[g->count].first = i;
+            g->blocks[g->count].idom = -1;
+            g->count++;
+        }
+        g->blockOf[i - first] = g->count - 1;
+    }
+    g->blocks[g->count - 1].last = last;
+
+    linkBlocks(g);
+    orderBlocks(g);
+}
+
+/*  intersect() → Closest common dominator of two blocks (walking up the dominator tree by reverse postorder)  */
+static int intersect(CFG *g, int a, int b) {
+    while (a != b) {
+        while (g->blocks[a].order > g->blocks[b].order) a = g->blocks[a].idom;
+        while (g->blocks[b].order > g->blocks[a].order) b = g->blocks[b].idom;
+    }
+    return a;
+}
+
+/*  computeDominators() → Immediate dominator of every reachable block (iterative, over the reverse postorder)  */
+void computeDominators(CFG *g) {
+    bool changed = true;
+
+    g->blocks[0].idom = 0;
+
+    while (changed) {
+        changed = false;
+
+        for (int n = 1; n < g->rpoCount; n++) {
+            BasicBlock *block = &g->blocks[g->rpo[n]];
+            int idom = -1;
+
+            for (int p = 0; p < block->predsCount; p++) {
+                int pred = block->preds[p];
+
+                if (g->blocks[pred].idom < 0) continue;
+                idom = (idom < 0) ? pred : intersect(g, pred, idom);
+            }
+
+            if (idom != block->idom) {
+                block->idom = idom;
+                changed = true;
+            }
+        }
+    }
+}
+
+/*  dominates() → Whether block "a" dominates block "b" (both reachable)  */
+bool dominates(CFG *g, int a, int b) {
+    while (b != a && b != 0) b = g->blocks[b].idom;
+
+    return b == a;
+}
+
+/*  freeCFG() → Releases a CFG  */
+void freeCFG(CFG *g) {
+    if (g->count > 0) free(g->blocks[0].preds);
+
+    free(g->blocks);
+    free(g->blockOf);
+    free(g->rpo);
+
+    memset(g, 0, sizeof(CFG));
+}
+
+/*  printCFG() → Prints the blocks of a function, their edges and immediate dominators (traced under TraceMidCode)  */
+void printCFG(CompilerContext *ctx, CFG *g) {
+    fprintf(ctx->listing, "\t> CFG of %s: %d block(s), %d reachable\n", g->quads->src[g->first].content.name, g->count, g->rpoCount);
+
+    for (int b = 0; b < g->count; b++) {
+        BasicBlock *block = &g->blocks[b];
+
+        fprintf(ctx->listing, "\t  B%-4d [%d-%d]", b, block->first, block->last);
+        for (int s = 0; s < 2; s++) {
+            if (block->succ[s] >= 0) fprintf(ctx->listing, " → B%d", block->succ[s]);
+        }
+
+        if (block->order < 0) fprintf(ctx->listing, "\t(unreachable)\n");
+        else fprintf(ctx->listing, "\tidom B%d\n", block->idom);
+    }
+}
@@ -0,0 +1,62 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Control Flow Graph interface for a C- Compiler
+ *  File: cfg.h
+ *---------------------------------*/
+
+#ifndef CFG_H
+#define CFG_H
+
+#include "globals.h"
+#include "mid_codegen.h"
+
+/*--------------------------------------------/
+ *  Control Flow Graph structure
+ *---------------------------------*/
+
+/*  BasicBlock → Quadruples [first, last] entered only at "first" (a Label or what follows a Jump/IFfalse/tail call) and
+ *  left only at "last"; succ[0] is the fall through and succ[1] the branch target (-1 if none)  */
+typedef struct {
+    int first, last;
+    int succ[2];
+    int *preds;
+    int predsCount;
+    int idom;
+    int order;
+} BasicBlock;
+
+/*  CFG → Basic blocks of one function (FunBGN to FunEND) in quadruple order, block 0 being the entry; "rpo" lists the
+ *  reachable ones in reverse postorder ("order" of a block is its position there, -1 when unreachable)  */
+typedef struct {
+    QuadBuffer *quads;
+    int first, last;
+
+    BasicBlock *blocks;
+    int count;
+    int *blockOf;
+    int *rpo;
+    int rpoCount;
+} CFG;
+
+/*--------------------------------------------/
+ *  Control Flow Graph functions
+ *---------------------------------*/
+
+/*  nextFunction() → Index of the first FunBGN at or after "from" (or -1), its FunEND going to "last"  */
+int nextFunction(QuadBuffer *quads, int from, int *last);
+
+/*  buildCFG() → Splits the function [first, last] into basic blocks, links them and orders the reachable ones  */
+void buildCFG(CFG *g, QuadBuffer *quads, int first, int last);
+
+/*  computeDominators() → Immediate dominator of every reachable block (iterative, over the reverse postorder)  */
+void computeDominators(CFG *g);
+
+/*  dominates() → Whether block "a" dominates block "b" (both reachable)  */
+bool dominates(CFG *g, int a, int b);
+
+/*  freeCFG() → Releases a CFG  */
+void freeCFG(CFG *g);
+
+/*  printCFG() → Prints the blocks of a function, their edges and immediate dominators (traced under TraceMidCode)  */
+void printCFG(CompilerContext *ctx, CFG *g);
+
+#endif
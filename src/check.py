@@ -0,0 +1,63 @@
+import sys
+from pathlib import Path
+from typing import List
+
+import simulator
+
+# Steps each program may run for (the interactive ones, BIOS, SO and tune, stop once they wait for input they are not given)
+checkLimit = 5_000_000
+
+# summary() → What a run is compared on: what it output and what it left on the LCD (not where nor after how many steps
+# it stopped, which the optimization level changes)
+def summary(run: simulator.Run) -> List[str]:
+    lines = [f"Output: {' '.join(str(value) for value in run.output) if run.output else '-'}"]
+    for line, chars in sorted(run.lcd.items()):
+        text = "".join(chr(c) if 32 <= c < 127 else "?" for c in chars[-16:])
+        lines.append(f"LCD line {line}: \"{text}\"")
+    return lines
+
+# binaryImage() → The binary image the batch wrote for a program, whatever its format
+def binaryImage(folder: Path) -> Path:
+    images = sorted(folder.glob("binary.*"))
+    return images[0] if len(images) > 0 else folder / "binary.bin"
+
+def main(argv: List[str]):
+    # Usage: check.py [outputs] [expected] [--update]
+    update = "--update" in argv
+    paths = [arg for arg in argv if not arg.startswith("-")]
+
+    outputs = Path(paths[0] if len(paths) > 0 else "outputs")
+    expected = Path(paths[1] if len(paths) > 1 else "inputs/expected")
+
+    simulator.encodingCheck()
+    failed = 0
+
+    for reference in sorted(expected.glob("*.out")):
+        name = reference.stem
+        image = binaryImage(outputs / name)
+        inputs = reference.with_suffix(".in")
+
+        try:
+            run = simulator.simulate(str(image), simulator.loadValues(str(inputs) if inputs.exists() else None),
+                                     limit=checkLimit)
+            result = summary(run)
+        except Exception as error:
+            result = [f"Error: {error}"]
+
+        if (update):
+            reference.write_text("\n".join(result) + "\n")
+            print(f"  [updated] {name}")
+        elif (result == reference.read_text().splitlines()):
+            print(f"  [ok]      {name}")
+        else:
+            failed += 1
+            print(f"  [failed]  {name} ({image})")
+            for want, got in zip(reference.read_text().splitlines(), result):
+                if (want != got):
+                    print(f"            expected {want}\n            got      {got}")
+
+    print(f"\n> {failed} program(s) failed")
+    sys.exit(1 if failed > 0 else 0)
+
+if __name__ == "__main__":
+    main(sys.argv[1:])
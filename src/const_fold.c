@@ -0,0 +1,335 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Constant Folding and Propagation over the Quadruples List for a C- Compiler
+ *  File: const_fold.c
+ *---------------------------------*/
+
+#include "context.h"
+#include "utils.h"
+#include "optimizer.h"
+
+/*--------------------------------------------/
+ *  Folding
+ *---------------------------------*/
+
+/*  isArithmetic() → Operations with two operands (src, tgt) and a result (dst)  */
+static bool isArithmetic(Operation op) {
+    return op >= Add && op <= SDT;
+}
+
+/*  isCommutative() → Operations whose operands may be swapped as they are  */
+static bool isCommutative(Operation op) {
+    return op == Add || op == Mul || op == Or || op == And || op == SET || op == SDT;
+}
+
+/*  mirrored() → Comparison with its operands swapped (a > b ⇔ b < a), or -1 if there is none  */
+static int mirrored(Operation op) {
+    switch (op) {
+        case SGT: return SLT;
+        case SLT: return SGT;
+        case SGET: return SLET;
+        case SLET: return SGET;
+        default: return -1;
+    }
+}
+
+/*  evaluate() → Computes "a op b" as the target does; false when it cannot be folded into a back end immediate  */
+static bool evaluate(Operation op, int a, int b, int *result) {
+    long x = a, y = b, v;
+
+    if (x < 0 || y < 0) return false;
+
+    switch (op) {
+        case Add: v = x + y; break;
+        case Sub: v = x - y; break;
+        case Mul: v = x * y; break;
+        case Div:
+            if (y == 0) return false;
+            v = x / y;
+            break;
+        case Or: v = x | y; break;
+        case And: v = x & y; break;
+        case Lshift:
+            if (y > 15) return false;
+            v = x << y;
+            break;
+        case Rshift:
+            if (y > 15) return false;
+            v = x >> y;
+            break;
+        case SGT: v = x > y; break;
+        case SLT: v = x < y; break;
+        case SGET: v = x >= y; break;
+        case SLET: v = x <= y; break;
+        case SET: v = x == y; break;
+        case SDT: v = x != y; break;
+        default: return false;
+    }
+
+    if (v < 0 || v > IMM_MAX) return false;
+
+    *result = (int)v;
+    return true;
+}
+
+/*--------------------------------------------/
+ *  Propagation
+ *---------------------------------*/
+
+/*  Known → Constant value of each temporary (temporaries are written once, before any read) and, for the current basic
+ *  block, of each scalar variable (valid while its stamps match the block, and the last call for globals)  */
+typedef struct {
+    bool *isConst;
+    int *value;
+    int *copyOf;
+
+    int *varValue;
+    int *varBlock;
+    int *varCall;
+    int block, call;
+} Known;
+
+static Address constAddress(int value) {
+    Address a;
+
+    a.type = addrConst;
+    a.symbolId = NO_SYMBOL;
+    a.content.value = value;
+
+    return a;
+}
+
+/*  substitute() → Replaces a read temporary by the one it copies and, where the back end takes an immediate, by its value  */
+static void substitute(CompilerContext *ctx, Known *k, Address *a, bool takesConst) {
+    if (a->type != addrTemp) return;
+
+    while (k->copyOf[a->content.value] >= 0) a->content.value = k->copyOf[a->content.value];
+
+    if (takesConst && k->isConst[a->content.value]) {
+        *a = constAddress(k->value[a->content.value]);
+        ctx->optStats.propagated++;
+    }
+}
+
+static void setConst(Known *k, Address *temp, int value) {
+    k->isConst[temp->content.value] = true;
+    k->value[temp->content.value] = value;
+}
+
+/*  varKnown() → Whether the variable (symbol ID) holds a known constant at this point of the block  */
+static bool varKnown(CompilerContext *ctx, Known *k, int id) {
+    if (id == NO_SYMBOL || k->varBlock[id] != k->block) return false;
+
+    return ctx->symbolTable.symbols[id]->scope != ctx->globalScope || k->varCall[id] == k->call;
+}
+
+/*  foldQuad() → Rewrites one arithmetic quadruple: folds it into a Move of its value, drops it as a copy (x + 0, x * 1...)
+ *  or puts it in a form the back end lowers correctly (constant as tgt); returns whether it must still be emitted  */
+static bool foldQuad(CompilerContext *ctx, Known *k, QuadBuffer *out, Operation *op, Address *src, Address *tgt, Address *dst) {
+    Address original;
+    int value;
+
+    substitute(ctx, k, src, false);
+    original = *src;
+
+    substitute(ctx, k, src, true);
+    substitute(ctx, k, tgt, true);
+
+    if (src->type == addrConst && tgt->type == addrConst && evaluate(*op, src->content.value, tgt->content.value, &value)) {
+        setConst(k, dst, value);
+        ctx->optStats.folded++;
+
+        *op = Move;
+        *src = constAddress(value);
+        *tgt = *dst;
+        dst->type = addrVoid;
+        return true;
+    }
+
+    /* Constant as tgt: swap (mirroring comparisons), or keep/put the src in a register   */
+    if (src->type == addrConst && tgt->type != addrConst) {
+        if (isCommutative(*op) || mirrored(*op) >= 0) {
+            Address swap = *src;
+
+            if (!isCommutative(*op)) *op = mirrored(*op);
+            *src = *tgt;
+            *tgt = swap;
+        } else if (original.type == addrTemp) {
+            *src = original;
+            ctx->optStats.propagated--;
+        } else {
+            Address temp = { addrTemp, NO_SYMBOL };
+            Address empty = { addrVoid, NO_SYMBOL };
+
+            temp.content.value = ctx->tempsCounter++;
+            appendQuad(out, Move, *src, temp, empty);
+            *src = temp;
+        }
+    }
+
+    if (src->type != addrTemp || tgt->type != addrConst) return true;
+
+    int c = tgt->content.value;
+
+    /* Neutral element: dst is a copy of src   */
+    if ((c == 0 && (*op == Add || *op == Sub || *op == Or || *op == Lshift || *op == Rshift)) ||
+        (c == 1 && (*op == Mul || *op == Div)))
+    {
+        k->copyOf[dst->content.value] = src->content.value;
+        ctx->optStats.copies++;
+        return false;
+    }
+
+    /* Absorbing element: dst is 0   */
+    if (c == 0 && (*op == Mul || *op == And)) {
+        setConst(k, dst, 0);
+        ctx->optStats.folded++;
+
+        *op = Move;
+        *src = constAddress(0);
+        *tgt = *dst;
+        dst->type = addrVoid;
+    }
+
+    return true;
+}
+
+/*  removeUnused() → Drops the Moves of constants into temporaries nobody reads anymore  */
+static void removeUnused(CompilerContext *ctx) {
+    QuadBuffer *q = &ctx->quadruples;
+    int *reads = allocOrDie(ctx->tempsCounter * sizeof(int));
+    bool *dead = allocOrDie(q->count * sizeof(bool));
+
+    for (int i = 0; i < q->count; i++) {
+        int roles = operandRoles(q->op[i]);
+
+        if ((roles & USE_SRC) && q->src[i].type == addrTemp) reads[q->src[i].content.value]++;
+        if ((roles & USE_TGT) && q->tgt[i].type == addrTemp) reads[q->tgt[i].content.value]++;
+        if ((roles & USE_DST) && q->dst[i].type == addrTemp) reads[q->dst[i].content.value]++;
+    }
+
+    for (int i = 0; i < q->count; i++) {
+        dead[i] = q->op[i] == Move && q->src[i].type == addrConst && q->tgt[i].type == addrTemp && reads[q->tgt[i].content.value] == 0;
+    }
+    removeQuads(q, dead);
+
+    free(reads);
+    free(dead);
+}
+
+/*  foldConstants() → Folds constant arithmetic, shifts and comparisons, propagates constants through temporaries and,
+ *  inside each basic block, through scalar variables; removes the definitions left unused  */
+void foldConstants(CompilerContext *ctx) {
+    QuadBuffer *q = &ctx->quadruples;
+    QuadBuffer out = { 0 };
+    Known k;
+    int symbols = ctx->symbolTable.count;
+
+    k.isConst = allocOrDie(ctx->tempsCounter * sizeof(bool));
+    k.value = allocOrDie(ctx->tempsCounter * sizeof(int));
+    k.copyOf = allocOrDie(ctx->tempsCounter * sizeof(int));
+    k.varValue = allocOrDie(symbols * sizeof(int));
+    k.varBlock = allocOrDie(symbols * sizeof(int));
+    k.varCall = allocOrDie(symbols * sizeof(int));
+    k.block = k.call = 1;
+
+    for (int t = 0; t < ctx->tempsCounter; t++) k.copyOf[t] = -1;
+
+    ctx->optStats.quadsBefore = q->count;
+
+    for (int i = 0; i < q->count; i++) {
+        Operation op = q->op[i];
+        Address src = q->src[i], tgt = q->tgt[i], dst = q->dst[i];
+
+        /* A new basic block forgets the variables   */
+        if (op == Label || op == FunBGN || (i > 0 && (q->op[i - 1] == Jump || q->op[i - 1] == IFfalse))) k.block++;
+
+        if (isArithmetic(op)) {
+            if (!foldQuad(ctx, &k, &out, &op, &src, &tgt, &dst)) continue;
+        } else {
+            switch (op) {
+                case LoadVAR:
+                    if (varKnown(ctx, &k, tgt.symbolId)) {
+                        setConst(&k, &dst, k.varValue[tgt.symbolId]);
+                        ctx->optStats.loadsReplaced++;
+
+                        op = Move;
+                        src = constAddress(k.varValue[tgt.symbolId]);
+                        tgt = dst;
+                        dst.type = addrVoid;
+                    }
+                    break;
+                case StoreVAR:
+                    substitute(ctx, &k, &src, true);
+
+                    if (dst.symbolId != NO_SYMBOL) {
+                        k.varBlock[dst.symbolId] = (src.type == addrConst) ? k.block : 0;
+                        k.varCall[dst.symbolId] = k.call;
+                        k.varValue[dst.symbolId] = src.content.value;
+                    }
+                    break;
+                case AllocVAR:
+                    if (tgt.symbolId != NO_SYMBOL) k.varBlock[tgt.symbolId] = 0;
+                    break;
+                case StoreARRAY:
+                    substitute(ctx, &k, &src, true);
+                    substitute(ctx, &k, &dst, false);
+                    break;
+                case LoadARRAY:
+                    substitute(ctx, &k, &tgt, false);
+                    break;
+                case Move:
+                    substitute(ctx, &k, &src, true);
+                    if (src.type == addrConst && tgt.type == addrTemp) setConst(&k, &tgt, src.content.value);
+                    break;
+                case IFfalse:
+                case Param:
+                    substitute(ctx, &k, &src, false);
+                    break;
+                case Call:
+                    k.call++;
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        appendQuad(&out, op, src, tgt, dst);
+    }
+
+    free(k.isConst);
+    free(k.value);
+    free(k.copyOf);
+    free(k.varValue);
+    free(k.varBlock);
+    free(k.varCall);
+
+    freeQuads(q);
+    *q = out;
+
+    removeUnused(ctx);
+
+    ctx->optStats.removed = ctx->optStats.quadsBefore - q->count;
+}
+
+/*  printOptStats() → Prints what the passes did to the Quadruples List  */
+void printOptStats(CompilerContext *ctx) {
+    OptStats *stats = &ctx->optStats;
+
+    fprintf(ctx->listing, "\n> Inlining: %d call(s) inlined, %d function(s) left without calls removed → estimated size %d → %d word(s) (cluster of %d), %d call sequence instruction(s) removed per pass over the inlined calls\n",
+        stats->inlined, stats->functionsRemoved, stats->wordsBefore, stats->wordsAfter, INLINE_WORDS, stats->overheadRemoved);
+    for (InlineRecord *r = stats->inlines; r != NULL; r = r->next) {
+        fprintf(ctx->listing, "\t> %s inlined into %s at %d call(s)\n", r->callee, r->caller, r->sites);
+    }
+    fprintf(ctx->listing, "> Constant Folding: %d quad(s) folded, %d constant(s) propagated (%d variable load(s)), %d copie(s) dropped → %d of %d quad(s) removed\n",
+        stats->folded, stats->propagated, stats->loadsReplaced, stats->copies, stats->removed, stats->quadsBefore);
+    fprintf(ctx->listing, "> Strength Reduction: %d multiplie(s) and %d divide(s) by a power of two turned into shifts\n",
+        stats->multiplies, stats->divides);
+    fprintf(ctx->listing, "> Dead Code Elimination: %d constant branch(es) folded, %d unreachable block(s) (%d quad(s)), %d jump(s) and %d label(s) dropped, %d dead computation(s), %d dead store(s) → %d of %d quad(s) removed\n",
+        stats->branches, stats->unreachableBlocks, stats->unreachable, stats->jumps, stats->labels, stats->computations, stats->stores, stats->deadRemoved, stats->deadBefore);
+    fprintf(ctx->listing, "> Tail Call Elimination: %d self recursive call(s) turned into loops (%d function(s) given an accumulator), %d call(s) turned into jumps reusing the frame\n",
+        stats->tailLoops, stats->accumulators, stats->tailJumps);
+    fprintf(ctx->listing, "> Loop Invariant Code Motion: %d quad(s) hoisted out of %d loop(s), %d of them merged with an equal one\n",
+        stats->hoisted, stats->loops, stats->merged);
+    fprintf(ctx->listing, "> Scalar Promotion: %d web(s) of locals and %d of globals kept in temporaries, %d load(s)/store(s) turned into copies (%d of them coalesced away), %d load(s)/store(s) added at entries, exits and calls\n",
+        stats->localWebs, stats->globalWebs, stats->accessesPromoted, stats->coalesced, stats->accessesAdded);
+}
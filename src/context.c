@@ -0,0 +1,60 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Compiler Context functions for a C- Compiler
+ *  File: context.c
+ *---------------------------------*/
+
+#include "context.h"
+
+/*  newContext() → Allocates an empty compilation context; listing (traces and messages) defaults to stdout  */
+CompilerContext *newContext(void) {
+    CompilerContext *ctx = calloc(1, sizeof(CompilerContext));
+
+    if (ctx == NULL) {
+        printf("> Misc Error\n     Out of memory error. (Compiler Context)\n");
+        exit(EXIT_FAILURE);
+    }
+
+    ctx->globalScope = intern(&ctx->names, &ctx->arena, "global");
+    ctx->mainName = intern(&ctx->names, &ctx->arena, "main");
+
+    ctx->listing = stdout;
+    ctx->lineno = 1;
+    ctx->firstToken = true;
+
+    return ctx;
+}
+
+/*  openSource() → Sets the source and intermediate code filepaths of a context and opens the source for reading  */
+bool openSource(CompilerContext *ctx, const char *source, const char *midcodePath) {
+    snprintf(ctx->source, sizeof(ctx->source), "%s", source);
+    snprintf(ctx->midcodePath, sizeof(ctx->midcodePath), "%s", midcodePath);
+
+    ctx->input = fopen(ctx->source, "r");
+
+    return ctx->input != NULL;
+}
+
+/*  contextMemory() → Peak memory (bytes) held by a context: arena blocks plus the Quadruples List  */
+size_t contextMemory(CompilerContext *ctx) {
+    return ctx->arena.reserved + ctx->names.capacity * sizeof(InternEntry)
+         + ctx->symbolTable.capacity * sizeof(int) + ctx->symbolTable.symbolsCapacity * sizeof(Symbol)
+         + ctx->quadruples.capacity * (sizeof(Operation) + 3 * sizeof(Address));
+}
+
+/*  freeContext() → Closes the files and releases everything owned by a context  */
+void freeContext(CompilerContext *ctx) {
+    if (ctx == NULL) return;
+
+    traceClose(ctx);
+
+    if (ctx->input != NULL) fclose(ctx->input);
+    if (ctx->listing != NULL && ctx->listing != stdout) fclose(ctx->listing);
+
+    st_release(&ctx->symbolTable);
+    internRelease(&ctx->names);
+    arenaRelease(&ctx->arena);
+
+    freeQuads(&ctx->quadruples);
+
+    free(ctx);
+}
@@ -0,0 +1,91 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Compiler Context interface for a C- Compiler
+ *  File: context.h
+ *---------------------------------*/
+
+#ifndef CONTEXT_H
+#define CONTEXT_H
+
+#include "globals.h"
+#include "arena.h"
+#include "intern.h"
+#include "symbol_table.h"
+#include "mid_codegen.h"
+#include "optimizer.h"
+#include "reg_alloc.h"
+#include "metrics.h"
+#include "trace.h"
+
+/*--------------------------------------------/
+ *  Compiler Context structure
+ *---------------------------------*/
+
+/*  (struct CompilerContext) CompilerContext → Every piece of state of one compilation (one translation unit), so that
+ *  several sources can be compiled at once, each one on its own thread, inside a single process  */
+struct CompilerContext {
+    /*  Memory → Every AST node, symbol and string of this compilation  */
+    Arena arena;
+
+    /*  Names → Canonical identifiers, scopes, registers and labels (compared by pointer)  */
+    InternTable names;
+    char *globalScope;
+    char *mainName;
+
+    /*  Source and outputs  */
+    char source[512];
+    char midcodePath[512];
+    FILE *input;
+    FILE *listing;
+
+    /*  Lexical Analysis → Reentrant Flex scanner (yyscan_t) and its tracing state  */
+    void *scanner;
+    int lineno;
+    int currentToken;
+    bool firstToken;
+
+    /*  Syntax Analysis  */
+    TreeNode *abstractSyntaxTree;
+
+    /*  Semantic Analysis → Symbol Table  */
+    SymbolTable symbolTable;
+    bool mainDeclared;
+    TreeNode *lastFunctionDeclared;
+
+    /*  Intermediate Code → Quadruples List, temporaries (virtual registers) and labels in use, optimization and register
+     *  allocation reports  */
+    QuadBuffer quadruples;
+    int tempsCounter;
+    int labelsCounter;
+    char *exitLabel;
+    OptStats optStats;
+    RegAllocStats regAllocStats;
+    Address current;
+
+    /*  Failure → Set by every lexical, syntax and semantic error and by a phase that cannot finish this unit (each one
+     *  reported on its listing); the later phases are skipped, so one bad unit never stops the others of a batch  */
+    bool failed;
+
+    /*  Metrics → Time and memory of each phase, and the counters of the JSON report (see metrics.h)  */
+    Metrics metrics;
+
+    /*  Tracing → Buffered log of the selected trace categories (see trace.h)  */
+    TraceLog trace;
+};
+
+/*--------------------------------------------/
+ *  Compiler Context functions
+ *---------------------------------*/
+
+/*  newContext() → Allocates an empty compilation context; listing (traces and messages) defaults to stdout  */
+CompilerContext *newContext(void);
+
+/*  openSource() → Sets the source and intermediate code filepaths of a context and opens the source for reading  */
+bool openSource(CompilerContext *ctx, const char *source, const char *midcodePath);
+
+/*  contextMemory() → Peak memory (bytes) held by a context: arena blocks plus the Quadruples List  */
+size_t contextMemory(CompilerContext *ctx);
+
+/*  freeContext() → Closes the files and releases everything owned by a context  */
+void freeContext(CompilerContext *ctx);
+
+#endif
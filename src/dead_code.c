@@ -0,0 +1,329 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Dead and Unreachable Code Elimination over the Quadruples List for a C- Compiler
+ *  File: dead_code.c
+ *---------------------------------*/
+
+#include "context.h"
+#include "utils.h"
+#include "optimizer.h"
+#include "cfg.h"
+
+#include <stdint.h>
+
+/*  definedTemp() → Temporary written by a quadruple with no other effect (arithmetic, loads, Moves), or -1  */
+static int definedTemp(QuadBuffer *q, int i) {
+    int roles = operandRoles(q->op[i]);
+
+    if ((roles & DEF_DST) && q->dst[i].type == addrTemp) return q->dst[i].content.value;
+    if ((roles & DEF_TGT) && q->tgt[i].type == addrTemp) return q->tgt[i].content.value;
+
+    return -1;
+}
+
+/*--------------------------------------------/
+ *  Control flow
+ *---------------------------------*/
+
+/*  foldBranches() → IFfalse on a constant: a Jump to its label when the condition is 0, nothing otherwise  */
+static void foldBranches(CompilerContext *ctx, bool *dead) {
+    QuadBuffer *q = &ctx->quadruples;
+    bool *isConst = allocOrDie(ctx->tempsCounter * sizeof(bool));
+    int *value = allocOrDie(ctx->tempsCounter * sizeof(int));
+
+    for (int i = 0; i < q->count; i++) {
+        if (q->op[i] == Move && q->src[i].type == addrConst && q->tgt[i].type == addrTemp) {
+            isConst[q->tgt[i].content.value] = true;
+            value[q->tgt[i].content.value] = q->src[i].content.value;
+        }
+    }
+
+    for (int i = 0; i < q->count; i++) {
+        Address *cond = &q->src[i];
+        int c;
+
+        if (q->op[i] != IFfalse) continue;
+
+        if (cond->type == addrConst) c = cond->content.value;
+        else if (cond->type == addrTemp && isConst[cond->content.value]) c = value[cond->content.value];
+        else continue;
+
+        if (c == 0) {
+            q->op[i] = Jump;
+            q->src[i] = q->tgt[i];
+            q->tgt[i].type = addrVoid;
+        } else {
+            dead[i] = true;
+        }
+        ctx->optStats.branches++;
+    }
+
+    free(isConst);
+    free(value);
+}
+
+/*  removeUnreachable() → Drops the blocks no path from FunBGN reaches; their allocations stay, as the frame layout
+ *  (offsets of the variables) is decided by them, and so does FunEND (after an endless loop)  */
+static void removeUnreachable(CompilerContext *ctx, bool *dead) {
+    QuadBuffer *q = &ctx->quadruples;
+    int first, last;
+
+    for (first = nextFunction(q, 0, &last); first >= 0; first = nextFunction(q, last + 1, &last)) {
+        CFG g;
+
+        buildCFG(&g, q, first, last);
+
+        for (int b = 0; b < g.count; b++) {
+            if (g.blocks[b].order >= 0) continue;
+
+            for (int i = g.blocks[b].first; i <= g.blocks[b].last; i++) {
+                if (q->op[i] == AllocVAR || q->op[i] == AllocARRAY || q->op[i] == FunEND) continue;
+
+                dead[i] = true;
+                ctx->optStats.unreachable++;
+            }
+            ctx->optStats.unreachableBlocks++;
+        }
+
+        freeCFG(&g);
+    }
+}
+
+/*  targetsNext() → Whether the label "name" is among the ones right after quadruple i (where execution goes anyway)  */
+static bool targetsNext(QuadBuffer *q, int i, char *name) {
+    for (int j = i + 1; j < q->count && q->op[j] == Label; j++) {
+        if (q->src[j].content.name == name) return true;
+    }
+    return false;
+}
+
+/*  removeJumps() → Drops the Jumps (and IFfalses) to the next quadruple, then the labels nothing jumps to  */
+static void removeJumps(CompilerContext *ctx, bool *dead) {
+    QuadBuffer *q = &ctx->quadruples;
+    char **targets = allocOrDie(q->count * sizeof(char *));
+    int count = 0;
+
+    for (int i = 0; i < q->count; i++) {
+        char *name;
+
+        if (q->op[i] == Jump) name = q->src[i].content.name;
+        else if (q->op[i] == IFfalse) name = q->tgt[i].content.name;
+        else continue;
+
+        if (targetsNext(q, i, name)) {
+            dead[i] = true;
+            ctx->optStats.jumps++;
+        } else {
+            targets[count++] = name;
+        }
+    }
+
+    for (int i = 0; i < q->count; i++) {
+        bool referenced = false;
+
+        if (q->op[i] != Label) continue;
+
+        for (int t = 0; t < count && !referenced; t++) referenced = (targets[t] == q->src[i].content.name);
+
+        if (!referenced) {
+            dead[i] = true;
+            ctx->optStats.labels++;
+        }
+    }
+
+    free(targets);
+}
+
+/*--------------------------------------------/
+ *  Dead computations and stores
+ *---------------------------------*/
+
+/*  removeDeadTemps() → Drops the quadruples whose temporary nobody reads, until none is left (dropping one may leave
+ *  the temporaries it read unused); returns how many were dropped  */
+static int removeDeadTemps(CompilerContext *ctx, bool *dead) {
+    QuadBuffer *q = &ctx->quadruples;
+    int *reads = allocOrDie(ctx->tempsCounter * sizeof(int));
+    int removed = 0;
+    bool changed = true;
+
+    for (int i = 0; i < q->count; i++) {
+        int roles = operandRoles(q->op[i]);
+
+        if (dead[i]) continue;
+
+        if ((roles & USE_SRC) && q->src[i].type == addrTemp) reads[q->src[i].content.value]++;
+        if ((roles & USE_TGT) && q->tgt[i].type == addrTemp) reads[q->tgt[i].content.value]++;
+        if ((roles & USE_DST) && q->dst[i].type == addrTemp) reads[q->dst[i].content.value]++;
+    }
+
+    while (changed) {
+        changed = false;
+
+        for (int i = q->count - 1; i >= 0; i--) {
+            int t = definedTemp(q, i);
+
+            if (dead[i] || t < 0 || reads[t] > 0) continue;
+
+            int roles = operandRoles(q->op[i]);
+
+            if ((roles & USE_SRC) && q->src[i].type == addrTemp) reads[q->src[i].content.value]--;
+            if ((roles & USE_TGT) && q->tgt[i].type == addrTemp) reads[q->tgt[i].content.value]--;
+
+            dead[i] = true;
+            removed++;
+            changed = true;
+        }
+    }
+
+    ctx->optStats.computations += removed;
+
+    free(reads);
+    return removed;
+}
+
+#define BIT_SET(set, i) ((set)[(i) / 64] |= (uint64_t)1 << ((i) % 64))
+#define BIT_CLEAR(set, i) ((set)[(i) / 64] &= ~((uint64_t)1 << ((i) % 64)))
+#define BIT_TEST(set, i) (((set)[(i) / 64] >> ((i) % 64)) & 1)
+
+/*  localVar() → Index of the local scalar read by a LoadVAR or written by a StoreVAR in "vars" (added if new), or -1 for
+ *  globals (the scope on the quadruple is the function's, so the symbol tells); locals are told apart by name, as the
+ *  back end gives each name of a function one frame slot  */
+static int localVar(CompilerContext *ctx, QuadBuffer *q, int i, char **vars, int *count) {
+    Address *var = (q->op[i] == LoadVAR) ? &q->tgt[i] : &q->dst[i];
+
+    if (var->symbolId == NO_SYMBOL || ctx->symbolTable.symbols[var->symbolId]->scope == ctx->globalScope) return -1;
+
+    for (int v = 0; v < *count; v++) {
+        if (vars[v] == var->content.name) return v;
+    }
+    vars[*count] = var->content.name;
+    return (*count)++;
+}
+
+/*  removeDeadStores() → Drops the StoreVARs to local scalars that are not read before being written again or the function
+ *  returns (backward liveness of the frame slots over the CFG; callees never see the caller's scalars); returns how many
+ *  were dropped  */
+static int removeDeadStores(CompilerContext *ctx, bool *dead) {
+    QuadBuffer *q = &ctx->quadruples;
+    int *varOf = allocOrDie(q->count * sizeof(int));
+    int first, last, removed = 0;
+
+    for (first = nextFunction(q, 0, &last); first >= 0; first = nextFunction(q, last + 1, &last)) {
+        char **vars = allocOrDie((last - first + 1) * sizeof(char *));
+        int count = 0;
+        CFG g;
+
+        for (int i = first; i <= last; i++) {
+            varOf[i] = (q->op[i] == LoadVAR || q->op[i] == StoreVAR) ? localVar(ctx, q, i, vars, &count) : -1;
+        }
+
+        if (count == 0) {
+            free(vars);
+            continue;
+        }
+
+        buildCFG(&g, q, first, last);
+
+        int words = (count + 63) / 64;
+        uint64_t *sets = allocOrDie(3 * (size_t)g.count * words * sizeof(uint64_t));
+        uint64_t *live = allocOrDie(words * sizeof(uint64_t));
+        bool changed = true;
+
+        /* use (read before written) and def of each block, then in = use ∪ (out − def) until nothing changes   */
+        for (int b = 0; b < g.count; b++) {
+            uint64_t *use = sets + (3 * (size_t)b) * words, *def = use + words;
+
+            for (int i = g.blocks[b].first; i <= g.blocks[b].last; i++) {
+                if (varOf[i] < 0) continue;
+
+                if (q->op[i] == LoadVAR && !BIT_TEST(def, varOf[i])) BIT_SET(use, varOf[i]);
+                if (q->op[i] == StoreVAR) BIT_SET(def, varOf[i]);
+            }
+        }
+
+        while (changed) {
+            changed = false;
+
+            for (int b = g.count - 1; b >= 0; b--) {
+                uint64_t *use = sets + (3 * (size_t)b) * words, *def = use + words, *in = def + words;
+
+                for (int w = 0; w < words; w++) {
+                    uint64_t out = 0;
+
+                    for (int s = 0; s < 2; s++) {
+                        if (g.blocks[b].succ[s] >= 0) out |= sets[(3 * (size_t)g.blocks[b].succ[s] + 2) * words + w];
+                    }
+
+                    uint64_t value = use[w] | (out & ~def[w]);
+
+                    if (value != in[w]) {
+                        in[w] = value;
+                        changed = true;
+                    }
+                }
+            }
+        }
+
+        /* Walk each block backwards from its live out: a store to a dead slot is dropped   */
+        for (int b = 0; b < g.count; b++) {
+            memset(live, 0, words * sizeof(uint64_t));
+
+            for (int s = 0; s < 2; s++) {
+                if (g.blocks[b].succ[s] < 0) continue;
+
+                for (int w = 0; w < words; w++) live[w] |= sets[(3 * (size_t)g.blocks[b].succ[s] + 2) * words + w];
+            }
+
+            for (int i = g.blocks[b].last; i >= g.blocks[b].first; i--) {
+                if (varOf[i] < 0 || dead[i]) continue;
+
+                if (q->op[i] == LoadVAR) {
+                    BIT_SET(live, varOf[i]);
+                } else if (!BIT_TEST(live, varOf[i])) {
+                    dead[i] = true;
+                    removed++;
+                } else {
+                    BIT_CLEAR(live, varOf[i]);
+                }
+            }
+        }
+
+        free(sets);
+        free(live);
+        free(vars);
+        freeCFG(&g);
+    }
+
+    ctx->optStats.stores += removed;
+
+    free(varOf);
+    return removed;
+}
+
+/*  eliminateDeadCode() → Folds constant branches, drops unreachable blocks, useless jumps and labels, then dead
+ *  computations and dead stores to frame slots until none is left  */
+void eliminateDeadCode(CompilerContext *ctx) {
+    QuadBuffer *q = &ctx->quadruples;
+    bool *dead = allocOrDie(q->count * sizeof(bool));
+    int removed;
+
+    ctx->optStats.deadBefore = q->count;
+
+    foldBranches(ctx, dead);
+    removeQuads(q, dead);
+
+    removeUnreachable(ctx, dead);
+    removeQuads(q, dead);
+
+    removeJumps(ctx, dead);
+    removeQuads(q, dead);
+
+    do {
+        removed = removeDeadStores(ctx, dead);
+        removed += removeDeadTemps(ctx, dead);
+        removeQuads(q, dead);
+    } while (removed > 0);
+
+    ctx->optStats.deadRemoved = ctx->optStats.deadBefore - q->count;
+
+    free(dead);
+}
@@ -12,23 +12,32 @@
 #include <stdbool.h>
 #include <dirent.h>
 
+/*--------------------------------------------/
+ *  Compiler Context → Every per-compilation state lives in it (see context.h)
+ *---------------------------------*/
+
+typedef struct CompilerContext CompilerContext;
+
 /*--------------------------------------------/
  *  Lexical Analysis → Flex variables & functions
  *---------------------------------*/
 
-/*  yyin → Flex's input filepath  */
-extern FILE* yyin;
-/*  yylineno → Real time Flex's line number   */
-extern int yylineno;
+/*  YYSTYPE → Bison's semantic value, filled in by the (pure) scanner  */
+union YYSTYPE;
+
+/*  scannerInit() → Creates the reentrant Flex scanner of a context, reading from its source  */
+extern void scannerInit(CompilerContext *ctx);
+/*  scannerDestroy() → Releases the reentrant Flex scanner of a context  */
+extern void scannerDestroy(CompilerContext *ctx);
 /* getToken() → Call yylex(), treat the TOKEN and then return ---> Traceable   */
-extern int getToken(void);
+extern int getToken(union YYSTYPE *lval, CompilerContext *ctx);
  
 /*--------------------------------------------/
   *  Syntax Analysis → YACC-Bison variables & functions
   *---------------------------------*/
 
 /*  syntaxAnalysis() → Call yyparse() and build the AST ---> Traceable    */
-extern void syntaxAnalysis(void);
+extern void syntaxAnalysis(CompilerContext *ctx);
 
 /*--------------------------------------------/
  *  Global significant variables
@@ -37,21 +46,20 @@ extern void syntaxAnalysis(void);
 /*  INPUT_DIR → Inputs folder name */
 extern char *INPUT_DIR;
 
-/*  source[] → Source filepath */
-extern char source[512];
+/*  OUTPUT_DIR → Outputs folder name */
+extern char *OUTPUT_DIR;
 
-/*--------------------------------------------/
- *  Tracing Flags
- *---------------------------------*/
+/*  BACKEND_DIR → Folder holding the Python back end stages (assembly and binary code generators) */
+extern char *BACKEND_DIR;
+
+/*  PYTHON → Python interpreter used to run the back end stages */
+extern char *PYTHON;
+
+/*  OPT_LEVEL → 0 runs no optimization pass over the Quadruples List (only the register allocation), 1 runs them all */
+extern int OPT_LEVEL;
 
-/* TraceScan → Trace Flex's scanner getToken() - yylex() - executions and prints it out   */
-extern bool TraceScan;
-/* TraceParse → Trace Bison's parser Abstract Syntax Tree (AST) and prints it out   */
-extern bool TraceParse;
-/* TraceSemantic → Trace Semantic's Analyzer and its Symbol Table; and prints it out   */
-extern bool TraceSemantic;
-/* TraceMidCode → Trace Intermediate "Mid" Code Generator and it's Quadruples List; and prints it out   */
-extern bool TraceMidCode;
+/*  MIDCODE_TEXT → Also dump the Quadruples List as text (midcode.txt) next to the binary midcode.ir */
+extern bool MIDCODE_TEXT;
 
 /*--------------------------------------------/
  *  Abstract Syntax Tree (AST) and related structures
@@ -77,6 +85,8 @@ typedef enum {
     ExpOperator, ExpConst, ExpID, ExpCall
 } ExpKind;
 
+#define NO_SYMBOL -1
+
 /*  (struct treeNode) TreeNode → Standard tree node structure for constructing the Abstract Syntax Tree   */
 typedef struct treeNode {
     struct treeNode *sibling;
@@ -109,23 +119,24 @@ typedef struct treeNode {
     } flags;
 
     ExpType type;
-} TreeNode;
 
-/*  AbstractSyntaxTree → Pointer to TreeNode base of Abstract Syntax Tree   */
-extern TreeNode *abstractSyntaxTree;
+    /*  Binding → Declaration resolved by the Semantic Analysis (NULL/NO_SYMBOL until then)  */
+    struct SymbolRec *symbol;
+    int symbolId;
+} TreeNode;
 
 /*--------------------------------------------/
   *  Semantic Analysis variables & functions
   *---------------------------------*/
 
 /*  semanticAnalysis() → Traverses the entire Abstract Syntax Tree and performs the Semantic Analysis  */
-extern void semanticAnalysis(TreeNode *AST);
+extern void semanticAnalysis(CompilerContext *ctx);
 
 /*--------------------------------------------/
   *  Intermediate Code functions
   *---------------------------------*/
 
 /*  midCodeGenerate() → Traverses the entire Abstract Syntax Tree and performs the Intermediate Code Generation  */
-extern void midCodeGenerate(TreeNode *AST);
+extern void midCodeGenerate(CompilerContext *ctx);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,549 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Function Inlining over the Quadruples List for a C- Compiler
+ *  File: inline.c
+ *---------------------------------*/
+
+#include "context.h"
+#include "optimizer.h"
+#include "utils.h"
+#include "cfg.h"
+
+/*  Function → A function of the program: where it was in the Quadruples List, its quadruples (FunBGN to FunEND, rebuilt
+ *  once its own calls are inlined), its estimated size, how many calls to it are left and what the call graph says  */
+typedef struct {
+    char *name;
+    int first, last;
+    QuadBuffer body;
+    int words;
+    int sites;
+    bool recursive, inlinable, removed;
+} Function;
+
+/*  Program → Every function, in source order, and the estimated size of the whole program  */
+typedef struct {
+    Function *functions;
+    int count;
+    int words;
+} Program;
+
+/*--------------------------------------------/
+ *  Size and call graph
+ *---------------------------------*/
+
+/*  isUserCall() → Whether the quadruple calls a user function  */
+static bool isUserCall(CompilerContext *ctx, QuadBuffer *q, int i) {
+    if (q->op[i] != Call) return false;
+    if (q->src[i].symbolId == NO_SYMBOL) return true;
+
+    return ctx->symbolTable.symbols[q->src[i].symbolId]->builtin == NotBuiltin;
+}
+
+/*  builtinWords() → Instructions assembly_codegen.py lowers a call to a predefined function into  */
+static int builtinWords(Builtin builtin) {
+    switch (builtin) {
+        case BuiltinExecute: return 12;
+        case BuiltinSetupProgram: return 10;
+        case BuiltinExecuteRR: return 119;
+        case BuiltinStoreHD: case BuiltinHDtoIM: return 2;
+        case BuiltinLCDwrite: return 16;
+        default: return 1;
+    }
+}
+
+/*  frameWords() → Instructions of the frame of a function (the $sp bump and the $ra save at FunBGN, its reload and the
+ *  jr at FunEND); main has none  */
+static int frameWords(CompilerContext *ctx, char *name) {
+    return (name == ctx->mainName) ? 0 : 4;
+}
+
+/*  quadWords() → Estimated instructions quadruple i becomes (before any later pass): a user call stores $fp, sets up the
+ *  new frame, stores each argument, jumps and restores $fp  */
+static int quadWords(CompilerContext *ctx, QuadBuffer *q, int i) {
+    switch (q->op[i]) {
+        case Label: case Param:
+            return 0;
+        case FunBGN:
+            return frameWords(ctx, q->src[i].content.name) / 2;
+        case FunEND:
+            return frameWords(ctx, q->src[i].content.name) / 2;
+        case AllocVAR:
+            return (q->src[i].content.name == ctx->globalScope) ? 0 : 1;
+        case AllocARRAY:
+            return (q->src[i].content.name == ctx->globalScope) ? 2 : (q->dst[i].content.value == 0) ? 1 : 3;
+        case Call:
+            if (!isUserCall(ctx, q, i)) return builtinWords(ctx->symbolTable.symbols[q->src[i].symbolId]->builtin);
+            return 6 + q->tgt[i].content.value;
+        default:
+            return 1;
+    }
+}
+
+static int bufferWords(CompilerContext *ctx, QuadBuffer *q) {
+    int words = 0;
+
+    for (int i = 0; i < q->count; i++) words += quadWords(ctx, q, i);
+    return words;
+}
+
+/*  functionOf() → Function called "name" (NULL for a predefined one)  */
+static Function *functionOf(Program *p, char *name) {
+    for (int f = 0; f < p->count; f++) {
+        if (p->functions[f].name == name) return &p->functions[f];
+    }
+    return NULL;
+}
+
+/*  reaches() → Whether function "from" may end up calling function "to" (depth first over the call graph)  */
+static bool reaches(CompilerContext *ctx, Program *p, Function *from, Function *to, bool *seen) {
+    for (int i = 0; i < from->body.count; i++) {
+        Function *callee;
+
+        if (!isUserCall(ctx, &from->body, i) || (callee = functionOf(p, from->body.src[i].content.name)) == NULL) continue;
+        if (callee == to) return true;
+
+        if (seen[callee - p->functions]) continue;
+        seen[callee - p->functions] = true;
+
+        if (reaches(ctx, p, callee, to, seen)) return true;
+    }
+    return false;
+}
+
+/*  postorder() → Appends the functions "f" calls, then "f": callees come before their callers (but in a cycle)  */
+static void postorder(CompilerContext *ctx, Program *p, Function *f, bool *seen, int *order, int *count) {
+    seen[f - p->functions] = true;
+
+    for (int i = 0; i < f->body.count; i++) {
+        Function *callee;
+
+        if (!isUserCall(ctx, &f->body, i) || (callee = functionOf(p, f->body.src[i].content.name)) == NULL) continue;
+        if (!seen[callee - p->functions]) postorder(ctx, p, callee, seen, order, count);
+    }
+
+    order[(*count)++] = f - p->functions;
+}
+
+/*  collectFunctions() → Copies out every function, counts the calls to each one and finds the ones that may be inlined:
+ *  not main, not recursive (not even through others) and without local arrays (their frame layout stays put)  */
+static void collectFunctions(CompilerContext *ctx, Program *p) {
+    QuadBuffer *q = &ctx->quadruples;
+    int first, last;
+
+    for (first = nextFunction(q, 0, &last); first >= 0; first = nextFunction(q, last + 1, &last)) p->count++;
+
+    p->functions = allocOrDie(p->count * sizeof(Function));
+    p->count = 0;
+
+    for (first = nextFunction(q, 0, &last); first >= 0; first = nextFunction(q, last + 1, &last)) {
+        Function *f = &p->functions[p->count++];
+
+        f->name = q->src[first].content.name;
+        f->first = first;
+        f->last = last;
+
+        for (int i = first; i <= last; i++) appendQuad(&f->body, q->op[i], q->src[i], q->tgt[i], q->dst[i]);
+        f->words = bufferWords(ctx, &f->body);
+    }
+
+    p->words = bufferWords(ctx, q);
+
+    bool *seen = allocOrDie(p->count * sizeof(bool));
+
+    for (int n = 0; n < p->count; n++) {
+        Function *f = &p->functions[n];
+
+        for (int i = 0; i < f->body.count; i++) {
+            Function *callee = isUserCall(ctx, &f->body, i) ? functionOf(p, f->body.src[i].content.name) : NULL;
+
+            if (callee != NULL) callee->sites++;
+        }
+
+        memset(seen, 0, p->count * sizeof(bool));
+        f->recursive = reaches(ctx, p, f, f, seen);
+        f->inlinable = !f->recursive && f->name != ctx->mainName;
+
+        for (int i = 0; i < f->body.count; i++) {
+            if (f->body.op[i] == AllocARRAY && f->body.dst[i].content.value > 0) f->inlinable = false;
+        }
+    }
+
+    free(seen);
+}
+
+/*  loopWeights() → 10^depth of every quadruple of a function, depth being how many while loops (a label some later jump
+ *  goes back to) enclose it  */
+static void loopWeights(QuadBuffer *q, long *weight) {
+    int *depth = allocOrDie((q->count + 1) * sizeof(int));
+
+    for (int j = 0; j < q->count; j++) {
+        char *name;
+
+        if (q->op[j] == Jump) name = q->src[j].content.name;
+        else if (q->op[j] == IFfalse) name = q->tgt[j].content.name;
+        else continue;
+
+        for (int l = 0; l < j; l++) {
+            if (q->op[l] != Label || q->src[l].content.name != name) continue;
+
+            depth[l]++;
+            depth[j + 1]--;
+        }
+    }
+
+    for (int i = 0, d = 0; i < q->count; i++) {
+        d += depth[i];
+
+        weight[i] = 1;
+        for (int k = 0; k < d && k < 4; k++) weight[i] *= 10;
+    }
+
+    free(depth);
+}
+
+/*--------------------------------------------/
+ *  Expansion of a call
+ *---------------------------------*/
+
+/*  Copy → Renaming of one inlined body: its temporaries, labels and locals get fresh ones in the caller  */
+typedef struct {
+    int *temps;
+    int tempsCount;
+
+    char **labels, **newLabels;
+    int labelsCount;
+
+    char **vars, **newVars;
+    int *newIds;
+    int varsCount;
+} Copy;
+
+static Address renameTemp(CompilerContext *ctx, Copy *c, Address a) {
+    if (a.type != addrTemp) return a;
+
+    if (c->temps[a.content.value] < 0) c->temps[a.content.value] = ctx->tempsCounter++;
+    a.content.value = c->temps[a.content.value];
+
+    return a;
+}
+
+static Address renameLabel(Copy *c, Address a) {
+    for (int l = 0; l < c->labelsCount; l++) {
+        if (c->labels[l] == a.content.name) a.content.name = c->newLabels[l];
+    }
+    return a;
+}
+
+/*  renameVar() → The caller's copy of a local of the callee (globals keep their name)  */
+static Address renameVar(Copy *c, Address a) {
+    for (int v = 0; v < c->varsCount; v++) {
+        if (c->vars[v] != a.content.name) continue;
+
+        a.content.name = c->newVars[v];
+        a.symbolId = c->newIds[v];
+    }
+    return a;
+}
+
+/*  prepareCopy() → Fresh labels for the labels of "callee", and a fresh name (one no C- identifier can take) and symbol
+ *  in "caller" for each of its locals  */
+static void prepareCopy(CompilerContext *ctx, Function *caller, Function *callee, int instance, Copy *c) {
+    QuadBuffer *q = &callee->body;
+    char name[256];
+
+    c->tempsCount = ctx->tempsCounter;
+    c->temps = allocOrDie(c->tempsCount * sizeof(int));
+    for (int t = 0; t < c->tempsCount; t++) c->temps[t] = -1;
+
+    c->labels = allocOrDie(q->count * sizeof(char *));
+    c->newLabels = allocOrDie(q->count * sizeof(char *));
+    c->vars = allocOrDie(q->count * sizeof(char *));
+    c->newVars = allocOrDie(q->count * sizeof(char *));
+    c->newIds = allocOrDie(q->count * sizeof(int));
+
+    for (int i = 0; i < q->count; i++) {
+        if (q->op[i] == Label) {
+            sprintf(name, "l%d", ctx->labelsCounter++);
+
+            c->labels[c->labelsCount] = q->src[i].content.name;
+            c->newLabels[c->labelsCount++] = internName(ctx, name);
+        } else if (q->op[i] == AllocVAR || q->op[i] == AllocARRAY) {
+            Symbol s = ctx->symbolTable.symbols[q->tgt[i].symbolId];
+
+            snprintf(name, sizeof(name), "%s.%s%d", q->tgt[i].content.name, callee->name, instance);
+
+            c->vars[c->varsCount] = q->tgt[i].content.name;
+            c->newVars[c->varsCount] = internName(ctx, name);
+            c->newIds[c->varsCount] = st_copy(ctx, s, c->newVars[c->varsCount], caller->name)->id;
+            c->varsCount++;
+        }
+    }
+}
+
+static void freeCopy(Copy *c) {
+    free(c->temps);
+    free(c->labels);
+    free(c->newLabels);
+    free(c->vars);
+    free(c->newVars);
+    free(c->newIds);
+}
+
+/*  expandCall() → Appends the body of "callee" to "out" in place of a call: the arguments ("args") are stored into its
+ *  parameters, its allocations go to "allocs" (the caller's frame, as an array parameter only holds an address it
+ *  becomes a scalar), returns jump to a fresh exit label and, when its value has a single producer and the call's
+ *  result is copied into "result", that producer writes "result" directly; returns whether it did  */
+static bool expandCall(CompilerContext *ctx, Function *caller, Function *callee, int instance, Address *args, int nargs, Address *result, QuadBuffer *out, QuadBuffer *allocs) {
+    QuadBuffer *q = &callee->body;
+    Address empty = { addrVoid, NO_SYMBOL };
+    Address scope = { addrString, NO_SYMBOL };
+    char *rf = internName(ctx, "r2");
+    int returns = 0, params = 0;
+    Copy c = { 0 };
+
+    scope.content.name = caller->name;
+    prepareCopy(ctx, caller, callee, instance, &c);
+
+    for (int i = 0; i < q->count; i++) {
+        if (q->op[i] == Move && q->tgt[i].type == addrString && q->tgt[i].content.name == rf) returns++;
+    }
+    if (returns != 1) result = NULL;
+
+    for (int i = 1; i < q->count - 1; i++) {
+        Address src = renameTemp(ctx, &c, q->src[i]), tgt = renameTemp(ctx, &c, q->tgt[i]), dst = renameTemp(ctx, &c, q->dst[i]);
+
+        switch (q->op[i]) {
+            case AllocVAR: case AllocARRAY:
+                tgt = renameVar(&c, tgt);
+                appendQuad(allocs, AllocVAR, scope, tgt, empty);
+
+                if (params < nargs) appendQuad(out, StoreVAR, args[params++], scope, tgt);
+                continue;
+            case LoadVAR:
+                src = scope;
+                tgt = renameVar(&c, tgt);
+                break;
+            case StoreVAR:
+                tgt = scope;
+                dst = renameVar(&c, dst);
+                break;
+            case LoadARRAY:
+                src = scope;
+                break;
+            case StoreARRAY:
+                tgt = scope;
+                break;
+            case Label: case Jump:
+                src = renameLabel(&c, src);
+                break;
+            case IFfalse:
+                tgt = renameLabel(&c, tgt);
+                break;
+            case Move:
+                if (result != NULL && tgt.type == addrString && tgt.content.name == rf) tgt = *result;
+                break;
+            default:
+                break;
+        }
+
+        appendQuad(out, q->op[i], src, tgt, dst);
+    }
+
+    freeCopy(&c);
+    return result != NULL;
+}
+
+/*--------------------------------------------/
+ *  Cost model
+ *---------------------------------*/
+
+/*  InlineSite → One call considered for inlining: where it is (its loop weight), what it calls and with how many
+ *  arguments  */
+typedef struct {
+    Function *callee;
+    int nargs;
+    long weight;
+} InlineSite;
+
+/*  expansionGrowth() → Words the call site grows by when the body (its allocations, statements and one store per
+ *  argument) replaces the call sequence  */
+static int expansionGrowth(CompilerContext *ctx, InlineSite *s) {
+    return (s->callee->words - frameWords(ctx, s->callee->name) + s->nargs) - (6 + s->nargs);
+}
+
+/*  inlineGrowth() → Words the program grows by when the call is inlined: minus the callee itself if this is its last call  */
+static int inlineGrowth(CompilerContext *ctx, InlineSite *s) {
+    int growth = expansionGrowth(ctx, s);
+
+    return (s->callee->sites == 1) ? growth - s->callee->words : growth;
+}
+
+/*  worthInlining() → Whether the call goes: always when it doesn't grow the program, otherwise when the callee is small,
+ *  the call sequence and frame it saves (times how often it runs) pay for the growth and the program still fits its
+ *  cluster  */
+static bool worthInlining(CompilerContext *ctx, Program *p, InlineSite *s) {
+    int growth = inlineGrowth(ctx, s);
+    long saved = s->weight * (6 + s->nargs + frameWords(ctx, s->callee->name));
+
+    if (growth <= 0) return true;
+
+    return s->callee->words <= INLINE_SIZE && saved >= growth && p->words + growth <= INLINE_WORDS;
+}
+
+/*  record() → Counts one more call of "callee" inlined into "caller", for the report  */
+static void record(CompilerContext *ctx, char *caller, char *callee) {
+    InlineRecord **r = &ctx->optStats.inlines;
+
+    while (*r != NULL && ((*r)->caller != caller || (*r)->callee != callee)) r = &(*r)->next;
+
+    if (*r == NULL) {
+        *r = arenaAlloc(&ctx->arena, sizeof(InlineRecord));
+        (*r)->caller = caller;
+        (*r)->callee = callee;
+    }
+    (*r)->sites++;
+}
+
+/*  dropCall() → Takes one call to f away; with none left f goes, and so do its own calls  */
+static void dropCall(CompilerContext *ctx, Program *p, Function *f) {
+    if (--f->sites > 0 || f->name == ctx->mainName) return;
+
+    f->removed = true;
+    p->words -= f->words;
+    ctx->optStats.functionsRemoved++;
+
+    for (int i = 0; i < f->body.count; i++) {
+        Function *callee = isUserCall(ctx, &f->body, i) ? functionOf(p, f->body.src[i].content.name) : NULL;
+
+        if (callee != NULL) dropCall(ctx, p, callee);
+    }
+}
+
+/*  inlineFunction() → Rebuilds the body of f with the calls worth it inlined; the Params of an inlined call are dropped
+ *  (their values are stored into the callee's parameters instead) and the callee's allocations join f's leading ones  */
+static void inlineFunction(CompilerContext *ctx, Program *p, Function *f) {
+    QuadBuffer *q = &f->body;
+    QuadBuffer out = { 0 }, allocs = { 0 }, body = { 0 };
+    long *weight = allocOrDie(q->count * sizeof(long));
+    int *pending = allocOrDie(q->count * sizeof(int));
+    int *params = allocOrDie(q->count * sizeof(int));
+    bool *dropped;
+    int pendingCount = 0, paramsCount = 0, prologue = 1;
+    char *rf = internName(ctx, "r2");
+
+    loopWeights(q, weight);
+
+    while (prologue < q->count && (q->op[prologue] == AllocVAR || q->op[prologue] == AllocARRAY)) prologue++;
+
+    for (int i = 0; i < q->count; i++) {
+        InlineSite site = { NULL, 0, weight[i] };
+
+        if (q->op[i] == Param) pending[pendingCount++] = out.count;
+
+        if (isUserCall(ctx, q, i)) {
+            site.callee = functionOf(p, q->src[i].content.name);
+            site.nargs = q->tgt[i].content.value;
+            pendingCount -= site.nargs;
+        }
+
+        if (site.callee == NULL || !site.callee->inlinable || site.callee == f || !worthInlining(ctx, p, &site)) {
+            appendQuad(&out, q->op[i], q->src[i], q->tgt[i], q->dst[i]);
+            continue;
+        }
+
+        /* The Params of this call are the last ones still pending   */
+        Address *args = allocOrDie((site.nargs + 1) * sizeof(Address));
+        Address *result = NULL;
+
+        for (int a = 0; a < site.nargs; a++) {
+            args[a] = out.src[pending[pendingCount + a]];
+            params[paramsCount++] = pending[pendingCount + a];
+        }
+
+        if (i + 1 < q->count && q->op[i + 1] == Move && q->src[i + 1].type == addrString && q->src[i + 1].content.name == rf) result = &q->tgt[i + 1];
+
+        p->words += expansionGrowth(ctx, &site);
+        ctx->optStats.inlined++;
+        ctx->optStats.overheadRemoved += 6 + site.nargs + frameWords(ctx, site.callee->name);
+        record(ctx, f->name, site.callee->name);
+
+        for (int k = 0; k < site.callee->body.count; k++) {
+            Function *nested = isUserCall(ctx, &site.callee->body, k) ? functionOf(p, site.callee->body.src[k].content.name) : NULL;
+
+            if (nested != NULL) nested->sites++;
+        }
+
+        if (expandCall(ctx, f, site.callee, ctx->optStats.inlined, args, site.nargs, result, &out, &allocs)) i++;
+
+        dropCall(ctx, p, site.callee);
+        free(args);
+    }
+
+    /* Take the Params of the inlined calls out, and put the callees' allocations after f's own   */
+    dropped = allocOrDie((out.count + 1) * sizeof(bool));
+    for (int n = 0; n < paramsCount; n++) dropped[params[n]] = true;
+
+    for (int i = 0; i < out.count; i++) {
+        if (i == prologue) {
+            for (int a = 0; a < allocs.count; a++) appendQuad(&body, allocs.op[a], allocs.src[a], allocs.tgt[a], allocs.dst[a]);
+        }
+        if (!dropped[i]) appendQuad(&body, out.op[i], out.src[i], out.tgt[i], out.dst[i]);
+    }
+
+    freeQuads(q);
+    freeQuads(&out);
+    freeQuads(&allocs);
+
+    *q = body;
+    f->words = bufferWords(ctx, q);
+
+    free(weight);
+    free(pending);
+    free(params);
+    free(dropped);
+}
+
+/*  inlineCalls() → Expands the calls to small, non recursive functions into their callers, callees first (so that what
+ *  they inline comes along), as far as the cost model allows; functions left without calls are dropped  */
+void inlineCalls(CompilerContext *ctx) {
+    QuadBuffer *q = &ctx->quadruples;
+    QuadBuffer out = { 0 };
+    Program p = { 0 };
+
+    collectFunctions(ctx, &p);
+    ctx->optStats.wordsBefore = p.words;
+
+    int *order = allocOrDie(p.count * sizeof(int));
+    bool *seen = allocOrDie(p.count * sizeof(bool));
+    int count = 0;
+
+    for (int f = 0; f < p.count; f++) {
+        if (!seen[f]) postorder(ctx, &p, &p.functions[f], seen, order, &count);
+    }
+
+    for (int n = 0; n < count; n++) {
+        if (!p.functions[order[n]].removed) inlineFunction(ctx, &p, &p.functions[order[n]]);
+    }
+
+    /* Put the list back together: what lies between functions (globals, End) stays, removed functions go   */
+    for (int i = 0, f = 0; i < q->count; i++) {
+        if (f < p.count && i == p.functions[f].first) {
+            QuadBuffer *body = &p.functions[f].body;
+
+            for (int k = 0; k < body->count && !p.functions[f].removed; k++) appendQuad(&out, body->op[k], body->src[k], body->tgt[k], body->dst[k]);
+
+            i = p.functions[f++].last;
+            continue;
+        }
+        appendQuad(&out, q->op[i], q->src[i], q->tgt[i], q->dst[i]);
+    }
+
+    freeQuads(q);
+    *q = out;
+
+    ctx->optStats.wordsAfter = bufferWords(ctx, q);
+
+    for (int f = 0; f < p.count; f++) freeQuads(&p.functions[f].body);
+    free(p.functions);
+    free(order);
+    free(seen);
+}
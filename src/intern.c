@@ -0,0 +1,74 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  String Interning for a C- Compiler
+ *  File: intern.c
+ *---------------------------------*/
+
+#include "intern.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*  hashString() → FNV-1a hash of a string  */
+static unsigned hashString(const char *s) {
+    unsigned h = 2166136261u;
+
+    for (; *s != '\0'; s++) {
+        h = (h ^ (unsigned char)*s) * 16777619u;
+    }
+    return h;
+}
+
+/*  growTable() → Doubles the table (kept at most 3/4 full) and reinserts every entry  */
+static void growTable(InternTable *table) {
+    int capacity = (table->capacity == 0) ? INTERN_INITIAL : table->capacity * 2;
+    InternEntry *entries = calloc(capacity, sizeof(InternEntry));
+
+    if (entries == NULL) {
+        printf("> Misc Error\n     Out of memory error. (Intern Table)\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (int i = 0; i < table->capacity; i++) {
+        if (table->entries[i].name == NULL) continue;
+
+        int j = table->entries[i].hash & (capacity - 1);
+        while (entries[j].name != NULL) j = (j + 1) & (capacity - 1);
+
+        entries[j] = table->entries[i];
+    }
+
+    free(table->entries);
+    table->entries = entries;
+    table->capacity = capacity;
+}
+
+/*  intern() → Returns the canonical copy of a string (kept in the arena), adding it on first sight  */
+char *intern(InternTable *table, Arena *arena, const char *s) {
+    if (4 * (table->count + 1) > 3 * table->capacity) growTable(table);
+
+    unsigned h = hashString(s);
+    int i = h & (table->capacity - 1);
+
+    while (table->entries[i].name != NULL) {
+        if (table->entries[i].hash == h && strcmp(table->entries[i].name, s) == 0) {
+            return table->entries[i].name;
+        }
+        i = (i + 1) & (table->capacity - 1);
+    }
+
+    table->entries[i].hash = h;
+    table->entries[i].name = arenaStrdup(arena, s);
+    table->count++;
+
+    return table->entries[i].name;
+}
+
+/*  internRelease() → Releases the table itself (the strings belong to the arena)  */
+void internRelease(InternTable *table) {
+    free(table->entries);
+
+    table->entries = NULL;
+    table->count = 0;
+    table->capacity = 0;
+}
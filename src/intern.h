@@ -0,0 +1,41 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  String Interning interface for a C- Compiler
+ *  File: intern.h
+ *---------------------------------*/
+
+#ifndef INTERN_H
+#define INTERN_H
+
+#include "arena.h"
+
+/*--------------------------------------------/
+ *  Intern Table structure
+ *---------------------------------*/
+
+#define INTERN_INITIAL 256
+
+/*  InternEntry → One canonical string and its hash  */
+typedef struct {
+    unsigned hash;
+    char *name;
+} InternEntry;
+
+/*  InternTable → Open addressed set holding one canonical copy of every identifier, scope, register and label name;
+ *  two interned names are equal if and only if their pointers are equal  */
+typedef struct {
+    InternEntry *entries;
+    int count;
+    int capacity;
+} InternTable;
+
+/*--------------------------------------------/
+ *  Intern Table functions
+ *---------------------------------*/
+
+/*  intern() → Returns the canonical copy of a string (kept in the arena), adding it on first sight  */
+char *intern(InternTable *table, Arena *arena, const char *s);
+
+/*  internRelease() → Releases the table itself (the strings belong to the arena)  */
+void internRelease(InternTable *table);
+
+#endif
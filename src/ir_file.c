@@ -0,0 +1,229 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Binary Intermediate Code file for a C- Compiler
+ *  File: ir_file.c
+ *---------------------------------*/
+
+#include "ir_file.h"
+#include "context.h"
+#include "utils.h"
+
+#include <stdint.h>
+
+/*  Bytes → Growable buffer a section of the file is put together in  */
+typedef struct {
+    unsigned char *data;
+    size_t size;
+    size_t capacity;
+} Bytes;
+
+/*  StringTable → Strings of the file in order of first use, without repeats (interned names share their pointer, the
+ *  other operands their text), found through an open addressed index  */
+typedef struct {
+    const char **strings;
+    unsigned *hashes;
+    int count;
+    int capacity;
+    int *slots;
+    int slotsCapacity;
+} StringTable;
+
+/*  FileSection → A function (FunBGN..FunEND) or a run of global declarations  */
+typedef struct {
+    uint32_t name;
+    uint32_t first;
+    uint32_t count;
+} FileSection;
+
+/*  reserve() → Makes room for "extra" more bytes  */
+static void reserve(Bytes *bytes, size_t extra) {
+    if (bytes->size + extra <= bytes->capacity) return;
+
+    size_t capacity = (bytes->capacity == 0) ? 4096 : bytes->capacity;
+    while (capacity < bytes->size + extra) capacity *= 2;
+
+    unsigned char *data = allocOrDie(capacity);
+    if (bytes->size > 0) memcpy(data, bytes->data, bytes->size);
+    free(bytes->data);
+
+    bytes->data = data;
+    bytes->capacity = capacity;
+}
+
+static void put8(Bytes *bytes, uint8_t value) {
+    reserve(bytes, 1);
+    bytes->data[bytes->size++] = value;
+}
+
+static void put16(Bytes *bytes, uint16_t value) {
+    put8(bytes, value & 0xFF);
+    put8(bytes, value >> 8);
+}
+
+static void put32(Bytes *bytes, uint32_t value) {
+    reserve(bytes, 4);
+    for (int i = 0; i < 4; i++) bytes->data[bytes->size++] = (value >> (8 * i)) & 0xFF;
+}
+
+static void putBytes(Bytes *bytes, const void *data, size_t size) {
+    reserve(bytes, size);
+    memcpy(bytes->data + bytes->size, data, size);
+    bytes->size += size;
+}
+
+/*  hashText() → FNV-1a hash of a string  */
+static unsigned hashText(const char *s) {
+    unsigned h = 2166136261u;
+
+    for (; *s != '\0'; s++) h = (h ^ (unsigned char)*s) * 16777619u;
+    return h;
+}
+
+/*  growStrings() → Doubles the index of the string table and places every string again  */
+static void growStrings(StringTable *table) {
+    int capacity = (table->slotsCapacity == 0) ? 256 : table->slotsCapacity * 2;
+    int *slots = allocOrDie(capacity * sizeof(int));
+
+    for (int i = 0; i < capacity; i++) slots[i] = -1;
+    for (int n = 0; n < table->count; n++) {
+        int i = table->hashes[n] & (capacity - 1);
+
+        while (slots[i] != -1) i = (i + 1) & (capacity - 1);
+        slots[i] = n;
+    }
+
+    free(table->slots);
+    table->slots = slots;
+    table->slotsCapacity = capacity;
+}
+
+/*  stringIndex() → Index of a string in the table, adding it on first sight  */
+static uint32_t stringIndex(StringTable *table, const char *s) {
+    if (2 * (table->count + 1) > table->slotsCapacity) growStrings(table);
+
+    unsigned h = hashText(s);
+    int i = h & (table->slotsCapacity - 1);
+
+    for (; table->slots[i] != -1; i = (i + 1) & (table->slotsCapacity - 1)) {
+        int n = table->slots[i];
+
+        if (table->strings[n] == s || (table->hashes[n] == h && strcmp(table->strings[n], s) == 0)) return n;
+    }
+
+    if (table->count == table->capacity) {
+        int capacity = (table->capacity == 0) ? 256 : table->capacity * 2;
+        const char **strings = allocOrDie(capacity * sizeof(char *));
+        unsigned *hashes = allocOrDie(capacity * sizeof(unsigned));
+
+        if (table->count > 0) {
+            memcpy(strings, table->strings, table->count * sizeof(char *));
+            memcpy(hashes, table->hashes, table->count * sizeof(unsigned));
+        }
+        free(table->strings);
+        free(table->hashes);
+
+        table->strings = strings;
+        table->hashes = hashes;
+        table->capacity = capacity;
+    }
+
+    table->strings[table->count] = s;
+    table->hashes[table->count] = h;
+    table->slots[i] = table->count;
+    return table->count++;
+}
+
+/*  addressValue() → The value of an operand: the constant, the string (its index) or the temporary number  */
+static int32_t addressValue(StringTable *strings, Address a) {
+    switch (a.type) {
+        case addrConst:  return a.content.value;
+        case addrString: return stringIndex(strings, a.content.name);
+        case addrTemp:   return a.content.value;
+        default:         return 0;
+    }
+}
+
+/*  writeIRFile() → Writes the Quadruples List of a context as a binary Intermediate Code file, in a single write  */
+void writeIRFile(CompilerContext *ctx, const char *path) {
+    QuadBuffer *quads = &ctx->quadruples;
+    StringTable strings = {0};
+    Bytes head = {0}, body = {0};
+    FileSection *sections = allocOrDie((quads->count + 1) * sizeof(FileSection));
+    int sectionsCount = 0;
+    bool inFunction = false, inGlobals = false;
+
+    uint32_t source = stringIndex(&strings, ctx->source);
+    uint32_t ops[End + 1];
+    for (int op = 0; op <= End; op++) ops[op] = stringIndex(&strings, opString[op]);
+
+    /*  Quads → encoded as they come, their strings taken into the table and their sections marked on the way  */
+    for (int i = 0; i < quads->count; i++) {
+        Operation op = quads->op[i];
+
+        if (op == FunBGN) {
+            sections[sectionsCount++] = (FileSection){ stringIndex(&strings, quads->src[i].content.name), i, 0 };
+            inFunction = true;
+            inGlobals = false;
+        } else if (!inFunction && !inGlobals) {
+            sections[sectionsCount++] = (FileSection){ stringIndex(&strings, ctx->globalScope), i, 0 };
+            inGlobals = true;
+        }
+        sections[sectionsCount - 1].count++;
+
+        if (op == FunEND) inFunction = false;
+
+        put8(&body, op);
+        put8(&body, quads->src[i].type);
+        put8(&body, quads->tgt[i].type);
+        put8(&body, quads->dst[i].type);
+        put32(&body, addressValue(&strings, quads->src[i]));
+        put32(&body, addressValue(&strings, quads->tgt[i]));
+        put32(&body, addressValue(&strings, quads->dst[i]));
+    }
+
+    /*  Header, ops, strings and sections → everything that comes before the quads  */
+    size_t stringBytes = 0;
+    for (int n = 0; n < strings.count; n++) stringBytes += strlen(strings.strings[n]);
+
+    putBytes(&head, IR_MAGIC, 4);
+    put16(&head, IR_VERSION);
+    put16(&head, IR_HEADER_SIZE);
+    put32(&head, source);
+    put32(&head, End + 1);
+    put32(&head, strings.count);
+    put32(&head, stringBytes);
+    put32(&head, sectionsCount);
+    put32(&head, quads->count);
+
+    for (int op = 0; op <= End; op++) put32(&head, ops[op]);
+
+    uint32_t offset = 0;
+    for (int n = 0; n < strings.count; n++) {
+        put32(&head, offset);
+        offset += strlen(strings.strings[n]);
+    }
+    put32(&head, offset);
+    for (int n = 0; n < strings.count; n++) putBytes(&head, strings.strings[n], strlen(strings.strings[n]));
+    while (head.size % 4 != 0) put8(&head, 0);
+
+    for (int s = 0; s < sectionsCount; s++) {
+        put32(&head, sections[s].name);
+        put32(&head, sections[s].first);
+        put32(&head, sections[s].count);
+    }
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        fprintf(ctx->listing, "> Misc Error\n     Could not create \"%s\".\n", path);
+    } else {
+        fwrite(head.data, 1, head.size, file);
+        if (body.size > 0) fwrite(body.data, 1, body.size, file);
+        fclose(file);
+    }
+
+    free(head.data);
+    free(body.data);
+    free(sections);
+    free(strings.strings);
+    free(strings.hashes);
+    free(strings.slots);
+}
@@ -0,0 +1,36 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Binary Intermediate Code file interface for a C- Compiler
+ *  File: ir_file.h
+ *---------------------------------*/
+
+#ifndef IR_FILE_H
+#define IR_FILE_H
+
+#include "globals.h"
+
+/*--------------------------------------------/
+ *  Binary Intermediate Code file layout (little endian, every section 4 byte aligned; read by ir_file.py)
+ *
+ *    Header     "CMIR", u16 version, u16 header size, u32 source (string), u32 ops, u32 strings, u32 string bytes,
+ *               u32 functions, u32 quadruples
+ *    Ops        u32 name (string) of each Operation, so that the readers do not depend on the enum order
+ *    Strings    u32 offset of each string (plus one past the last), then the bytes of all of them, not terminated
+ *    Functions  u32 name (string), u32 first quadruple, u32 quadruples: one section per FunBGN..FunEND, and one named
+ *               after the global scope per run of global declarations between them
+ *    Quads      16 bytes each: u8 op, u8 type of src, tgt and dst (AddrType), i32 src, tgt and dst (the constant, the
+ *               string or the temporary number; 0 when void)
+ *---------------------------------*/
+
+#define IR_MAGIC "CMIR"
+#define IR_VERSION 1
+#define IR_HEADER_SIZE 32
+#define IR_QUAD_SIZE 16
+
+/*--------------------------------------------/
+ *  Binary Intermediate Code file functions
+ *---------------------------------*/
+
+/*  writeIRFile() → Writes the Quadruples List of a context as a binary Intermediate Code file, in a single write  */
+void writeIRFile(CompilerContext *ctx, const char *path);
+
+#endif
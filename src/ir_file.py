@@ -0,0 +1,81 @@
+import mmap
+import struct
+import sys
+from dataclasses import dataclass
+from typing import List, Tuple
+
+# Layout of the binary intermediate code file written by the front end (see ir_file.h)
+magic = b"CMIR"
+version = 1
+header = struct.Struct("<4sHH6I")
+quadSize = 16
+
+# AddrType of an operand (mid_codegen.h)
+addrVoid, addrConst, addrString, addrTemp = range(4)
+
+@dataclass
+class Section:
+    name: str
+    first: int
+    count: int
+
+@dataclass
+class IRFile:
+    source: str
+    ops: List[str]
+    strings: List[str]
+    functions: List[Section]
+    quads: List[Tuple[int, int, int, int, int, int, int]]
+
+# isIRFile() → Whether a file starts with the magic of a binary intermediate code file (a text midcode.txt otherwise)
+def isIRFile(path: str) -> bool:
+    with open(path, 'rb') as file:
+        return file.read(len(magic)) == magic
+
+# readIRFile() → Maps a binary intermediate code file and decodes its tables; the quadruples come out as
+# (op, src type, tgt type, dst type, src, tgt, dst) tuples, straight from the mapped bytes
+def readIRFile(path: str) -> IRFile:
+    with open(path, 'rb') as file, mmap.mmap(file.fileno(), 0, access=mmap.ACCESS_READ) as data:
+        tag, fileVersion, size, source, opsCount, stringsCount, stringBytes, functionsCount, quadsCount = header.unpack_from(data, 0)
+        if (tag != magic or fileVersion != version):
+            raise ValueError(f"\"{path}\" is not a version {version} intermediate code file")
+
+        offset = size
+        ops = struct.unpack_from(f"<{opsCount}I", data, offset)
+        offset += 4 * opsCount
+
+        offsets = struct.unpack_from(f"<{stringsCount + 1}I", data, offset)
+        offset += 4 * (stringsCount + 1)
+        text = data[offset:offset + stringBytes].decode()
+        strings = [text[offsets[i]:offsets[i + 1]] for i in range(stringsCount)]
+        offset += (stringBytes + 3) & ~3
+
+        functions = [Section(strings[name], first, count)
+                     for name, first, count in struct.iter_unpack("<3I", data[offset:offset + 12 * functionsCount])]
+        offset += 12 * functionsCount
+
+        quads = list(struct.iter_unpack("<4B3i", data[offset:offset + quadSize * quadsCount]))
+
+    return IRFile(strings[source], [strings[op] for op in ops], strings, functions, quads)
+
+# operandText() → An operand as the text midcode spells it ("---" when void, "t<n>" for a temporary)
+def operandText(ir: IRFile, kind: int, value: int) -> str:
+    if (kind == addrConst):
+        return str(value)
+    if (kind == addrString):
+        return ir.strings[value]
+    if (kind == addrTemp):
+        return f"t{value}"
+    return "---"
+
+def main(argv: List[str]):
+    # Usage: ir_file.py [midcode.ir] → prints it as the text midcode (midcode.txt)
+    path = argv[0] if len(argv) > 0 else "outputs/midcode.ir"
+
+    ir = readIRFile(path)
+    print(ir.source)
+    for op, srcType, tgtType, dstType, src, tgt, dst in ir.quads:
+        print(f"{ir.ops[op]}|{operandText(ir, srcType, src)}|{operandText(ir, tgtType, tgt)}|{operandText(ir, dstType, dst)}")
+
+if __name__ == "__main__":
+    main(sys.argv[1:])
@@ -0,0 +1,414 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Loop Invariant Code Motion over the Quadruples List for a C- Compiler
+ *  File: licm.c
+ *---------------------------------*/
+
+#include "context.h"
+#include "utils.h"
+#include "optimizer.h"
+#include "cfg.h"
+
+/*--------------------------------------------/
+ *  Loops
+ *---------------------------------*/
+
+/*  Loop → Natural loop of a header: its blocks (every back edge source and what reaches it without going through the
+ *  header) and how many there are  */
+typedef struct {
+    int header;
+    bool *body;
+    int size;
+} Loop;
+
+/*  findLoop() → Natural loop of "header" (the union over its back edges), or size 0 if no back edge enters it  */
+static void findLoop(CFG *g, int header, Loop *loop, int *stack) {
+    int depth = 0;
+
+    loop->header = header;
+    loop->size = 0;
+    memset(loop->body, 0, g->count * sizeof(bool));
+
+    for (int p = 0; p < g->blocks[header].predsCount; p++) {
+        int pred = g->blocks[header].preds[p];
+
+        if (g->blocks[pred].order >= 0 && dominates(g, header, pred)) stack[depth++] = pred;
+    }
+    if (depth == 0) return;
+
+    loop->body[header] = true;
+    loop->size = 1;
+
+    while (depth > 0) {
+        int b = stack[--depth];
+
+        if (loop->body[b]) continue;
+
+        loop->body[b] = true;
+        loop->size++;
+
+        for (int p = 0; p < g->blocks[b].predsCount; p++) {
+            if (!loop->body[g->blocks[b].preds[p]]) stack[depth++] = g->blocks[b].preds[p];
+        }
+    }
+}
+
+/*  hasPreheader() → Whether the loop is entered only by falling into its header from the block right before it: the
+ *  hoisted quadruples then go between the two  */
+static bool hasPreheader(CFG *g, Loop *loop) {
+    BasicBlock *header = &g->blocks[loop->header];
+
+    for (int p = 0; p < header->predsCount; p++) {
+        int pred = header->preds[p];
+
+        if (loop->body[pred]) continue;
+        if (pred != loop->header - 1 || g->blocks[pred].succ[0] != loop->header || g->blocks[pred].succ[1] == loop->header) return false;
+    }
+    return loop->header > 0;
+}
+
+/*--------------------------------------------/
+ *  Invariants
+ *---------------------------------*/
+
+/*  Facts → What the loop being looked at writes: the variables it stores to (or allocates), whether it calls user
+ *  functions (which may write any global), the temporaries read by its Params, those found invariant and those it
+ *  reads from outside (each one holding a register through the whole loop)  */
+typedef struct {
+    char **stored;
+    int storedCount;
+    bool calls;
+
+    bool *isParam;
+    bool *invariant;
+    bool *liveIn;
+    int *defAt;
+} Facts;
+
+static bool isStored(Facts *f, char *name) {
+    for (int v = 0; v < f->storedCount; v++) {
+        if (f->stored[v] == name) return true;
+    }
+    return false;
+}
+
+/*  operandInvariant() → Constants, and temporaries written outside the loop or by an invariant quadruple  */
+static bool operandInvariant(CFG *g, Loop *loop, Facts *f, Address *a) {
+    if (a->type == addrConst) return true;
+    if (a->type != addrTemp) return false;
+
+    int t = a->content.value;
+
+    if (f->invariant[t]) return true;
+    return f->defAt[t] >= 0 && !(f->defAt[t] >= g->first && f->defAt[t] <= g->last && loop->body[g->blockOf[f->defAt[t] - g->first]]);
+}
+
+/*  isInvariant() → Whether quadruple i computes the same value on every iteration and may run before the loop: pure
+ *  arithmetic (divisions only by a non zero constant), Moves of invariants and loads of variables the loop does not
+ *  write; results only read by Params are left alone, as they must stay in a register up to their Call  */
+static bool isInvariant(CompilerContext *ctx, CFG *g, Loop *loop, Facts *f, int i) {
+    QuadBuffer *q = g->quads;
+    Operation op = q->op[i];
+
+    if (op >= Add && op <= SDT) {
+        if (q->dst[i].type != addrTemp || f->isParam[q->dst[i].content.value]) return false;
+        if (op == Div && (q->tgt[i].type != addrConst || q->tgt[i].content.value == 0)) return false;
+
+        return operandInvariant(g, loop, f, &q->src[i]) && operandInvariant(g, loop, f, &q->tgt[i]);
+    }
+
+    if (op == Move) {
+        if (q->tgt[i].type != addrTemp || f->isParam[q->tgt[i].content.value]) return false;
+
+        return operandInvariant(g, loop, f, &q->src[i]);
+    }
+
+    if (op == LoadVAR) {
+        int id = q->tgt[i].symbolId;
+
+        if (q->dst[i].type != addrTemp || f->isParam[q->dst[i].content.value] || id == NO_SYMBOL) return false;
+        if (isStored(f, q->tgt[i].content.name)) return false;
+
+        /* A call may write any global scalar (but never moves an array)   */
+        Symbol s = ctx->symbolTable.symbols[id];
+        bool isArray = s->treeNode != NULL && s->treeNode->flags.isArray;
+
+        return !(f->calls && s->scope == ctx->globalScope && !isArray);
+    }
+
+    return false;
+}
+
+/*  sameValue() → Whether two hoisted quadruples compute the same thing (the second may reuse the first's temporary)  */
+static bool sameValue(QuadBuffer *q, int a, int b) {
+    Address *x[2] = { &q->src[a], &q->tgt[a] }, *y[2] = { &q->src[b], &q->tgt[b] };
+
+    if (q->op[a] != q->op[b] || q->op[a] == Move) return false;
+
+    for (int n = 0; n < 2; n++) {
+        if (x[n]->type != y[n]->type) return false;
+        if (x[n]->type == addrString && x[n]->content.name != y[n]->content.name) return false;
+        if ((x[n]->type == addrConst || x[n]->type == addrTemp) && x[n]->content.value != y[n]->content.value) return false;
+    }
+    return true;
+}
+
+/*  renameUses() → Reads of merged temporaries go to the temporary they were merged into  */
+static void renameUses(QuadBuffer *q, int i, int *renamed) {
+    int roles = operandRoles(q->op[i]);
+    Address *uses[3] = { (roles & USE_SRC) ? &q->src[i] : NULL, (roles & USE_TGT) ? &q->tgt[i] : NULL, (roles & USE_DST) ? &q->dst[i] : NULL };
+
+    for (int n = 0; n < 3; n++) {
+        if (uses[n] != NULL && uses[n]->type == addrTemp && renamed[uses[n]->content.value] >= 0) {
+            uses[n]->content.value = renamed[uses[n]->content.value];
+        }
+    }
+}
+
+/*  definedBy() → Temporary written by a hoistable quadruple  */
+static int definedBy(QuadBuffer *q, int i) {
+    return (q->op[i] == Move) ? q->tgt[i].content.value : q->dst[i].content.value;
+}
+
+/*--------------------------------------------/
+ *  Motion
+ *---------------------------------*/
+
+/*  hoistLoop() → Moves the invariant quadruples of one loop, in order, right before its header label (merging the ones
+ *  computing the same value); returns how many left the loop  */
+static int hoistLoop(CompilerContext *ctx, CFG *g, Loop *loop, Facts *f, QuadBuffer *out, int *renamed) {
+    QuadBuffer *q = g->quads;
+    bool *hoisted = allocOrDie((g->last - g->first + 1) * sizeof(bool));
+    int *moved = allocOrDie((g->last - g->first + 1) * sizeof(int));
+    int movedCount = 0, live = 0, args = 0;
+    bool changed = true;
+
+    f->storedCount = 0;
+    f->calls = false;
+
+    for (int i = g->first; i <= g->last; i++) {
+        if (q->src[i].type == addrTemp) f->liveIn[q->src[i].content.value] = false;
+        if (q->tgt[i].type == addrTemp) f->liveIn[q->tgt[i].content.value] = false;
+        if (q->dst[i].type == addrTemp) f->liveIn[q->dst[i].content.value] = false;
+    }
+
+    for (int b = 0; b < g->count; b++) {
+        if (!loop->body[b]) continue;
+
+        for (int i = g->blocks[b].first; i <= g->blocks[b].last; i++) {
+            int roles = operandRoles(q->op[i]);
+            Address *uses[3] = { (roles & USE_SRC) ? &q->src[i] : NULL, (roles & USE_TGT) ? &q->tgt[i] : NULL, (roles & USE_DST) ? &q->dst[i] : NULL };
+
+            for (int n = 0; n < 3; n++) {
+                if (uses[n] == NULL || uses[n]->type != addrTemp || f->liveIn[uses[n]->content.value]) continue;
+                if (!operandInvariant(g, loop, f, uses[n])) continue;
+
+                f->liveIn[uses[n]->content.value] = true;
+                live++;
+            }
+
+            if (q->op[i] == StoreVAR) f->stored[f->storedCount++] = q->dst[i].content.name;
+            if (q->op[i] == AllocVAR || q->op[i] == AllocARRAY) f->stored[f->storedCount++] = q->tgt[i].content.name;
+            if (q->op[i] == Call && (q->src[i].symbolId == NO_SYMBOL || ctx->symbolTable.symbols[q->src[i].symbolId]->builtin == NotBuiltin)) f->calls = true;
+            if (q->op[i] == Call && q->tgt[i].content.value > args) args = q->tgt[i].content.value;
+        }
+    }
+
+    /* Invariance flows forward from the operands: repeat until no quadruple joins   */
+    while (changed) {
+        changed = false;
+
+        for (int i = g->first; i <= g->last; i++) {
+            if (!loop->body[g->blockOf[i - g->first]] || hoisted[i - g->first] || !isInvariant(ctx, g, loop, f, i)) continue;
+
+            /* Each new value hoisted holds one more register through the loop, next to the arguments of its widest call
+             * (kept in registers up to the Call): past the budget it would be spilled   */
+            bool duplicate = false;
+
+            for (int m = 0; m < movedCount && !duplicate; m++) duplicate = sameValue(q, moved[m], i);
+
+            if (!duplicate && live + args >= LICM_REGS) continue;
+            if (!duplicate) live++;
+
+            hoisted[i - g->first] = true;
+            f->invariant[definedBy(q, i)] = true;
+            moved[movedCount++] = i;
+            changed = true;
+        }
+    }
+
+    if (movedCount == 0) {
+        free(hoisted);
+        free(moved);
+        return 0;
+    }
+
+    /* Keep the program order among the hoisted quadruples (a definition before its uses)   */
+    for (int a = 1; a < movedCount; a++) {
+        int key = moved[a], b = a - 1;
+
+        while (b >= 0 && moved[b] > key) {
+            moved[b + 1] = moved[b];
+            b--;
+        }
+        moved[b + 1] = key;
+    }
+
+    int headerFirst = g->blocks[loop->header].first;
+
+    for (int i = g->first; i <= g->last; i++) {
+        if (i == headerFirst) {
+            for (int m = 0; m < movedCount; m++) {
+                int k = moved[m], same = -1;
+
+                renameUses(q, k, renamed);
+                for (int n = 0; n < m && same < 0; n++) {
+                    if (moved[n] >= 0 && sameValue(q, moved[n], k)) same = moved[n];
+                }
+
+                if (same >= 0) {
+                    renamed[definedBy(q, k)] = definedBy(q, same);
+                    moved[m] = -1;
+                    ctx->optStats.merged++;
+                    continue;
+                }
+                appendQuad(out, q->op[k], q->src[k], q->tgt[k], q->dst[k]);
+            }
+        }
+
+        if (!hoisted[i - g->first]) appendQuad(out, q->op[i], q->src[i], q->tgt[i], q->dst[i]);
+    }
+
+    free(hoisted);
+    free(moved);
+
+    ctx->optStats.loops++;
+    ctx->optStats.hoisted += movedCount;
+    return movedCount;
+}
+
+/*  hoistFunction() → Hoists out of the innermost loops of one function (a value hoisted out of an outer loop would hold
+ *  its register through the inner ones too, where the budget cannot see it), rebuilding its CFG after each loop that
+ *  changed; the function is rewritten in place, the slots its merged quadruples leave past its FunEND flagged in
+ *  "dead". Returns whether anything moved  */
+static bool hoistFunction(CompilerContext *ctx, QuadBuffer *q, int first, int last, Facts *f, int *renamed, bool *dead) {
+    CFG g;
+    Loop loop;
+    int *stack, *headers;
+    int moved = 0;
+
+    buildCFG(&g, q, first, last);
+    computeDominators(&g);
+
+    loop.body = allocOrDie(g.count * sizeof(bool));
+    stack = allocOrDie((g.count + g.count * 2) * sizeof(int));
+    headers = allocOrDie(g.count * sizeof(int));
+
+    /* Loops by size, smallest (innermost) first   */
+    int loopsCount = 0;
+    int *sizes = allocOrDie(g.count * sizeof(int));
+
+    for (int h = 0; h < g.count; h++) {
+        if (g.blocks[h].order < 0) continue;
+
+        findLoop(&g, h, &loop, stack);
+        if (loop.size == 0 || !hasPreheader(&g, &loop)) continue;
+
+        int n = loopsCount++;
+        while (n > 0 && sizes[n - 1] > loop.size) {
+            headers[n] = headers[n - 1];
+            sizes[n] = sizes[n - 1];
+            n--;
+        }
+        headers[n] = h;
+        sizes[n] = loop.size;
+    }
+
+    for (int l = 0; l < loopsCount && moved == 0; l++) {
+        QuadBuffer function = { 0 };
+
+        findLoop(&g, headers[l], &loop, stack);
+
+        /* Only innermost loops: one holding another's header is left as it is   */
+        bool outer = false;
+        for (int o = 0; o < loopsCount && !outer; o++) outer = (headers[o] != headers[l] && loop.body[headers[o]]);
+        if (outer) continue;
+
+        moved = hoistLoop(ctx, &g, &loop, f, &function, renamed);
+
+        if (moved > 0) {
+            /* Copy the rewritten function over the old one (never longer: quadruples only moved or merged away)   */
+            for (int i = 0; i < function.count; i++) {
+                renameUses(&function, i, renamed);
+
+                q->op[first + i] = function.op[i];
+                q->src[first + i] = function.src[i];
+                q->tgt[first + i] = function.tgt[i];
+                q->dst[first + i] = function.dst[i];
+            }
+            for (int i = first + function.count; i <= last; i++) dead[i] = true;
+        }
+        freeQuads(&function);
+    }
+
+    free(loop.body);
+    free(stack);
+    free(headers);
+    free(sizes);
+    freeCFG(&g);
+
+    return moved > 0;
+}
+
+/*  hoistInvariants() → Loop invariant code motion: finds the natural loops of every function (back edges to a dominating
+ *  header) and moves their invariant loads, address computations and arithmetic into a preheader  */
+void hoistInvariants(CompilerContext *ctx) {
+    QuadBuffer *q = &ctx->quadruples;
+    Facts f;
+    int *renamed = allocOrDie(ctx->tempsCounter * sizeof(int));
+    bool *dead = allocOrDie(q->count * sizeof(bool));
+    int first, last;
+
+    f.stored = allocOrDie(q->count * sizeof(char *));
+    f.isParam = allocOrDie(ctx->tempsCounter * sizeof(bool));
+    f.invariant = allocOrDie(ctx->tempsCounter * sizeof(bool));
+    f.liveIn = allocOrDie(ctx->tempsCounter * sizeof(bool));
+    f.defAt = allocOrDie(ctx->tempsCounter * sizeof(int));
+
+    for (int t = 0; t < ctx->tempsCounter; t++) renamed[t] = -1;
+
+    for (first = nextFunction(q, 0, &last); first >= 0; first = nextFunction(q, last + 1, &last)) {
+        do {
+            /* Merged quadruples are gone: the function may have shrunk (its FunEND moved up, the slots after it dead)   */
+            nextFunction(q, first, &last);
+
+            /* Only the temporaries of this function are looked at: reset just those   */
+            for (int i = first; i <= last; i++) {
+                Address *operands[3] = { &q->src[i], &q->tgt[i], &q->dst[i] };
+
+                for (int k = 0; k < 3; k++) {
+                    if (operands[k]->type != addrTemp) continue;
+
+                    f.defAt[operands[k]->content.value] = -1;
+                    f.isParam[operands[k]->content.value] = f.invariant[operands[k]->content.value] = false;
+                }
+            }
+
+            for (int i = first; i <= last; i++) {
+                int roles = operandRoles(q->op[i]);
+
+                if ((roles & DEF_DST) && q->dst[i].type == addrTemp) f.defAt[q->dst[i].content.value] = i;
+                if ((roles & DEF_TGT) && q->tgt[i].type == addrTemp) f.defAt[q->tgt[i].content.value] = i;
+                if (q->op[i] == Param && q->src[i].type == addrTemp) f.isParam[q->src[i].content.value] = true;
+            }
+        } while (hoistFunction(ctx, q, first, last, &f, renamed, dead));
+    }
+    removeQuads(q, dead);
+
+    free(renamed);
+    free(dead);
+    free(f.stored);
+    free(f.isParam);
+    free(f.invariant);
+    free(f.liveIn);
+    free(f.defAt);
+}
@@ -4,7 +4,9 @@
  *---------------------------------*/
 
 #include "globals.h"
+#include "context.h"
 #include "utils.h"
+#include "batch.h"
 
 /*--------------------------------------------/
  *  Allocate and Set → Global Significant Variables
@@ -12,26 +14,60 @@
 
  /* INPUT_DIR → Inputs folder name  */
  char *INPUT_DIR = "inputs";
+ /* OUTPUT_DIR → Outputs folder name  */
+ char *OUTPUT_DIR = "outputs";
+ /* BACKEND_DIR → Folder holding the Python back end stages  */
+ char *BACKEND_DIR = "src";
+ /* PYTHON → Python interpreter used to run the back end stages  */
+ char *PYTHON = "python3";
+ /* OPT_LEVEL → Optimization passes on (1) or off (0); batch flags -O1/-O0, CMINUS_OPT otherwise  */
+ int OPT_LEVEL = 1;
+ /* MIDCODE_TEXT → Also dump the Quadruples List as text (batch flag -m)  */
+ bool MIDCODE_TEXT = false;
 
-/*--------------------------------------------/
- *  Allocate and Set → Tracing Flags
- *---------------------------------*/
+int main(int argc, char *argv[]) {
+    /* Any argument → Non-interactive batch mode (see batch.h)   */
+    if (argc > 1) return batchCompile(argc - 1, argv + 1);
+
+    /* CMINUS_TRACE → Categories to trace into OUTPUT_DIR/trace.log (see trace.h), e.g. "scan,midcode" or "all"   */
+    const char *categories = getenv("CMINUS_TRACE");
+    if (categories != NULL && !parseTraceCategories(categories, &traceCategories)) {
+        printf("> Misc Error\n     Unknown trace category in \"%s\".\n", categories);
+        exit(EXIT_FAILURE);
+    }
+
+    /* CMINUS_OPT → Optimization level, 0 or 1 (the default)   */
+    const char *level = getenv("CMINUS_OPT");
+    if (level != NULL && *level != '\0') OPT_LEVEL = atoi(level);
+
+    CompilerContext *ctx = newContext();
 
- /* TraceScan → Trace Flex's scanner getToken() - yylex() - executions; and prints it out   */
- bool TraceScan = true;
- /* TraceParse → Trace Bison's parser Abstract Syntax Tree (AST); and prints it out   */
- bool TraceParse = true;
- /* TraceSemantic → Trace Semantic's Analyzer and it's Symbol Table; and prints it out   */
- bool TraceSemantic = true;
- /* TraceMidCode → Trace Intermediate "Mid" Code Generator and it's Quadruples List; and prints it out   */
- bool TraceMidCode = true;
-
-int main(void) {
-    inputSelect();
+    inputSelect(ctx);
+
+    char path[512];
+    snprintf(path, sizeof(path), "%s/trace.log", OUTPUT_DIR);
+    traceOpen(ctx, path);
  /* lexicalAnalysis(); ← Syntax Analysis includes it    */
-    syntaxAnalysis();
-    semanticAnalysis(abstractSyntaxTree);
-    printf("\n> End of analysis... → [%s]\n", source);
-    midCodeGenerate(abstractSyntaxTree);
-    return 0;
+    phaseBegin(ctx, "syntaxAnalysis");
+    syntaxAnalysis(ctx);
+    phaseEnd(ctx);
+    phaseBegin(ctx, "semanticAnalysis");
+    semanticAnalysis(ctx);
+    phaseEnd(ctx);
+    printf("\n> End of analysis... → [%s]\n", ctx->source);
+
+    /* A source with errors gets no code (and "make run" stops before the back end)   */
+    if (!ctx->failed) {
+        phaseBegin(ctx, "midCodeGenerate");
+        midCodeGenerate(ctx);
+        phaseEnd(ctx);
+    }
+    printMemoryReport(ctx);
+
+    snprintf(path, sizeof(path), "%s/report.json", OUTPUT_DIR);
+    writeMetrics(ctx, path);
+
+    bool failed = ctx->failed;
+    freeContext(ctx);
+    return failed ? EXIT_FAILURE : 0;
 }
\ No newline at end of file
@@ -0,0 +1,985 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Promotion of Scalar Variables into Temporaries (mem2reg) over the Quadruples List for a C- Compiler
+ *  File: mem2reg.c
+ *---------------------------------*/
+
+#include "context.h"
+#include "utils.h"
+#include "optimizer.h"
+#include "cfg.h"
+
+#include <stdint.h>
+
+#define BIT_SET(set, i) ((set)[(i) / 64] |= (uint64_t)1 << ((i) % 64))
+#define BIT_CLEAR(set, i) ((set)[(i) / 64] &= ~((uint64_t)1 << ((i) % 64)))
+#define BIT_TEST(set, i) (((set)[(i) / 64] >> ((i) % 64)) & 1)
+
+/*  Var → Scalar variable of the function being promoted (locals told apart by name, as the back end gives each name of a
+ *  function one frame slot), its symbol and what the function does with it  */
+typedef struct {
+    char *name;
+    int symbolId;
+    int global;
+    bool param, stored;
+} Var;
+
+/*  Web → Definitions of one variable and the reads they reach, closed under sharing a read: each web gets its own
+ *  temporary (-1 while it stays in memory), so a name reused by unrelated parts of a function holds a register only over
+ *  each of them. "weight" counts its loads and stores by loop depth, "cost" the memory accesses promoting it adds, and
+ *  [start, end] are the quadruples it is live over  */
+typedef struct {
+    int var;
+    long weight, cost;
+    int start, end;
+    int temp;
+} Web;
+
+/*  Summary → Global scalars a function (or anything it calls) may read ("refs") or write ("mods")  */
+typedef struct {
+    char *name;
+    bool *refs, *mods;
+} Summary;
+
+/*  Globals → Global scalars of the program (arrays are left in memory: their name stands for an address) and the
+ *  summary of every function  */
+typedef struct {
+    char **names;
+    int count;
+
+    Summary *functions;
+    int functionsCount;
+} Globals;
+
+/*  isUserCall() → Whether the quadruple calls a user function (predefined ones never touch the program's globals)  */
+static bool isUserCall(CompilerContext *ctx, QuadBuffer *q, int i) {
+    if (q->op[i] != Call) return false;
+    if (q->src[i].symbolId == NO_SYMBOL) return true;
+
+    return ctx->symbolTable.symbols[q->src[i].symbolId]->builtin == NotBuiltin;
+}
+
+/*  globalOf() → Index of the global scalar a LoadVAR/StoreVAR variable names, -1 for a local, -2 for a global array  */
+static int globalOf(CompilerContext *ctx, Globals *g, Address *var) {
+    if (var->symbolId == NO_SYMBOL || ctx->symbolTable.symbols[var->symbolId]->scope != ctx->globalScope) return -1;
+
+    for (int n = 0; n < g->count; n++) {
+        if (g->names[n] == var->content.name) return n;
+    }
+    return -2;
+}
+
+/*  summaryOf() → Summary of the function called "name" (NULL when unknown: it may then touch any global)  */
+static Summary *summaryOf(Globals *g, char *name) {
+    for (int f = 0; f < g->functionsCount; f++) {
+        if (g->functions[f].name == name) return &g->functions[f];
+    }
+    return NULL;
+}
+
+/*--------------------------------------------/
+ *  Globals read and written by each function
+ *---------------------------------*/
+
+/*  summarize() → Direct reads and writes of the global scalars in every function, then what their callees touch, until
+ *  nothing changes (recursion included)  */
+static void summarize(CompilerContext *ctx, QuadBuffer *q, Globals *g) {
+    int first, last, count = 0;
+    bool changed = true;
+
+    for (int i = 0; i < q->count; i++) {
+        if (q->op[i] == FunBGN) count++;
+        if (q->op[i] == AllocVAR && q->tgt[i].symbolId != NO_SYMBOL && ctx->symbolTable.symbols[q->tgt[i].symbolId]->scope == ctx->globalScope) count++;
+    }
+
+    g->names = allocOrDie(count * sizeof(char *));
+    g->functions = allocOrDie(count * sizeof(Summary));
+
+    for (int i = 0; i < q->count; i++) {
+        if (q->op[i] == AllocVAR && q->tgt[i].symbolId != NO_SYMBOL && ctx->symbolTable.symbols[q->tgt[i].symbolId]->scope == ctx->globalScope) {
+            g->names[g->count++] = q->tgt[i].content.name;
+        }
+    }
+
+    for (first = nextFunction(q, 0, &last); first >= 0; first = nextFunction(q, last + 1, &last)) {
+        Summary *s = &g->functions[g->functionsCount++];
+
+        s->name = q->src[first].content.name;
+        s->refs = allocOrDie(g->count * sizeof(bool));
+        s->mods = allocOrDie(g->count * sizeof(bool));
+
+        for (int i = first; i <= last; i++) {
+            int n = (q->op[i] == LoadVAR) ? globalOf(ctx, g, &q->tgt[i]) : (q->op[i] == StoreVAR) ? globalOf(ctx, g, &q->dst[i]) : -1;
+
+            if (n >= 0 && q->op[i] == LoadVAR) s->refs[n] = true;
+            if (n >= 0 && q->op[i] == StoreVAR) s->mods[n] = true;
+        }
+    }
+
+    while (changed) {
+        changed = false;
+
+        for (first = nextFunction(q, 0, &last); first >= 0; first = nextFunction(q, last + 1, &last)) {
+            Summary *s = summaryOf(g, q->src[first].content.name);
+
+            for (int i = first; i <= last; i++) {
+                if (!isUserCall(ctx, q, i)) continue;
+
+                Summary *callee = summaryOf(g, q->src[i].content.name);
+
+                for (int n = 0; n < g->count; n++) {
+                    bool refs = (callee == NULL) || callee->refs[n], mods = (callee == NULL) || callee->mods[n];
+
+                    if ((refs && !s->refs[n]) || (mods && !s->mods[n])) changed = true;
+
+                    s->refs[n] |= refs;
+                    s->mods[n] |= mods;
+                }
+            }
+        }
+    }
+}
+
+/*--------------------------------------------/
+ *  Variables of a function
+ *---------------------------------*/
+
+/*  loopWeights() → 10^depth of every quadruple of [first, last], depth being how many while loops (a label some later
+ *  jump goes back to) enclose it  */
+static void loopWeights(QuadBuffer *q, int first, int last, long *weight) {
+    int size = last - first + 1;
+    int *depth = allocOrDie((size + 1) * sizeof(int));
+
+    for (int j = first; j <= last; j++) {
+        char *name;
+
+        if (q->op[j] == Jump) name = q->src[j].content.name;
+        else if (q->op[j] == IFfalse) name = q->tgt[j].content.name;
+        else continue;
+
+        for (int l = first; l < j; l++) {
+            if (q->op[l] != Label || q->src[l].content.name != name) continue;
+
+            depth[l - first]++;
+            depth[j - first + 1]--;
+        }
+    }
+
+    for (int i = 0, d = 0; i < size; i++) {
+        d += depth[i];
+
+        weight[i] = 1;
+        for (int k = 0; k < d && k < 4; k++) weight[i] *= 10;
+    }
+
+    free(depth);
+}
+
+/*  touches() → Whether the user call at quadruple i may read or write the global scalar "var" (a tail call takes the
+ *  place of FunEND: every written global goes back to memory before it)  */
+static bool touches(Globals *g, QuadBuffer *q, int i, Var *var) {
+    Summary *callee = summaryOf(g, q->src[i].content.name);
+
+    if (var->global < 0) return false;
+    return isTailCall(q, i) || callee == NULL || callee->refs[var->global] || callee->mods[var->global];
+}
+
+/*  collectVars() → Scalars the function [first, last] reads or writes (its arrays, local or global, stay in memory)  */
+static int collectVars(CompilerContext *ctx, QuadBuffer *q, Globals *g, int first, int last, Var *vars) {
+    int count = 0;
+
+    for (int i = first; i <= last; i++) {
+        Address *var = (q->op[i] == LoadVAR) ? &q->tgt[i] : (q->op[i] == StoreVAR) ? &q->dst[i] : NULL;
+        int v, global;
+
+        if (var == NULL || var->symbolId == NO_SYMBOL || (global = globalOf(ctx, g, var)) == -2) continue;
+
+        for (v = 0; v < count && vars[v].name != var->content.name; v++);
+
+        if (v == count) {
+            TreeNode *decl = ctx->symbolTable.symbols[var->symbolId]->treeNode;
+
+            vars[v].name = var->content.name;
+            vars[v].symbolId = var->symbolId;
+            vars[v].global = global;
+            vars[v].param = decl != NULL && decl->nodekind == NodeDeclaration && decl->kind.decl == DeclParameter;
+            vars[v].stored = false;
+            count++;
+        }
+
+        if (q->op[i] == StoreVAR) vars[v].stored = true;
+    }
+
+    /* Local arrays (and array parameters) keep their name in memory too   */
+    for (int i = first; i <= last; i++) {
+        if (q->op[i] != AllocARRAY) continue;
+
+        for (int v = 0; v < count; v++) {
+            if (vars[v].name == q->tgt[i].content.name) vars[v--] = vars[--count];
+        }
+    }
+
+    return count;
+}
+
+/*  varAt() → Variable a LoadVAR/StoreVAR accesses, or -1  */
+static int varAt(QuadBuffer *q, int i, Var *vars, int count) {
+    Address *var = (q->op[i] == LoadVAR) ? &q->tgt[i] : (q->op[i] == StoreVAR) ? &q->dst[i] : NULL;
+
+    for (int v = 0; var != NULL && v < count; v++) {
+        if (vars[v].name == var->content.name) return v;
+    }
+    return -1;
+}
+
+/*--------------------------------------------/
+ *  Memory traffic of the promoted variables
+ *---------------------------------*/
+
+/*  Plan → Where the variables of a function meet their memory slots, as if all were promoted (they don't depend on each
+ *  other): loaded at the entry, written back before a user call and reloaded after it, written back at the exit (bitsets
+ *  over the variables, per quadruple for the calls). A value needed after a call is reloaded rather than kept in its
+ *  register (a Push/Pop pair costs four instructions, a reload one), and written back first only when it may have
+ *  changed since it was last loaded or written ("dirty"). Then the webs, and the web of each access  */
+typedef struct {
+    CFG cfg;
+    int words;
+    uint64_t *live;
+    uint64_t *writeBack, *reload;
+    uint64_t *entryLoad, *exitStore;
+
+    Web *webs;
+    int websCount;
+    int *accessWeb;
+    int *writeBackWeb, *reloadWeb;
+    int *entryWeb, *exitWeb;
+} Plan;
+
+/*  readsAt() → Adds to "set" the variables quadruple i reads: LoadVARs, and the written globals a user call may touch
+ *  (their write back) or FunEND stores  */
+static void readsAt(CompilerContext *ctx, Globals *g, QuadBuffer *q, int i, Var *vars, int count, uint64_t *set) {
+    int v = varAt(q, i, vars, count);
+
+    if (q->op[i] == LoadVAR && v >= 0) BIT_SET(set, v);
+
+    for (v = 0; v < count && (q->op[i] == FunEND || isUserCall(ctx, q, i)); v++) {
+        if (vars[v].global < 0 || !vars[v].stored) continue;
+        if (q->op[i] == FunEND || touches(g, q, i, &vars[v])) BIT_SET(set, v);
+    }
+}
+
+/*  liveOut() → Variables live at the end of block b (those live in at its successors)  */
+static void liveOut(Plan *p, int b, uint64_t *out) {
+    memset(out, 0, p->words * sizeof(uint64_t));
+
+    for (int s = 0; s < 2; s++) {
+        if (p->cfg.blocks[b].succ[s] < 0) continue;
+
+        for (int w = 0; w < p->words; w++) out[w] |= p->live[(3 * (size_t)p->cfg.blocks[b].succ[s] + 2) * p->words + w];
+    }
+}
+
+/*  planTraffic() → Liveness of the variables over the CFG of [first, last] (which are needed at the entry and after each
+ *  call), then which may be dirty at each call and at FunEND, forward until nothing changes  */
+static void planTraffic(CompilerContext *ctx, Globals *g, QuadBuffer *q, int first, int last, Var *vars, int count, Plan *p) {
+    int words = p->words = (count + 63) / 64, size = last - first + 1;
+    uint64_t *liveAfter = allocOrDie((size_t)size * words * sizeof(uint64_t));
+    uint64_t *live = allocOrDie(words * sizeof(uint64_t));
+    bool changed = true;
+
+    buildCFG(&p->cfg, q, first, last);
+
+    p->live = allocOrDie(3 * (size_t)p->cfg.count * words * sizeof(uint64_t));
+    p->writeBack = allocOrDie((size_t)size * words * sizeof(uint64_t));
+    p->reload = allocOrDie((size_t)size * words * sizeof(uint64_t));
+    p->entryLoad = allocOrDie(words * sizeof(uint64_t));
+    p->exitStore = allocOrDie(words * sizeof(uint64_t));
+
+    /* use (read before written) and def of each block, then in = use ∪ (out − def) until nothing changes   */
+    for (int b = 0; b < p->cfg.count; b++) {
+        uint64_t *use = p->live + (3 * (size_t)b) * words, *def = use + words;
+
+        for (int i = p->cfg.blocks[b].first; i <= p->cfg.blocks[b].last; i++) {
+            int v = varAt(q, i, vars, count);
+
+            memset(live, 0, words * sizeof(uint64_t));
+            readsAt(ctx, g, q, i, vars, count, live);
+
+            for (int w = 0; w < words; w++) use[w] |= live[w] & ~def[w];
+            if (q->op[i] == StoreVAR && v >= 0) BIT_SET(def, v);
+        }
+    }
+
+    while (changed) {
+        changed = false;
+
+        for (int b = p->cfg.count - 1; b >= 0; b--) {
+            uint64_t *use = p->live + (3 * (size_t)b) * words, *def = use + words, *in = def + words;
+
+            liveOut(p, b, live);
+
+            for (int w = 0; w < words; w++) {
+                uint64_t value = use[w] | (live[w] & ~def[w]);
+
+                if (value != in[w]) {
+                    in[w] = value;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    /* Parameters and globals live at the entry are loaded there   */
+    for (int v = 0; v < count; v++) {
+        if ((vars[v].param || vars[v].global >= 0) && BIT_TEST(p->live + 2 * words, v)) BIT_SET(p->entryLoad, v);
+    }
+
+    /* Walk each block backwards from its live out, keeping what is live right after each call   */
+    for (int b = 0; b < p->cfg.count; b++) {
+        liveOut(p, b, live);
+
+        for (int i = p->cfg.blocks[b].last; i >= p->cfg.blocks[b].first; i--) {
+            int v = varAt(q, i, vars, count);
+
+            if (isUserCall(ctx, q, i)) memcpy(liveAfter + (size_t)(i - first) * words, live, words * sizeof(uint64_t));
+
+            if (q->op[i] == StoreVAR && v >= 0) BIT_CLEAR(live, v);
+            readsAt(ctx, g, q, i, vars, count, live);
+        }
+    }
+
+    /* Dirty values: set by a store, cleared by a write back or a reload (the out of each block reuses its "use" set)   */
+    for (int b = 0; b < p->cfg.count; b++) memset(p->live + (3 * (size_t)b) * words, 0, words * sizeof(uint64_t));
+
+    changed = true;
+    while (changed) {
+        changed = false;
+
+        for (int n = 0; n < p->cfg.rpoCount; n++) {
+            BasicBlock *block = &p->cfg.blocks[p->cfg.rpo[n]];
+            uint64_t *out = p->live + (3 * (size_t)p->cfg.rpo[n]) * words;
+
+            memset(live, 0, words * sizeof(uint64_t));
+            for (int k = 0; k < block->predsCount; k++) {
+                for (int w = 0; w < words; w++) live[w] |= p->live[(3 * (size_t)block->preds[k]) * words + w];
+            }
+
+            for (int i = block->first; i <= block->last; i++) {
+                int v = varAt(q, i, vars, count);
+                uint64_t *after = liveAfter + (size_t)(i - first) * words;
+                uint64_t *writeBack = p->writeBack + (size_t)(i - first) * words, *reload = p->reload + (size_t)(i - first) * words;
+
+                if (q->op[i] == StoreVAR && v >= 0) BIT_SET(live, v);
+                if (q->op[i] == FunEND) memcpy(p->exitStore, live, words * sizeof(uint64_t));
+
+                if (!isUserCall(ctx, q, i)) continue;
+
+                for (v = 0; v < count; v++) {
+                    bool dirty = BIT_TEST(live, v), needed = BIT_TEST(after, v);
+
+                    BIT_CLEAR(writeBack, v);
+                    BIT_CLEAR(reload, v);
+
+                    if (dirty && (needed || touches(g, q, i, &vars[v]))) BIT_SET(writeBack, v);
+                    if (needed) BIT_SET(reload, v);
+                    if (needed || BIT_TEST(writeBack, v)) BIT_CLEAR(live, v);
+                }
+            }
+
+            for (int w = 0; w < words; w++) {
+                if (live[w] != out[w]) changed = true;
+                out[w] = live[w];
+            }
+        }
+    }
+
+    /* Only globals outlive the function   */
+    for (int v = 0; v < count; v++) {
+        if (vars[v].global < 0) BIT_CLEAR(p->exitStore, v);
+    }
+
+    free(live);
+    free(liveAfter);
+}
+
+/*--------------------------------------------/
+ *  Webs
+ *---------------------------------*/
+
+/*  Sites → Definitions of the variables of a function, grouped by variable (those of v are [first[v], first[v + 1]),
+ *  the first one being its value at the entry), and the union-find forest joining them into webs  */
+typedef struct {
+    int *first;
+    int *parent;
+    int count, words;
+} Sites;
+
+static int findSite(Sites *s, int site) {
+    while (s->parent[site] != site) site = s->parent[site] = s->parent[s->parent[site]];
+    return site;
+}
+
+/*  joinReaching() → Joins into one web the definitions of v in "reaching" (they all reach the same read); returns one
+ *  of them (the entry value if none does)  */
+static int joinReaching(Sites *s, uint64_t *reaching, int v) {
+    int found = -1;
+
+    for (int site = s->first[v]; site < s->first[v + 1]; site++) {
+        if (!BIT_TEST(reaching, site)) continue;
+
+        if (found < 0) found = site;
+        else s->parent[findSite(s, site)] = findSite(s, found);
+    }
+
+    return (found < 0) ? s->first[v] : found;
+}
+
+/*  define() → Definition "site" of v replaces the ones of v in "reaching"  */
+static void define(Sites *s, uint64_t *reaching, int v, int site) {
+    for (int n = s->first[v]; n < s->first[v + 1]; n++) BIT_CLEAR(reaching, n);
+    BIT_SET(reaching, site);
+}
+
+/*  walkBlock() → Walks block b forward from the definitions reaching its start; with "reads", also joins the webs at
+ *  each read and records there the definition it reads (loads in the last slot, write backs and exit stores in the
+ *  slot of their variable)  */
+static void walkBlock(CompilerContext *ctx, QuadBuffer *q, Plan *p, Sites *s, int count, int b, uint64_t *reaching, int *storeSite, int *reloadSite, int *reads) {
+    BasicBlock *block = &p->cfg.blocks[b];
+    int first = p->cfg.first;
+
+    for (int i = block->first; i <= block->last; i++) {
+        int *at = (reads != NULL) ? reads + (size_t)(i - first) * (count + 1) : NULL;
+
+        if (q->op[i] == LoadVAR && storeSite[i - first] >= 0 && at != NULL) at[count] = joinReaching(s, reaching, storeSite[i - first]);
+        if (q->op[i] == StoreVAR && storeSite[i - first] >= 0) {
+            int v = 0;
+
+            while (s->first[v + 1] <= storeSite[i - first]) v++;
+            define(s, reaching, v, storeSite[i - first]);
+        }
+
+        for (int v = 0; v < count && at != NULL && q->op[i] == FunEND; v++) {
+            if (BIT_TEST(p->exitStore, v)) at[v] = joinReaching(s, reaching, v);
+        }
+
+        if (!isUserCall(ctx, q, i)) continue;
+
+        for (int v = 0; v < count; v++) {
+            if (at != NULL && BIT_TEST(p->writeBack + (size_t)(i - first) * p->words, v)) at[v] = joinReaching(s, reaching, v);
+            if (BIT_TEST(p->reload + (size_t)(i - first) * p->words, v)) define(s, reaching, v, reloadSite[(size_t)(i - first) * count + v]);
+        }
+    }
+}
+
+static void extendWeb(Web *web, int i) {
+    if (i < web->start) web->start = i;
+    if (i > web->end) web->end = i;
+}
+
+/*  extendReaching() → Extends to quadruple i the webs of the definitions of v in "reaching"  */
+static void extendReaching(Plan *p, Sites *s, int *webOf, uint64_t *reaching, int v, int i) {
+    for (int site = s->first[v]; site < s->first[v + 1]; site++) {
+        if (BIT_TEST(reaching, site)) extendWeb(&p->webs[webOf[findSite(s, site)]], i);
+    }
+}
+
+/*  buildWebs() → Numbers the definitions of every variable (its entry value, stores and reloads), finds which reach each
+ *  read (loads, write backs and exit stores) forward over the CFG, and joins those sharing a read into webs; then weighs
+ *  each web and finds the quadruples it is live over  */
+static void buildWebs(CompilerContext *ctx, QuadBuffer *q, int first, int last, Var *vars, int count, long *weight, Plan *p) {
+    int size = last - first + 1, stride = count + 1;
+    int *storeSite = allocOrDie(size * sizeof(int));
+    int *reloadSite = allocOrDie((size_t)size * count * sizeof(int));
+    int *reads = allocOrDie((size_t)size * stride * sizeof(int));
+    int *cursor = allocOrDie((count + 1) * sizeof(int));
+    Sites s = { 0 };
+
+    /* Definitions, grouped by variable (a load keeps its variable in "storeSite" until the sites are read)   */
+    s.first = allocOrDie((count + 1) * sizeof(int));
+
+    for (int v = 0; v < count; v++) cursor[v] = 1;
+    for (int i = first; i <= last; i++) {
+        int v = varAt(q, i, vars, count);
+
+        if (q->op[i] == StoreVAR && v >= 0) cursor[v]++;
+
+        for (v = 0; v < count && isUserCall(ctx, q, i); v++) {
+            if (BIT_TEST(p->reload + (size_t)(i - first) * p->words, v)) cursor[v]++;
+        }
+    }
+    for (int v = 0; v < count; v++) {
+        s.first[v + 1] = s.first[v] + cursor[v];
+        cursor[v] = s.first[v] + 1;
+    }
+
+    s.count = s.first[count];
+    s.words = (s.count + 63) / 64;
+    s.parent = allocOrDie(s.count * sizeof(int));
+
+    for (int n = 0; n < s.count; n++) s.parent[n] = n;
+
+    for (int i = first; i <= last; i++) {
+        int v = varAt(q, i, vars, count);
+
+        for (int k = 0; k < stride; k++) reads[(size_t)(i - first) * stride + k] = -1;
+
+        storeSite[i - first] = -1;
+        if (q->op[i] == StoreVAR && v >= 0) storeSite[i - first] = cursor[v]++;
+        if (q->op[i] == LoadVAR && v >= 0) storeSite[i - first] = v;
+
+        for (v = 0; v < count && isUserCall(ctx, q, i); v++) {
+            if (BIT_TEST(p->reload + (size_t)(i - first) * p->words, v)) reloadSite[(size_t)(i - first) * count + v] = cursor[v]++;
+        }
+    }
+
+    /* Reaching definitions: in = ∪ out(predecessors), the entry values at the entry, until nothing changes   */
+    uint64_t *reach = allocOrDie(2 * (size_t)p->cfg.count * s.words * sizeof(uint64_t));
+    uint64_t *reaching = allocOrDie(s.words * sizeof(uint64_t));
+    bool changed = true;
+
+    for (int v = 0; v < count; v++) BIT_SET(reach, s.first[v]);
+
+    while (changed) {
+        changed = false;
+
+        for (int n = 0; n < p->cfg.rpoCount; n++) {
+            int b = p->cfg.rpo[n];
+            uint64_t *in = reach + (2 * (size_t)b) * s.words, *out = in + s.words;
+
+            for (int k = 0; k < p->cfg.blocks[b].predsCount; k++) {
+                uint64_t *predOut = reach + (2 * (size_t)p->cfg.blocks[b].preds[k] + 1) * s.words;
+
+                for (int w = 0; w < s.words; w++) in[w] |= predOut[w];
+            }
+
+            memcpy(reaching, in, s.words * sizeof(uint64_t));
+            walkBlock(ctx, q, p, &s, count, b, reaching, storeSite, reloadSite, NULL);
+
+            for (int w = 0; w < s.words; w++) {
+                if (reaching[w] != out[w]) changed = true;
+                out[w] = reaching[w];
+            }
+        }
+    }
+
+    for (int n = 0; n < p->cfg.rpoCount; n++) {
+        int b = p->cfg.rpo[n];
+
+        memcpy(reaching, reach + (2 * (size_t)b) * s.words, s.words * sizeof(uint64_t));
+        walkBlock(ctx, q, p, &s, count, b, reaching, storeSite, reloadSite, reads);
+    }
+
+    /* One web per root   */
+    int *webOf = allocOrDie(s.count * sizeof(int));
+
+    p->webs = allocOrDie(s.count * sizeof(Web));
+
+    for (int v = 0; v < count; v++) {
+        for (int n = s.first[v]; n < s.first[v + 1]; n++) {
+            if (findSite(&s, n) == n) p->webs[webOf[n] = p->websCount++] = (Web){ v, 0, 0, last, first, -1 };
+        }
+    }
+
+    /* Web of each access, what it weighs and what it costs   */
+    p->accessWeb = allocOrDie(size * sizeof(int));
+    p->writeBackWeb = allocOrDie((size_t)size * count * sizeof(int));
+    p->reloadWeb = allocOrDie((size_t)size * count * sizeof(int));
+    p->entryWeb = allocOrDie(count * sizeof(int));
+    p->exitWeb = allocOrDie(count * sizeof(int));
+
+    for (int v = 0; v < count; v++) {
+        p->entryWeb[v] = webOf[findSite(&s, s.first[v])];
+        p->exitWeb[v] = -1;
+
+        if (BIT_TEST(p->entryLoad, v)) {
+            p->webs[p->entryWeb[v]].cost++;
+            extendWeb(&p->webs[p->entryWeb[v]], first);
+        }
+    }
+
+    for (int i = first; i <= last; i++) {
+        int *at = reads + (size_t)(i - first) * stride;
+        int site = (q->op[i] == StoreVAR) ? storeSite[i - first] : (q->op[i] == LoadVAR) ? at[count] : -1;
+
+        p->accessWeb[i - first] = (site >= 0) ? webOf[findSite(&s, site)] : -1;
+
+        if (site >= 0) {
+            p->webs[p->accessWeb[i - first]].weight += weight[i - first];
+            extendWeb(&p->webs[p->accessWeb[i - first]], i);
+        }
+
+        for (int v = 0; v < count; v++) {
+            int *writeBack = &p->writeBackWeb[(size_t)(i - first) * count + v], *reload = &p->reloadWeb[(size_t)(i - first) * count + v];
+
+            *writeBack = *reload = -1;
+
+            if (at[v] >= 0) {
+                int n = webOf[findSite(&s, at[v])];
+
+                if (q->op[i] == FunEND) p->exitWeb[v] = n;
+                else *writeBack = n;
+
+                p->webs[n].cost += weight[i - first];
+                extendWeb(&p->webs[n], i);
+            }
+
+            if (isUserCall(ctx, q, i) && BIT_TEST(p->reload + (size_t)(i - first) * p->words, v)) {
+                *reload = webOf[findSite(&s, reloadSite[(size_t)(i - first) * count + v])];
+
+                p->webs[*reload].cost += weight[i - first];
+                extendWeb(&p->webs[*reload], i);
+            }
+        }
+    }
+
+    /* A web is live over the block boundaries its variable is live at and its definitions reach   */
+    uint64_t *live = allocOrDie(p->words * sizeof(uint64_t));
+
+    for (int n = 0; n < p->cfg.rpoCount; n++) {
+        int b = p->cfg.rpo[n];
+        uint64_t *in = reach + (2 * (size_t)b) * s.words, *out = in + s.words;
+
+        liveOut(p, b, live);
+
+        for (int v = 0; v < count; v++) {
+            if (BIT_TEST(p->live + (3 * (size_t)b + 2) * p->words, v)) extendReaching(p, &s, webOf, in, v, p->cfg.blocks[b].first);
+            if (BIT_TEST(live, v)) extendReaching(p, &s, webOf, out, v, p->cfg.blocks[b].last);
+        }
+    }
+
+    free(live);
+    free(webOf);
+    free(reach);
+    free(reaching);
+    free(storeSite);
+    free(reloadSite);
+    free(reads);
+    free(cursor);
+    free(s.first);
+    free(s.parent);
+}
+
+/*  selectWebs() → Promotes the webs worth it (their accesses outweigh the memory traffic they add), most profitable
+ *  first, as long as they fit: a web holds a register over all of [start, end], on top of the intervals of the
+ *  temporaries there, and r6–r25 being full would only trade its loads and stores for spills  */
+static void selectWebs(CompilerContext *ctx, int first, int last, Var *vars, Plan *p, int *index) {
+    int *pressure = allocOrDie((last - first + 1) * sizeof(int));
+    int *order = allocOrDie(p->websCount * sizeof(int));
+    int candidates = 0;
+
+    measurePressure(ctx, first, last, index, pressure);
+
+    for (int w = 0; w < p->websCount; w++) {
+        long gain = p->webs[w].weight - p->webs[w].cost;
+        int n = candidates;
+
+        if (gain <= 0) continue;
+
+        for (; n > 0 && p->webs[order[n - 1]].weight - p->webs[order[n - 1]].cost < gain; n--) order[n] = order[n - 1];
+        order[n] = w;
+        candidates++;
+    }
+
+    for (int n = 0; n < candidates; n++) {
+        Web *web = &p->webs[order[n]];
+        int peak = 0;
+
+        for (int i = web->start; i <= web->end; i++) {
+            if (pressure[i - first] > peak) peak = pressure[i - first];
+        }
+        if (peak >= REG_LAST - REG_FIRST + 1) continue;
+
+        for (int i = web->start; i <= web->end; i++) pressure[i - first]++;
+
+        web->temp = ctx->tempsCounter++;
+        if (vars[web->var].global < 0) ctx->optStats.localWebs++;
+        else ctx->optStats.globalWebs++;
+    }
+
+    free(pressure);
+    free(order);
+}
+
+/*--------------------------------------------/
+ *  Rewriting of a function
+ *---------------------------------*/
+
+static Address tempAddress(int temp) {
+    Address a = { addrTemp, NO_SYMBOL };
+
+    a.content.value = temp;
+    return a;
+}
+
+static Address nameAddress(char *name, int symbolId) {
+    Address a = { addrString, symbolId };
+
+    a.content.name = name;
+    return a;
+}
+
+/*  webTemp() → Temporary of web n (-1 when there is none or it stays in memory)  */
+static int webTemp(Plan *p, int n) {
+    return (n < 0) ? -1 : p->webs[n].temp;
+}
+
+/*  rewriteFunction() → Appends the function [first, last] to "out" with its promoted webs in temporaries: their loads
+ *  and stores become Moves, and their memory traffic goes after the allocations of the parameters, around the user
+ *  calls and before FunEND  */
+static void rewriteFunction(CompilerContext *ctx, QuadBuffer *q, int first, int last, Var *vars, int count, Plan *p, QuadBuffer *out) {
+    OptStats *stats = &ctx->optStats;
+    Address empty = { addrVoid, NO_SYMBOL };
+    Address scope = nameAddress(q->src[first].content.name, NO_SYMBOL);
+    int i = first;
+
+    /* FunBGN and the allocations of the parameters, then the entry loads   */
+    appendQuad(out, q->op[i], q->src[i], q->tgt[i], q->dst[i]);
+    for (i++; i <= last && (q->op[i] == AllocVAR || q->op[i] == AllocARRAY); i++) {
+        appendQuad(out, q->op[i], q->src[i], q->tgt[i], q->dst[i]);
+    }
+
+    for (int v = 0; v < count; v++) {
+        int temp = webTemp(p, p->entryWeb[v]);
+
+        if (temp < 0 || !BIT_TEST(p->entryLoad, v)) continue;
+
+        appendQuad(out, LoadVAR, scope, nameAddress(vars[v].name, vars[v].symbolId), tempAddress(temp));
+        stats->accessesAdded++;
+    }
+
+    for (; i <= last; i++) {
+        int temp = webTemp(p, p->accessWeb[i - first]);
+        int *writeBack = p->writeBackWeb + (size_t)(i - first) * count, *reload = p->reloadWeb + (size_t)(i - first) * count;
+
+        if (temp >= 0) {
+            if (q->op[i] == LoadVAR) appendQuad(out, Move, tempAddress(temp), q->dst[i], empty);
+            else appendQuad(out, Move, q->src[i], tempAddress(temp), empty);
+
+            stats->accessesPromoted++;
+            continue;
+        }
+
+        for (int v = 0; v < count; v++) {
+            temp = webTemp(p, (q->op[i] == FunEND) ? p->exitWeb[v] : writeBack[v]);
+            if (temp < 0) continue;
+
+            appendQuad(out, StoreVAR, tempAddress(temp), scope, nameAddress(vars[v].name, vars[v].symbolId));
+            stats->accessesAdded++;
+        }
+
+        appendQuad(out, q->op[i], q->src[i], q->tgt[i], q->dst[i]);
+
+        for (int v = 0; v < count; v++) {
+            temp = webTemp(p, reload[v]);
+            if (temp < 0) continue;
+
+            appendQuad(out, LoadVAR, scope, nameAddress(vars[v].name, vars[v].symbolId), tempAddress(temp));
+            stats->accessesAdded++;
+        }
+    }
+}
+
+/*  freePlan() → Releases a Plan  */
+static void freePlan(Plan *p) {
+    freeCFG(&p->cfg);
+    free(p->live);
+    free(p->writeBack);
+    free(p->reload);
+    free(p->entryLoad);
+    free(p->exitStore);
+    free(p->webs);
+    free(p->accessWeb);
+    free(p->writeBackWeb);
+    free(p->reloadWeb);
+    free(p->entryWeb);
+    free(p->exitWeb);
+}
+
+/*--------------------------------------------/
+ *  Copies left by the promotion
+ *---------------------------------*/
+
+/*  readsTemp() → How many times quadruple i reads temporary t  */
+static int readsTemp(QuadBuffer *q, int i, int t) {
+    int roles = operandRoles(q->op[i]), reads = 0;
+
+    if ((roles & USE_SRC) && q->src[i].type == addrTemp && q->src[i].content.value == t) reads++;
+    if ((roles & USE_TGT) && q->tgt[i].type == addrTemp && q->tgt[i].content.value == t) reads++;
+    if ((roles & USE_DST) && q->dst[i].type == addrTemp && q->dst[i].content.value == t) reads++;
+
+    return reads;
+}
+
+/*  defOf() → Operand quadruple i writes a temporary at (NULL if none)  */
+static Address *defOf(QuadBuffer *q, int i) {
+    int roles = operandRoles(q->op[i]);
+
+    if ((roles & DEF_DST) && q->dst[i].type == addrTemp) return &q->dst[i];
+    if ((roles & DEF_TGT) && q->tgt[i].type == addrTemp) return &q->tgt[i];
+
+    return NULL;
+}
+
+static bool writesTemp(QuadBuffer *q, int i, int t) {
+    Address *def = defOf(q, i);
+
+    return def != NULL && def->content.value == t;
+}
+
+/*  endsBlock() → Whether quadruple i is the last of its basic block (the next one is a label, or i branches or tail calls)  */
+static bool endsBlock(QuadBuffer *q, int i, int last) {
+    return i >= last || q->op[i] == Jump || q->op[i] == IFfalse || isTailCall(q, i) || q->op[i + 1] == Label;
+}
+
+/*  renameUses() → Replaces the reads of temporary "from" in quadruple i by temporary "to"  */
+static void renameUses(QuadBuffer *q, int i, int from, int to) {
+    int roles = operandRoles(q->op[i]);
+
+    if ((roles & USE_SRC) && q->src[i].type == addrTemp && q->src[i].content.value == from) q->src[i].content.value = to;
+    if ((roles & USE_TGT) && q->tgt[i].type == addrTemp && q->tgt[i].content.value == from) q->tgt[i].content.value = to;
+    if ((roles & USE_DST) && q->dst[i].type == addrTemp && q->dst[i].content.value == from) q->dst[i].content.value = to;
+}
+
+/*  coalesceCopies() → Removes the Moves the promotion left in the function [first, last]: a "Move v → t" goes when every
+ *  read of t follows it in the same block before v changes (or v is written once, earlier in the entry block), the
+ *  reads taking v; a "Move t → v" goes when t is read only there, computed earlier in the block with v untouched in
+ *  between, the computation then writing v. Params keep their own temporary (it stays pinned to a register up to the
+ *  Call)  */
+static void coalesceCopies(CompilerContext *ctx, QuadBuffer *q, int first, int last, int firstVar, bool *dead) {
+    int *reads = allocOrDie(ctx->tempsCounter * sizeof(int));
+    int *defs = allocOrDie(ctx->tempsCounter * sizeof(int));
+    int *defAt = allocOrDie(ctx->tempsCounter * sizeof(int));
+    int entryLast = first;
+
+    while (!endsBlock(q, entryLast, last)) entryLast++;
+
+    for (int i = first; i <= last; i++) {
+        Address *def = defOf(q, i);
+        int roles = operandRoles(q->op[i]);
+
+        if ((roles & USE_SRC) && q->src[i].type == addrTemp) reads[q->src[i].content.value]++;
+        if ((roles & USE_TGT) && q->tgt[i].type == addrTemp) reads[q->tgt[i].content.value]++;
+        if ((roles & USE_DST) && q->dst[i].type == addrTemp) reads[q->dst[i].content.value]++;
+
+        if (def != NULL) {
+            defs[def->content.value]++;
+            defAt[def->content.value] = i;
+        }
+    }
+
+    /* Loads: Move v → t   */
+    for (int i = first; i <= last; i++) {
+        if (q->op[i] != Move || q->src[i].type != addrTemp || q->src[i].content.value < firstVar) continue;
+        if (q->tgt[i].type != addrTemp || q->tgt[i].content.value >= firstVar) continue;
+
+        int v = q->src[i].content.value, t = q->tgt[i].content.value, found = 0;
+        int from = i + 1, to = last;
+        bool pinned = false;
+
+        /* Written once, earlier in the entry block (which runs once), v holds the same value everywhere after   */
+        if (defs[v] == 1 && defAt[v] <= entryLast && defAt[v] < i) {
+            from = first;
+        } else {
+            for (to = i; !endsBlock(q, to, last) && !writesTemp(q, to + 1, v); to++);
+            if (to < last && !endsBlock(q, to, last)) to++;
+        }
+
+        for (int k = from; k <= to; k++) {
+            int n = readsTemp(q, k, t);
+
+            if (n > 0 && q->op[k] == Param) pinned = true;
+            found += n;
+        }
+
+        if (pinned || found != reads[t]) continue;
+
+        for (int k = from; k <= to; k++) renameUses(q, k, t, v);
+
+        reads[v] += reads[t] - 1;
+        reads[t] = 0;
+        dead[i] = true;
+        ctx->optStats.coalesced++;
+    }
+
+    /* Stores: Move t → v   */
+    for (int i = first; i <= last; i++) {
+        if (dead[i] || q->op[i] != Move || q->tgt[i].type != addrTemp || q->tgt[i].content.value < firstVar) continue;
+        if (q->src[i].type != addrTemp || q->src[i].content.value >= firstVar) continue;
+
+        int v = q->tgt[i].content.value, t = q->src[i].content.value, d = defAt[t];
+        bool clear = (reads[t] == 1 && defs[t] == 1 && d >= first && d < i && !dead[d]);
+
+        for (int k = d; clear && k < i; k++) {
+            if (endsBlock(q, k, last)) clear = false;
+            else if (k > d && (readsTemp(q, k, v) > 0 || writesTemp(q, k, v))) clear = false;
+        }
+
+        if (!clear) continue;
+
+        defOf(q, d)->content.value = v;
+        dead[i] = true;
+        ctx->optStats.coalesced++;
+    }
+
+    free(reads);
+    free(defs);
+    free(defAt);
+}
+
+/*  promoteScalars() → Keeps the scalar variables of every function in temporaries instead of their frame (or global)
+ *  slots, web by web, so that the allocator gives them registers; memory is only touched at the entry, the exit and
+ *  around calls  */
+void promoteScalars(CompilerContext *ctx) {
+    QuadBuffer *q = &ctx->quadruples;
+    QuadBuffer out = { 0 };
+    Globals g = { 0 };
+    int firstVar = ctx->tempsCounter;
+    int *index = allocOrDie(firstVar * sizeof(int));
+    int first, last, from = 0;
+
+    summarize(ctx, q, &g);
+
+    /* Temporaries of the function being measured, renumbered by measurePressure() (the webs' come after "firstVar")   */
+    for (int t = 0; t < firstVar; t++) index[t] = -1;
+
+    for (first = nextFunction(q, 0, &last); first >= 0; first = nextFunction(q, last + 1, &last)) {
+        long *weight = allocOrDie((last - first + 1) * sizeof(long));
+        Var *vars = allocOrDie((last - first + 1) * sizeof(Var));
+        Plan plan = { 0 };
+        int count;
+
+        for (int i = from; i < first; i++) appendQuad(&out, q->op[i], q->src[i], q->tgt[i], q->dst[i]);
+        from = last + 1;
+
+        loopWeights(q, first, last, weight);
+        count = collectVars(ctx, q, &g, first, last, vars);
+
+        planTraffic(ctx, &g, q, first, last, vars, count, &plan);
+        buildWebs(ctx, q, first, last, vars, count, weight, &plan);
+        selectWebs(ctx, first, last, vars, &plan, index);
+        rewriteFunction(ctx, q, first, last, vars, count, &plan, &out);
+
+        freePlan(&plan);
+        free(weight);
+        free(vars);
+    }
+    for (int i = from; i < q->count; i++) appendQuad(&out, q->op[i], q->src[i], q->tgt[i], q->dst[i]);
+
+    freeQuads(q);
+    *q = out;
+
+    bool *dead = allocOrDie(q->count * sizeof(bool));
+
+    for (first = nextFunction(q, 0, &last); first >= 0; first = nextFunction(q, last + 1, &last)) {
+        coalesceCopies(ctx, q, first, last, firstVar, dead);
+    }
+    removeQuads(q, dead);
+
+    for (int f = 0; f < g.functionsCount; f++) {
+        free(g.functions[f].refs);
+        free(g.functions[f].mods);
+    }
+    free(g.functions);
+    free(g.names);
+    free(dead);
+    free(index);
+}
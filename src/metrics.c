@@ -0,0 +1,110 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Compilation Metrics for a C- Compiler
+ *  File: metrics.c
+ *---------------------------------*/
+
+#define _DEFAULT_SOURCE
+
+#include "metrics.h"
+#include "context.h"
+#include "utils.h"
+
+#define METRICS_VERSION 2
+
+/*  phaseBegin() → Opens a phase: takes the time and the arena usage it starts from  */
+void phaseBegin(CompilerContext *ctx, const char *name) {
+    Metrics *metrics = &ctx->metrics;
+
+    if (metrics->phasesCount == METRIC_PHASES) return;
+
+    PhaseMetrics *phase = &metrics->phases[metrics->phasesCount];
+    phase->name = name;
+    phase->arenaBytes = ctx->arena.allocated;
+    phase->arenaAllocations = ctx->arena.allocations;
+
+    metrics->started = now();
+}
+
+/*  phaseEnd() → Closes the phase opened last, recording its time, arena usage and the memory held by the context  */
+void phaseEnd(CompilerContext *ctx) {
+    Metrics *metrics = &ctx->metrics;
+
+    if (metrics->phasesCount == METRIC_PHASES) return;
+
+    PhaseMetrics *phase = &metrics->phases[metrics->phasesCount++];
+    phase->seconds = now() - metrics->started;
+    phase->arenaBytes = ctx->arena.allocated - phase->arenaBytes;
+    phase->arenaAllocations = ctx->arena.allocations - phase->arenaAllocations;
+    phase->contextBytes = contextMemory(ctx);
+}
+
+/*  writeString() → Writes a JSON string, escaping quotes, backslashes and control characters  */
+static void writeString(FILE *file, const char *s) {
+    fputc('"', file);
+    for (; *s != '\0'; s++) {
+        if (*s == '"' || *s == '\\') fprintf(file, "\\%c", *s);
+        else if ((unsigned char)*s < 0x20) fprintf(file, "\\u%04x", *s);
+        else fputc(*s, file);
+    }
+    fputc('"', file);
+}
+
+/*  writeMetrics() → Writes the phases and counters of a compilation as a JSON report; the back end stages append their
+ *  own phase and counters to it (see metrics.py). Memory keys name what they leave out: "arenaOnly" figures count the
+ *  arena alone and "contextBytesNoScratch" the context's tables, neither the arrays the passes malloc and free  */
+void writeMetrics(CompilerContext *ctx, const char *path) {
+    FILE *file = fopen(path, "w");
+
+    if (file == NULL) {
+        fprintf(ctx->listing, "> Misc Error\n     Could not create \"%s\".\n", path);
+        return;
+    }
+
+    QuadBuffer *quads = &ctx->quadruples;
+    SymbolStats *symbols = &ctx->symbolTable.stats;
+    long labels = 0, pushes = 0, pops = 0;
+
+    for (int i = 0; i < quads->count; i++) {
+        if (quads->op[i] == Label) labels++;
+        else if (quads->op[i] == Push) pushes++;
+        else if (quads->op[i] == Pop) pops++;
+    }
+
+    fprintf(file, "{\n  \"version\": %d,\n  \"source\": ", METRICS_VERSION);
+    writeString(file, ctx->source);
+    fprintf(file, ",\n  \"phases\": [\n");
+
+    for (int i = 0; i < ctx->metrics.phasesCount; i++) {
+        PhaseMetrics *phase = &ctx->metrics.phases[i];
+
+        fprintf(file, "    {\"name\": \"%s\", \"seconds\": %.6f, \"arenaOnlyBytes\": %zu, \"arenaOnlyAllocations\": %ld, \"contextBytesNoScratch\": %zu}%s\n",
+            phase->name, phase->seconds, phase->arenaBytes, phase->arenaAllocations, phase->contextBytes,
+            (i + 1 < ctx->metrics.phasesCount) ? "," : "");
+    }
+
+    fprintf(file, "  ],\n  \"counters\": {\n");
+    fprintf(file, "    \"lines\": %d,\n", ctx->lineno);
+    fprintf(file, "    \"tokens\": %ld,\n", ctx->metrics.tokens);
+    fprintf(file, "    \"astNodes\": %ld,\n", ctx->metrics.astNodes);
+    fprintf(file, "    \"names\": %d,\n", ctx->names.count);
+    fprintf(file, "    \"symbols\": %d,\n", ctx->symbolTable.count);
+    fprintf(file, "    \"symbolLookups\": %ld,\n", symbols->lookups);
+    fprintf(file, "    \"symbolProbes\": %ld,\n", symbols->probes);
+    fprintf(file, "    \"hashCollisions\": %ld,\n", symbols->collisions);
+    fprintf(file, "    \"maxProbe\": %d,\n", symbols->maxProbe);
+    fprintf(file, "    \"symbolTableResizes\": %d,\n", symbols->resizes);
+    fprintf(file, "    \"quadruples\": %d,\n", quads->count);
+    fprintf(file, "    \"labelsCreated\": %d,\n", ctx->labelsCounter);
+    fprintf(file, "    \"labels\": %ld,\n", labels);
+    fprintf(file, "    \"temporaries\": %d,\n", ctx->regAllocStats.temporaries);
+    fprintf(file, "    \"peakLiveRegisters\": %d,\n", ctx->regAllocStats.maxPressure);
+    fprintf(file, "    \"spilled\": %d,\n", ctx->regAllocStats.spilled);
+    fprintf(file, "    \"pushes\": %ld,\n", pushes);
+    fprintf(file, "    \"pops\": %ld,\n", pops);
+    fprintf(file, "    \"arenaOnlyBytes\": %zu,\n", ctx->arena.allocated);
+    fprintf(file, "    \"arenaBlocks\": %d,\n", ctx->arena.blocksCount);
+    fprintf(file, "    \"contextBytesNoScratch\": %zu\n", contextMemory(ctx));
+    fprintf(file, "  }\n}\n");
+
+    fclose(file);
+}
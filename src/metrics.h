@@ -0,0 +1,53 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Compilation Metrics interface for a C- Compiler
+ *  File: metrics.h
+ *---------------------------------*/
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include "globals.h"
+
+/*--------------------------------------------/
+ *  Metrics structure
+ *---------------------------------*/
+
+/*  METRIC_PHASES → Most phases a compilation records (syntaxAnalysis, semanticAnalysis, midCodeGenerate, ...)  */
+#define METRIC_PHASES 8
+
+/*  PhaseMetrics → Wall time of one phase, what it took from the arena (bytes and allocations) and the memory held by the
+ *  context once it is done (contextMemory()); the scratch arrays the passes malloc are in neither  */
+typedef struct {
+    const char *name;
+    double seconds;
+    size_t arenaBytes;
+    long arenaAllocations;
+    size_t contextBytes;
+} PhaseMetrics;
+
+/*  Metrics → Phases of one compilation, in order, and the counters no other report keeps (the rest is read from the
+ *  context when the report is written)  */
+typedef struct {
+    PhaseMetrics phases[METRIC_PHASES];
+    int phasesCount;
+    double started;
+
+    long tokens;
+    long astNodes;
+} Metrics;
+
+/*--------------------------------------------/
+ *  Metrics functions
+ *---------------------------------*/
+
+/*  phaseBegin() → Opens a phase: takes the time and the arena usage it starts from  */
+void phaseBegin(CompilerContext *ctx, const char *name);
+
+/*  phaseEnd() → Closes the phase opened last, recording its time, arena usage and the memory held by the context  */
+void phaseEnd(CompilerContext *ctx);
+
+/*  writeMetrics() → Writes the phases and counters of a compilation as a JSON report; the back end stages append their
+ *  own phase and counters to it (see metrics.py)  */
+void writeMetrics(CompilerContext *ctx, const char *path);
+
+#endif
@@ -0,0 +1,55 @@
+import json
+import resource
+import time
+import tracemalloc
+from typing import Dict, List, Optional
+
+# Taken when a back end stage imports this module, right after the interpreter started
+started = time.perf_counter()
+
+# reportOption() → Takes "--report <file>" out of the command line; without it (nor any path) a stage reports to
+# outputs/report.json, next to the outputs it reads and writes by default. A stage that reports traces its Python
+# allocations from here on, which slows it down (stage_bench runs the stages without a report to time them)
+def reportOption(argv: List[str]) -> Optional[str]:
+    path = None
+
+    if ("--report" in argv):
+        index = argv.index("--report")
+        path = argv[index + 1] if index + 1 < len(argv) else None
+        del argv[index:index + 2]
+    elif (len([arg for arg in argv if not arg.startswith("-")]) == 0):
+        path = "outputs/report.json"
+
+    if (path is not None):
+        tracemalloc.start()
+    return path
+
+# recordPhase() → Appends the phase of a back end stage (its wall time, the peak RSS of its process, and the bytes its
+# Python objects allocated since reportOption(): the most held at once and what is still held at the end) and its
+# counters to the JSON report the front end wrote (metrics.c); a missing report is left alone
+def recordPhase(path: Optional[str], name: str, counters: Dict[str, int]):
+    if (path is None):
+        return
+
+    seconds = round(time.perf_counter() - started, 6)
+    tracedLive, tracedPeak = tracemalloc.get_traced_memory() if tracemalloc.is_tracing() else (None, None)
+    tracemalloc.stop()
+
+    try:
+        with open(path, 'r') as file:
+            report = json.load(file)
+    except (OSError, ValueError):
+        return
+
+    report["phases"].append({
+        "name": name,
+        "seconds": seconds,
+        "peakRSSKiB": resource.getrusage(resource.RUSAGE_SELF).ru_maxrss,
+        "tracedPeakBytes": tracedPeak,
+        "tracedLiveBytes": tracedLive,
+    })
+    report["counters"].update(counters)
+
+    with open(path, 'w') as file:
+        json.dump(report, file, indent=2)
+        file.write("\n")
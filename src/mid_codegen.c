@@ -3,11 +3,15 @@
  *  File: mid_codegen.c
  *---------------------------------*/
 
-#include "mid_codegen.h"
+#include "context.h"
+#include "cfg.h"
+#include "ir_file.h"
+#include "optimizer.h"
 #include "parser.tab.h"
+#include "reg_alloc.h"
 #include "utils.h"
 
-/*  opString[] → [TODO]  */
+/*  opString[] → Name of each Operation (see mid_codegen.h)  */
 const char *opString[] = {
   "Add", "Sub", "Mul", "Div",
   "Or", "And",
@@ -20,163 +24,138 @@ const char *opString[] = {
 };
 
 /*  codeGen() → [TODO]  */
-static void codeGen(TreeNode *t);
+static void codeGen(CompilerContext *ctx, TreeNode *t);
 
-/*  firstExecution → Variable to track the first freeRegister() to start "registers" (int*)  */
-static bool firstExecution = true;
+/*  useTemporary() → Returns a fresh virtual register (mapped onto r6–r25 by allocateRegisters())  */
+static Address useTemporary(CompilerContext *ctx) {
+  Address temp;
 
-#define REG_SIZE 32
-static int *registers;
+  temp.type = addrTemp;
+  temp.symbolId = NO_SYMBOL;
+  temp.content.value = ctx->tempsCounter++;
 
-int usedRegisters = 0;
+  return temp;
+}
 
-/*  useRegister() → [TODO]  */
-static char *useRegister(int addr) {
-  char reg[16];
+/*  useRegister() → Returns one of the fixed physical registers (r2 = $rf, r3 = $io, r4 = $hd, r26 = $pc)  */
+static Address useRegister(CompilerContext *ctx, int addr) {
+  Address reg;
+  char name[16];
 
-  if (addr == -1) {
-    for (int i = 6; i < 26; i++) {
-      if (registers[i] == 0) {
-        registers[i] = 1;
-        
-        sprintf(reg, "r%d", i);
+  sprintf(name, "r%d", addr);
 
-                usedRegisters++;
-        return strdup(reg);
-      }
-    }
-  } else {
-    if (registers[addr] == 0) {
-      registers[addr] = 1;
-      
-      sprintf(reg, "r%d", addr);
+  reg.type = addrString;
+  reg.symbolId = NO_SYMBOL;
+  reg.content.name = internName(ctx, name);
 
-      usedRegisters++;
-      return strdup(reg);
-    }
-  }
-
-  return NULL;
+  return reg;
 }
 
-/*  freeRegisters() → [TODO]  */
-static void freeRegisters(char *reg) {
-  if (firstExecution) {
-    firstExecution = false;
-    registers = malloc(REG_SIZE * sizeof(int));
-    
-    for (int i = 0; i < REG_SIZE; i++) {
-      registers[i] = 0;
-    }
-  }
+/*  growQuads() → Doubles the capacity of the Quadruples List (amortized O(1) insertion)  */
+static void growQuads(QuadBuffer *quads) {
+  int capacity = (quads->capacity == 0) ? QUADS_INITIAL : quads->capacity * 2;
 
-  if (reg == NULL) {
-    for(int i=0; i<REG_SIZE; i++) {
-      registers[i] = 0;
-    }
-    usedRegisters = 0;
-  } else {
-    if (reg[0] == 'r') {
-      int regIndex = atoi(&reg[1]);
-      if (regIndex >= 0 && regIndex < REG_SIZE) {
-        registers[regIndex] = 0;
-        usedRegisters--;
-      }
-    }
+  quads->op = realloc(quads->op, capacity * sizeof(Operation));
+  quads->src = realloc(quads->src, capacity * sizeof(Address));
+  quads->tgt = realloc(quads->tgt, capacity * sizeof(Address));
+  quads->dst = realloc(quads->dst, capacity * sizeof(Address));
+
+  if (quads->op == NULL || quads->src == NULL || quads->tgt == NULL || quads->dst == NULL) {
+    printf("> Misc Error\n     Out of memory error. (Quadruples List)\n");
+    exit(EXIT_FAILURE);
   }
+  quads->capacity = capacity;
+}
+
+/*  appendQuad() → Appends a quadruple, as is, at the end of a Quadruples List (used by the passes that rebuild it)  */
+void appendQuad(QuadBuffer *quads, Operation op, Address src, Address tgt, Address dst) {
+  if (quads->count == quads->capacity) growQuads(quads);
 
+  quads->op[quads->count] = op;
+  quads->src[quads->count] = src;
+  quads->tgt[quads->count] = tgt;
+  quads->dst[quads->count] = dst;
+  quads->count++;
 }
 
-QuadList *quadruples = NULL;
-
-/*  insertQuad() → [TODO]  */
-static void insertQuad(Operation op, Address src, Address tgt, Address dst) {
-  QuadList *newQuad = (QuadList*)malloc(sizeof(QuadList));
-	newQuad->op = op;
-	newQuad->src = src;
-	newQuad->tgt = tgt;
-	newQuad->dst = dst;
-  newQuad->next = NULL;
-
-  if (quadruples == NULL) {
-    quadruples = newQuad;
-  } else {
-    QuadList *list = quadruples;
-    
-    while (list->next != NULL) {
-      list = list->next;
-    }
-    list->next = newQuad;
-  }
+/*  freeQuads() → Releases the arrays of a Quadruples List and empties it  */
+void freeQuads(QuadBuffer *quads) {
+  free(quads->op);
+  free(quads->src);
+  free(quads->tgt);
+  free(quads->dst);
 
-  if (op == Add || op == Sub || op == Mul || op == Div || op == Or || op == And || op == Lshift || op == Rshift || op == SGT || op == SLT || op == SGET || op == SLET || op == SET || op == SDT) {
-    if (src.type == addrString) freeRegisters(src.content.name);
-    if (tgt.type == addrString) freeRegisters(tgt.content.name);
-  } else if (op == StoreVAR || op == StoreARRAY) {
-    if (src.type == addrString) freeRegisters(src.content.name);
-  }
+  memset(quads, 0, sizeof(QuadBuffer));
 }
 
-/*  pushRegister() → [TODO]  */
-static void pushRegister(int paramCounter) {
-  char reg[16];
-	Address src, empty;
-  
-	empty.type = addrVoid;
+/*  removeQuads() → Compacts a Quadruples List, dropping the quadruples flagged in "dead" (flags are cleared); returns
+ *  how many were dropped  */
+int removeQuads(QuadBuffer *quads, bool *dead) {
+  int count = 0;
 
-	for(int i = 0; i<REG_SIZE; i++) {
-		if (registers[i] == 1) {
-      if (paramCounter == usedRegisters) {
-        sprintf(reg, "r%d", i);
+  for (int i = 0; i < quads->count; i++) {
+    if (dead[i]) {
+      dead[i] = false;
+      continue;
+    }
 
-        src.type = addrString;
-        src.content.name = strdup(reg);
+    quads->op[count] = quads->op[i];
+    quads->src[count] = quads->src[i];
+    quads->tgt[count] = quads->tgt[i];
+    quads->dst[count] = quads->dst[i];
+    count++;
+  }
 
-        insertQuad(Push, src, empty, empty);
-      } else {
-        paramCounter++;
-      }
-		}
-	}
+  int removed = quads->count - count;
+
+  quads->count = count;
+  return removed;
 }
 
-/*  popRegister() → [TODO]  */
-static void popRegister(int paramCounter, int addsub) {
-	char reg[16];
-	Address src, dontSUB, empty;
-  
-	empty.type = addrVoid;
+/*  operandRoles() → Reads and writes of each operation (a Call also reads the temporaries of its Params)  */
+int operandRoles(Operation op) {
+  switch (op) {
+    case Add: case Sub: case Mul: case Div:
+    case Or: case And:
+    case Lshift: case Rshift:
+    case SGT: case SLT: case SGET: case SLET: case SET: case SDT:
+      return USE_SRC | USE_TGT | DEF_DST;
+    case StoreVAR: case IFfalse: case Param:
+      return USE_SRC;
+    case StoreARRAY:
+      return USE_SRC | USE_DST;
+    case LoadVAR:
+      return DEF_DST;
+    case LoadARRAY:
+      return USE_TGT | DEF_DST;
+    case Move:
+      return USE_SRC | DEF_TGT;
+    default:
+      return 0;
+  }
+}
 
-	for(int i = REG_SIZE - 1; i>=0; i--) {
-		if (registers[i] == 1) {
-      if (paramCounter > 0) {
-        sprintf(reg, "r%d", i);
+/*  isTailCall() → Whether quadruple i is a Call eliminateTailCalls() turned into a jump that reuses the frame (its dst
+ *  says "tail"): it never returns, so nothing follows it in its function  */
+bool isTailCall(QuadBuffer *quads, int i) {
+  return quads->op[i] == Call && quads->dst[i].type == addrString;
+}
 
-        src.type = addrString;
-        src.content.name = strdup(reg);
+/*  insertQuad() → Appends a quadruple at the end of the Quadruples List  */
+static void insertQuad(CompilerContext *ctx, Operation op, Address src, Address tgt, Address dst) {
+  if (op != FunBGN && op != FunEND && op != Call) src.symbolId = NO_SYMBOL;
+  if (op != AllocVAR && op != AllocARRAY && op != LoadVAR) tgt.symbolId = NO_SYMBOL;
+  if (op != StoreVAR) dst.symbolId = NO_SYMBOL;
 
-        if (addsub) {
-          dontSUB.type = addrConst;
-          dontSUB.content.value = 1;
-          insertQuad(Pop, src, empty, dontSUB);
-        } else {
-          insertQuad(Pop, src, empty, empty);
-        }    
-        freeRegisters(src.content.name);
-        paramCounter--;
-      }
-		}
-	}
+  appendQuad(&ctx->quadruples, op, src, tgt, dst);
 }
 
-static int labelsCounter = 0;
-
-/*  useLabel() → [TODO]  */
-static char *useLabel(void) {
+/*  useLabel(ctx) → [TODO]  */
+static char *useLabel(CompilerContext *ctx) {
     char label[16];
-    sprintf(label, "l%d", labelsCounter++);
+    sprintf(label, "l%d", ctx->labelsCounter++);
 
-    return strdup(label);
+    return internName(ctx, label);
 }
 
 /*  tokenToOperation() → [TODO]  */
@@ -228,7 +207,7 @@ static const Operation tokenToOperation(int token) {
 }
 
 /*  declGen() → [TODO]  */
-static void declGen(TreeNode *t) {
+static void declGen(CompilerContext *ctx, TreeNode *t) {
   Address src, tgt, dst;
 
   if (t == NULL) return;
@@ -236,80 +215,90 @@ static void declGen(TreeNode *t) {
   switch (t->kind.decl) {
     case DeclFunction:
       src.type = addrString;
-      src.content.name = strdup(t->attr.name);	
+      src.symbolId = t->symbolId;
+      src.content.name = t->attr.name;	
 
       tgt.type = addrString;
-      tgt.content.name = strdup(expTypeToString(t->type));
+      tgt.content.name = internName(ctx, expTypeToString(t->type));
 
       dst.type = addrVoid;
 
-      insertQuad(FunBGN, src, tgt, dst);
+      insertQuad(ctx, FunBGN, src, tgt, dst);
+
+      ctx->exitLabel = useLabel(ctx);
+
+      codeGen(ctx, t->child[0]);
+      codeGen(ctx, t->child[1]);
 
-      codeGen(t->child[0]);
-      codeGen(t->child[1]);
+      /* Every return jumps here (left unreferenced, the label is dropped by eliminateDeadCode())   */
+      Address label = { addrString, NO_SYMBOL };
+      Address none = { addrVoid, NO_SYMBOL };
 
-      insertQuad(FunEND, src, tgt, dst);
+      label.content.name = ctx->exitLabel;
+      insertQuad(ctx, Label, label, none, none);
 
-      if (!strcmp(src.content.name, "main")) {
+      insertQuad(ctx, FunEND, src, tgt, dst);
+
+      if (src.content.name == ctx->mainName) {
         src.type = addrVoid;
         
-        insertQuad(End, src, tgt, dst);
+        insertQuad(ctx, End, src, tgt, dst);
       }
 
-      freeRegisters(NULL);
-
       break;
     case DeclParameter:
       src.type = addrString;
-      src.content.name = strdup(t->scope);
+      src.content.name = t->scope;
 
       if (t->flags.isArray) {
         tgt.type = addrString;
-        tgt.content.name = strdup(t->attr.arrayAttr.name);
+        tgt.symbolId = t->symbolId;
+        tgt.content.name = t->attr.arrayAttr.name;
 
         dst.type = addrConst;
         dst.content.value = t->attr.arrayAttr.size;
 
-        insertQuad(AllocARRAY, src, tgt, dst);
+        insertQuad(ctx, AllocARRAY, src, tgt, dst);
       } else {
         tgt.type = addrString;
-        tgt.content.name = strdup(t->attr.name);
+        tgt.symbolId = t->symbolId;
+        tgt.content.name = t->attr.name;
 
         dst.type = addrVoid;
 
-        insertQuad(AllocVAR, src, tgt, dst);
+        insertQuad(ctx, AllocVAR, src, tgt, dst);
       }
       break;
     case DeclVariable:
       src.type = addrString;
-      src.content.name = strdup(t->scope);	
+      src.content.name = t->scope;	
 
       tgt.type = addrString;
-      tgt.content.name = strdup(t->attr.name);	
+      tgt.symbolId = t->symbolId;
+      tgt.content.name = t->attr.name;	
 
       dst.type = addrVoid;
 
-      insertQuad(AllocVAR, src, tgt, dst);
+      insertQuad(ctx, AllocVAR, src, tgt, dst);
       break;
     case DeclArray:
       src.type = addrString;
-      src.content.name = strdup(t->scope);	
+      src.content.name = t->scope;	
 
       tgt.type = addrString;
-      tgt.content.name = strdup(t->attr.arrayAttr.name);	
+      tgt.symbolId = t->symbolId;
+      tgt.content.name = t->attr.arrayAttr.name;	
 
       dst.type = addrConst;
       dst.content.value = t->attr.arrayAttr.size;	
 
-      insertQuad(AllocARRAY, src, tgt, dst);
+      insertQuad(ctx, AllocARRAY, src, tgt, dst);
       break;
   }
 }
 
-static Address current;
-
 /*  stmtGen() → [TODO]  */
-static void stmtGen(TreeNode *t) {
+static void stmtGen(CompilerContext *ctx, TreeNode *t) {
   Address src, tgt, dst;
   Address empty;
   Address condition;
@@ -318,162 +307,145 @@ static void stmtGen(TreeNode *t) {
   char *labelElse;
   char *labelEnd;
 
-  char *regTemp;
-
   empty.type = addrVoid;
   
   if (t == NULL) return;
 
   switch (t->kind.stmt) {
     case StmtAssign:
-      codeGen(t->child[1]);  
-      Address right = current;
+      codeGen(ctx, t->child[1]);  
+      Address right = ctx->current;
 
       if (t->child[0]->flags.isArray) {
         src.type = addrString;
-        src.content.name = strdup(t->child[0]->scope);	
+        src.content.name = t->child[0]->scope;	
 
         tgt.type = addrString;
-        tgt.content.name = strdup(t->child[0]->attr.arrayAttr.name);	
+        tgt.symbolId = t->child[0]->symbolId;
+        tgt.content.name = t->child[0]->attr.arrayAttr.name;	
 
-        regTemp = useRegister(-1);
-        dst.type = addrString;
-        dst.content.name = strdup(regTemp);
+        dst = useTemporary(ctx);
         
-        insertQuad(LoadVAR, src, tgt, dst);
+        insertQuad(ctx, LoadVAR, src, tgt, dst);
 
-        codeGen(t->child[0]->child[0]);
+        codeGen(ctx, t->child[0]->child[0]);
         
-        Address temp;
-
-        regTemp = useRegister(-1);
-        temp.type = addrString;
-        temp.content.name = strdup(regTemp);
+        Address temp = useTemporary(ctx);
 
-        insertQuad(Add, dst, current, temp);
+        insertQuad(ctx, Add, dst, ctx->current, temp);
 
         tgt.type = addrString;
-        tgt.content.name = strdup(t->child[0]->scope);	
+        tgt.content.name = t->child[0]->scope;	
 
-        insertQuad(StoreARRAY, right, tgt, temp);
-
-        freeRegisters(temp.content.name);
+        insertQuad(ctx, StoreARRAY, right, tgt, temp);
       } else {
         src.type = addrString;
-        src.content.name = strdup(t->child[0]->scope);
+        src.content.name = t->child[0]->scope;
 
         tgt.type = addrString;
-        tgt.content.name = strdup(t->child[0]->attr.name);
+        tgt.symbolId = t->child[0]->symbolId;
+        tgt.content.name = t->child[0]->attr.name;
 
-        insertQuad(StoreVAR, right, src, tgt);
+        insertQuad(ctx, StoreVAR, right, src, tgt);
       }
       break;
     case StmtCompound:
-      codeGen(t->child[0]);
-      codeGen(t->child[1]);
+      codeGen(ctx, t->child[0]);
+      codeGen(ctx, t->child[1]);
       break;
     case StmtIf:
-      labelElse = useLabel();
+      labelElse = useLabel(ctx);
 
-      codeGen(t->child[0]);
-      condition = current;
+      codeGen(ctx, t->child[0]);
+      condition = ctx->current;
 
       tgt.type = addrString;
       tgt.content.name = labelElse;
 
-      insertQuad(IFfalse, condition, tgt, empty);
+      insertQuad(ctx, IFfalse, condition, tgt, empty);
 
-      freeRegisters(condition.content.name);
 
-      codeGen(t->child[1]);
+      codeGen(ctx, t->child[1]);
 
       if (t->child[2] != NULL) {
-        labelEnd = useLabel();
+        labelEnd = useLabel(ctx);
 
         src.type = addrString;
         src.content.name = labelEnd;
 
-        insertQuad(Jump, src, empty, empty);
+        insertQuad(ctx, Jump, src, empty, empty);
         
         src.type = addrString;
         src.content.name = labelElse;
 
-        insertQuad(Label, src, empty, empty);
+        insertQuad(ctx, Label, src, empty, empty);
 
-        codeGen(t->child[2]);
+        codeGen(ctx, t->child[2]);
 
         src.type = addrString;
         src.content.name = labelEnd;
 
-        insertQuad(Label, src, empty, empty);
+        insertQuad(ctx, Label, src, empty, empty);
       } else {
         src.type = addrString;
         src.content.name = labelElse;
 
-        insertQuad(Label, src, empty, empty);
+        insertQuad(ctx, Label, src, empty, empty);
       }
     break;
     case StmtWhile:
-      labelStart = useLabel();
-      labelEnd = useLabel();
+      labelStart = useLabel(ctx);
+      labelEnd = useLabel(ctx);
 
       src.type = addrString;
       src.content.name = labelStart;
 
-      insertQuad(Label, src, empty, empty);
+      insertQuad(ctx, Label, src, empty, empty);
 
-      codeGen(t->child[0]);
-      condition = current;
+      codeGen(ctx, t->child[0]);
+      condition = ctx->current;
 
       tgt.type = addrString;
       tgt.content.name = labelEnd;  
 
-      insertQuad(IFfalse, condition, tgt, empty);
+      insertQuad(ctx, IFfalse, condition, tgt, empty);
 
-      freeRegisters(condition.content.name);
 
-      codeGen(t->child[1]);
+      codeGen(ctx, t->child[1]);
 
       src.type = addrString;
       src.content.name = labelStart;
 
-      insertQuad(Jump, src, empty, empty);
+      insertQuad(ctx, Jump, src, empty, empty);
 
       src.type = addrString;
       src.content.name = labelEnd;
 
-      insertQuad(Label, src, empty, empty);
+      insertQuad(ctx, Label, src, empty, empty);
     break;
     case StmtReturn:
       if (t->child[0] != NULL) {
         Address rtn;
 
-        codeGen(t->child[0]);
+        codeGen(ctx, t->child[0]);
 
-        regTemp = useRegister(2);
-        rtn.type = addrString;
-        rtn.content.name = regTemp;
+        rtn = useRegister(ctx, 2);
 
-        insertQuad(Move, current, rtn, empty);   
-        insertQuad(Return, rtn, empty, empty);
+        insertQuad(ctx, Move, ctx->current, rtn, empty);   
+      }
 
-        if (current.type == addrString) {
-          freeRegisters(current.content.name);
-        }
+      src.type = addrString;
+      src.content.name = ctx->exitLabel;
 
-        freeRegisters(rtn.content.name);
-      } else {
-        insertQuad(Return, empty, empty, empty);
-      }
+      insertQuad(ctx, Jump, src, empty, empty);
     break;
   }
 }
 
 /*  expGen() → [TODO]  */
-static void expGen(TreeNode *t) {
+static void expGen(CompilerContext *ctx, TreeNode *t) {
   Address src, tgt, dst;
   Address empty;
-  char *regTemp;
 
   empty.type = addrVoid;
 
@@ -484,82 +456,70 @@ static void expGen(TreeNode *t) {
       Address left, right;
 
       if (t->child[0]->nodekind == NodeExpression && t->child[0]->kind.exp == ExpCall) {
-        codeGen(t->child[0]);
-        left = current;
+        codeGen(ctx, t->child[0]);
+        left = ctx->current;
 
-        codeGen(t->child[1]);
-        right = current;
+        codeGen(ctx, t->child[1]);
+        right = ctx->current;
       } else if (t->child[1]->nodekind == NodeExpression && t->child[1]->kind.exp == ExpCall) {
-        codeGen(t->child[1]);
-        right = current;
+        codeGen(ctx, t->child[1]);
+        right = ctx->current;
 
-        codeGen(t->child[0]);
-        left = current;
+        codeGen(ctx, t->child[0]);
+        left = ctx->current;
       } else {
-        codeGen(t->child[0]);
-        left = current;
+        codeGen(ctx, t->child[0]);
+        left = ctx->current;
   
-        codeGen(t->child[1]);
-        right = current;
+        codeGen(ctx, t->child[1]);
+        right = ctx->current;
       }
 
-      regTemp = useRegister(-1);
-      current.type = addrString;
-      current.content.name = strdup(regTemp);
+      ctx->current = useTemporary(ctx);
 
-      insertQuad(tokenToOperation(t->attr.operator), left, right, current);
+      insertQuad(ctx, tokenToOperation(t->attr.operator), left, right, ctx->current);
       break;
     case ExpConst:
-      current.type = addrConst;
-      current.content.value = t->attr.value;
+      ctx->current.type = addrConst;
+      ctx->current.content.value = t->attr.value;
       break;
     case ExpID:
       if (t->flags.isArray) {
         src.type = addrString;
-        src.content.name = strdup(t->scope);	
+        src.content.name = t->scope;	
 
         tgt.type = addrString;
-        tgt.content.name = strdup(t->attr.arrayAttr.name);	
+        tgt.symbolId = t->symbolId;
+        tgt.content.name = t->attr.arrayAttr.name;	
 
-        regTemp = useRegister(-1);
-        dst.type = addrString;
-        dst.content.name = strdup(regTemp);
+        dst = useTemporary(ctx);
 
-        insertQuad(LoadVAR, src, tgt, dst);
+        insertQuad(ctx, LoadVAR, src, tgt, dst);
 
-        codeGen(t->child[0]);
+        codeGen(ctx, t->child[0]);
 
-        Address temp;
+        Address temp = useTemporary(ctx);
 
-        regTemp = useRegister(-1);
-        temp.type = addrString;
-        temp.content.name = strdup(regTemp);
+        insertQuad(ctx, Add, dst, ctx->current, temp);
 
-        insertQuad(Add, dst, current, temp);
+        ctx->current = useTemporary(ctx);
 
-        regTemp = useRegister(-1);
-        current.type = addrString;
-        current.content.name = strdup(regTemp);
+        insertQuad(ctx, LoadARRAY, src, temp, ctx->current);
 
-        insertQuad(LoadARRAY, src, temp, current);
-
-        freeRegisters(temp.content.name);
       } else {
         src.type = addrString;
-        src.content.name = strdup(t->scope);
+        src.content.name = t->scope;
         
         tgt.type = addrString;
-        tgt.content.name = strdup(t->attr.name);
+        tgt.symbolId = t->symbolId;
+        tgt.content.name = t->attr.name;
 
-        regTemp = useRegister(-1);
-        current.type = addrString;
-        current.content.name = strdup(regTemp);
+        ctx->current = useTemporary(ctx);
         
-        insertQuad(LoadVAR, src, tgt, current);
+        insertQuad(ctx, LoadVAR, src, tgt, ctx->current);
       }
       break;
     case ExpCall:
-      int addsub = 0;
       int paramCounter = 0;
       Address rf_temp;
       TreeNode *parameters = t->child[0];
@@ -567,192 +527,182 @@ static void expGen(TreeNode *t) {
       while (parameters != NULL) {
         paramCounter++;
         
-        if (parameters->nodekind == NodeStatement) stmtGen(parameters);
-        else if (parameters->nodekind = NodeExpression) expGen(parameters);
+        if (parameters->nodekind == NodeStatement) stmtGen(ctx, parameters);
+        else if (parameters->nodekind = NodeExpression) expGen(ctx, parameters);
         
-        if (current.type == addrConst) {
-          regTemp = useRegister(-1);
-          dst.type = addrString;
-          dst.content.name = strdup(regTemp);
+        if (ctx->current.type == addrConst) {
+          dst = useTemporary(ctx);
           
-          insertQuad(Move, current, dst, empty);
-          insertQuad(Param, dst, empty, empty);
+          insertQuad(ctx, Move, ctx->current, dst, empty);
+          insertQuad(ctx, Param, dst, empty, empty);
         } else {
-          insertQuad(Param, current, empty, empty);
+          insertQuad(ctx, Param, ctx->current, empty, empty);
         }
         
         parameters = parameters->sibling;
       }
       
       src.type = addrString;
-      src.content.name = strdup(t->attr.name);
+      src.symbolId = t->symbolId;
+      src.content.name = t->attr.name;
       
       tgt.type = addrConst;
       tgt.content.value = paramCounter;
       
       dst.type = addrVoid;
 
-      if (strcmp(t->attr.name, "output") == 0       ||
-          strcmp(t->attr.name, "loadHD") == 0       ||
-          strcmp(t->attr.name, "LCDwrite") == 0     ||
-          strcmp(t->attr.name, "storeHD") == 0      ||
-          strcmp(t->attr.name, "HDtoIM") == 0       ||
-          strcmp(t->attr.name, "execute") == 0      ||
-          strcmp(t->attr.name, "setupProgram") == 0 ||
-          strcmp(t->attr.name, "executeRR") == 0
-        )
-      {
-        addsub = 1;
-      } else {
-        pushRegister(paramCounter);
-      }
+      Builtin builtin = (t->symbol != NULL) ? t->symbol->builtin : NotBuiltin;
 
-      insertQuad(Call, src, tgt, dst);
-      
-      popRegister(paramCounter, addsub);
+      /* Registers live across the call are saved (Push/Pop) by allocateRegisters()   */
+      insertQuad(ctx, Call, src, tgt, dst);
 
       if (t->type != Void) {
-        if ((strcmp(src.content.name, "peek") == 0) || (strcmp(src.content.name, "input") == 0) || (strcmp(src.content.name, "UART") == 0)) {
-          regTemp = useRegister(3);
-        } else if (strcmp(src.content.name, "loadHD") == 0) {
-          regTemp = useRegister(4);
-        } else if (strcmp(src.content.name, "executeRR") == 0) {
-          regTemp = useRegister(26);
+        if (builtin == BuiltinPeek || builtin == BuiltinInput || builtin == BuiltinUART) {
+          rf_temp = useRegister(ctx, 3);
+        } else if (builtin == BuiltinLoadHD) {
+          rf_temp = useRegister(ctx, 4);
+        } else if (builtin == BuiltinExecuteRR) {
+          rf_temp = useRegister(ctx, 26);
         } else {
-          regTemp = useRegister(2);
+          rf_temp = useRegister(ctx, 2);
         }
 
-        rf_temp.type = addrString;
-        rf_temp.content.name = strdup(regTemp);
-        
-        regTemp = useRegister(-1);
-        current.type = addrString;
-        current.content.name = strdup(regTemp);
+        ctx->current = useTemporary(ctx);
 
-        insertQuad(Move, rf_temp, current, empty);
-        freeRegisters(rf_temp.content.name);
+        insertQuad(ctx, Move, rf_temp, ctx->current, empty);
       }
       break;
   }
 }
 
 /*  codeGen() → [TODO]  */
-static void codeGen(TreeNode *t) {
+static void codeGen(CompilerContext *ctx, TreeNode *t) {
   if (t != NULL) {
     switch (t->nodekind) {
       case NodeDeclaration:
-        declGen(t);
+        declGen(ctx, t);
         break;
       case NodeStatement:
-        stmtGen(t);
+        stmtGen(ctx, t);
         break;
       case NodeExpression:
-        expGen(t);
+        expGen(ctx, t);
         break;
     }
-    codeGen(t->sibling);
+    codeGen(ctx, t->sibling);
   }
 }
 
-/*  traceMidCode() → Check TraceMidCode and print out the Quadruples List  */
-static void traceMidCode(char *string) {
-  if (TraceMidCode) {
-    printf("%s", string);
+/*  writeAddress() → Writes an operand of a quadruple as the intermediate code file holds it ("---" when void)  */
+static void writeAddress(FILE *file, Address a) {
+  switch (a.type) {
+    case addrVoid:   fprintf(file, "---"); break;
+    case addrConst:  fprintf(file, "%d", a.content.value); break;
+    case addrString: fprintf(file, "%s", a.content.name); break;
+    case addrTemp:   fprintf(file, "t%d", a.content.value); break;
   }
 }
 
-static int counter = 0;
+/*  printQuadruplesList() → Writes the Quadruples List to the binary intermediate code file, read by assembly_codegen.py
+ *  (see ir_file.h), and with MIDCODE_TEXT also as text, to a ".txt" file next to it  */
+static void printQuadruplesList(CompilerContext *ctx) {
+  QuadBuffer *quads = &ctx->quadruples;
 
-/*  printQuadruplesList() → [TODO]  */
-static void printQuadruplesList(void) {
-  FILE *file = fopen("outputs/midcode.txt","w");
+  if (quads->count == 0) return;
 
-  if (quadruples == NULL) return;
+  writeIRFile(ctx, ctx->midcodePath);
 
-  printf("\n> Intermediate Code Synthesis ----------------------------------------------");
-  printBars();
+  if (!MIDCODE_TEXT) return;
 
-  fprintf(file, "%s\n", source);
+  char path[520];
+  char *extension = strrchr(ctx->midcodePath, '.');
+  int length = (extension != NULL) ? (int)(extension - ctx->midcodePath) : (int)strlen(ctx->midcodePath);
 
-  QuadList *list = quadruples;
-  while (list != NULL) {
-    char str[32];
+  snprintf(path, sizeof(path), "%.*s.txt", length, ctx->midcodePath);
 
-    fprintf(file, "%s|", opString[list->op]);
+  FILE *file = fopen(path, "w");
+  if (file == NULL) {
+    fprintf(ctx->listing, "> Misc Error\n     Could not create \"%s\".\n", path);
+    return;
+  }
 
-    sprintf(str, "\t> %d:\t%-10s ", counter, opString[list->op]);
-    traceMidCode(str);
+  fprintf(file, "%s\n", ctx->source);
 
+  for (int i = 0; i < quads->count; i++) {
+    fprintf(file, "%s|", opString[quads->op[i]]);
+    writeAddress(file, quads->src[i]);
+    fprintf(file, "|");
+    writeAddress(file, quads->tgt[i]);
+    fprintf(file, "|");
+    writeAddress(file, quads->dst[i]);
+    fprintf(file, "\n");
+  }
+  fclose(file);
+}
 
-    sprintf(str, "→");
-    traceMidCode(str);
-    
+/*  traceAddress() → Logs an operand of a quadruple (void ones are left out)  */
+static void traceAddress(CompilerContext *ctx, Address a) {
+  switch (a.type) {
+    case addrVoid:   break;
+    case addrConst:  fprintf(ctx->listing, "%-6d ", a.content.value); break;
+    case addrString: fprintf(ctx->listing, "%-6s ", a.content.name); break;
+    case addrTemp:   fprintf(ctx->listing, "t%-5d ", a.content.value); break;
+  }
+}
 
-    sprintf(str, "   ");
-    traceMidCode(str);
+/*  traceMidCode() → Check TraceMidCode and log the Quadruples List  */
+static void traceMidCode(CompilerContext *ctx) {
+  QuadBuffer *quads = &ctx->quadruples;
 
-    switch (list->src.type) {
-      case addrVoid:
-        fprintf(file, "---|");
-        // traceMidCode("-----  ");   // Optional hifens
-        break;
-      case addrConst:
-        fprintf(file, "%d|", list->src.content.value);
-        sprintf(str, "%-6d ", list->src.content.value);
-        traceMidCode(str);
-        break;
-      case addrString:
-        fprintf(file, "%s|", list->src.content.name);
-        sprintf(str, "%-6s ", list->src.content.name);
-        traceMidCode(str);
-        break;
-    }
-    switch (list->tgt.type) {
-      case addrVoid:
-        fprintf(file, "---|");
-        // traceMidCode("-----  ");   // Optional hifens
-        break;
-      case addrConst:
-        fprintf(file, "%d|", list->tgt.content.value);
-        sprintf(str, "%-6d ", list->tgt.content.value);
-        traceMidCode(str);
-        break;
-      case addrString:
-        fprintf(file, "%s|", list->tgt.content.name);
-        sprintf(str, "%-6s ", list->tgt.content.name);
-        traceMidCode(str);
-        break;
-    }
-    switch (list->dst.type) {
-      case addrVoid:
-        fprintf(file, "---");
-        // traceMidCode("-----  ");   // Optional hifens
-        break;
-      case addrConst:
-        fprintf(file, "%d", list->dst.content.value);
-        sprintf(str, "%-6d ", list->dst.content.value);
-        traceMidCode(str);
-        break;
-      case addrString:
-        fprintf(file, "%s", list->dst.content.name);
-        sprintf(str, "%-6s ", list->dst.content.name);
-        traceMidCode(str);
-        break;
-    }
-    fprintf(file, "\n");
-    traceMidCode("\n");
+  fprintf(ctx->listing, "\n> Intermediate Code Synthesis ----------------------------------------------");
+  printBars(ctx);
+
+  for (int i = 0; i < quads->count; i++) {
+    fprintf(ctx->listing, "\t> %d:\t%-10s →   ", i, opString[quads->op[i]]);
+    traceAddress(ctx, quads->src[i]);
+    traceAddress(ctx, quads->tgt[i]);
+    traceAddress(ctx, quads->dst[i]);
+    fprintf(ctx->listing, "\n");
+  }
+  newLine(ctx);
+}
+
+/*  traceControlFlow() → Log the basic blocks and dominators of every function  */
+static void traceControlFlow(CompilerContext *ctx) {
+  QuadBuffer *quads = &ctx->quadruples;
+  int first, last;
 
-    counter++;
+  for (first = nextFunction(quads, 0, &last); first >= 0; first = nextFunction(quads, last + 1, &last)) {
+    CFG g;
 
-    list = list->next;
+    buildCFG(&g, quads, first, last);
+    computeDominators(&g);
+    printCFG(ctx, &g);
+    freeCFG(&g);
   }
-  fclose(file);
-  newLine();
 }
 
 /*  midCodeGenerate() → Call codeGen() and [TODO] ---> Traceable    */
-void midCodeGenerate(TreeNode *AST)  {
-  freeRegisters(NULL);
-  codeGen(AST);
-  printQuadruplesList();
+void midCodeGenerate(CompilerContext *ctx)  {
+  codeGen(ctx, ctx->abstractSyntaxTree);
+  if (OPT_LEVEL > 0) {
+    inlineCalls(ctx);
+    foldConstants(ctx);
+    reduceStrength(ctx);
+    eliminateDeadCode(ctx);
+    eliminateTailCalls(ctx);
+    hoistInvariants(ctx);
+    promoteScalars(ctx);
+  }
+  allocateRegisters(ctx);
+  if (ctx->failed) return;
+
+  printQuadruplesList(ctx);
+  if (beginTrace(ctx, TraceMidCode)) {
+    traceMidCode(ctx);
+    traceControlFlow(ctx);
+    endTrace(ctx);
+  }
+  if (OPT_LEVEL > 0) printOptStats(ctx);
+  printRegAllocStats(ctx);
 }
\ No newline at end of file
@@ -12,6 +12,8 @@
  *  Quadruples List structure
  *---------------------------------*/
 
+#define REG_SIZE 32
+
 /*  Operation → Defines all supported intermediate code operations  */
 typedef enum {
     Add, Sub, Mul, Div,
@@ -24,12 +26,18 @@ typedef enum {
     Push, Pop, Halt, End
 } Operation;
 
-/*  AddrType → Defines the type of an address (void, constant, or string)  */
-typedef enum { addrVoid, addrConst, addrString } AddrType;
+/*  opString[] → Name of each Operation, as the intermediate code files spell it  */
+extern const char *opString[];
+
+/*  AddrType → Defines the type of an address (void, constant, string, or virtual register "temporary")  */
+typedef enum { addrVoid, addrConst, addrString, addrTemp } AddrType;
 
-/*  Address → Represents an operand (address) in a quadruple  */
+/*  Address → Represents an operand (address) in a quadruple; identifiers (FunBGN/Call src, AllocVAR/AllocARRAY/LoadVAR
+ *  tgt and StoreVAR dst) also carry the ID of their symbol, every other operand has NO_SYMBOL. Temporaries (content.value
+ *  = their number) only live until allocateRegisters() maps them onto physical registers  */
 typedef struct {
 	AddrType type;
+	int symbolId;
 
 	union{
 		int value;
@@ -37,11 +45,41 @@ typedef struct {
 	} content;
 } Address;
 
-/*  QuadList → Node structure for a quadruple in/and the Quadruples List  */
-typedef struct Quadruple {
-    Operation op;
-    Address src, tgt, dst;
-  	struct Quadruple *next;
-} QuadList;
+#define QUADS_INITIAL 256
+
+/*  Roles → Operands of a quadruple a temporary may be read (USE) or written (DEF) at (see operandRoles())  */
+#define USE_SRC 1
+#define USE_TGT 2
+#define USE_DST 4
+#define DEF_TGT 8
+#define DEF_DST 16
+
+/*  QuadBuffer → Growable, contiguous Quadruples List (struct of arrays: op/src/tgt/dst), each quadruple addressed by its index  */
+typedef struct {
+    Operation *op;
+    Address *src, *tgt, *dst;
+    int count;
+    int capacity;
+} QuadBuffer;
+
+/*--------------------------------------------/
+ *  Quadruples List functions
+ *---------------------------------*/
+
+/*  appendQuad() → Appends a quadruple, as is, at the end of a Quadruples List (used by the passes that rebuild it)  */
+void appendQuad(QuadBuffer *quads, Operation op, Address src, Address tgt, Address dst);
+
+/*  freeQuads() → Releases the arrays of a Quadruples List and empties it  */
+void freeQuads(QuadBuffer *quads);
+
+/*  removeQuads() → Compacts a Quadruples List, dropping the quadruples flagged in "dead" (flags are cleared); returns
+ *  how many were dropped  */
+int removeQuads(QuadBuffer *quads, bool *dead);
+
+/*  operandRoles() → Reads and writes of each operation (a Call also reads the temporaries of its Params)  */
+int operandRoles(Operation op);
+
+/*  isTailCall() → Whether quadruple i is a tail call (a Call turned into a jump that reuses the caller's frame)  */
+bool isTailCall(QuadBuffer *quads, int i);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,124 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Intermediate Code Optimizer interface for a C- Compiler
+ *  File: optimizer.h
+ *---------------------------------*/
+
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include "globals.h"
+#include "mid_codegen.h"
+
+/*--------------------------------------------/
+ *  Optimizer structure
+ *---------------------------------*/
+
+/*  IMM_MAX → Largest constant the passes produce (the back end only takes non negative, 16 bit immediates)  */
+#define IMM_MAX 32767
+
+/*  LICM_REGS → Registers (r6–r25) that the values a loop reads from outside, hoisted ones included, may take together with
+ *  the arguments of its widest call (held in registers up to the Call); past it, hoisting would only add spills  */
+#define LICM_REGS 20
+
+/*  INLINE_WORDS → Words of the program cluster binary_codegen.py pads every program to: inlining a call that grows the
+ *  program never takes it (by its estimated size) past it  */
+#define INLINE_WORDS 1024
+
+/*  INLINE_SIZE → Largest function (estimated words) copied into a call site when that grows the program  */
+#define INLINE_SIZE 24
+
+/*  InlineRecord → Calls of "callee" inlined into "caller" (how many), for the report  */
+typedef struct InlineRecord {
+    char *caller, *callee;
+    int sites;
+    struct InlineRecord *next;
+} InlineRecord;
+
+/*  OptStats → What each pass over the Quadruples List did, for the report  */
+typedef struct {
+    /*  Inlining  */
+    int inlined;
+    int functionsRemoved;
+    int wordsBefore;
+    int wordsAfter;
+    int overheadRemoved;
+    InlineRecord *inlines;
+
+    /*  Constant folding and propagation  */
+    int quadsBefore;
+    int folded;
+    int propagated;
+    int loadsReplaced;
+    int copies;
+    int removed;
+
+    /*  Strength reduction  */
+    int multiplies;
+    int divides;
+
+    /*  Dead and unreachable code elimination  */
+    int deadBefore;
+    int branches;
+    int unreachableBlocks;
+    int unreachable;
+    int jumps;
+    int labels;
+    int computations;
+    int stores;
+    int deadRemoved;
+
+    /*  Tail call elimination  */
+    int tailLoops;
+    int accumulators;
+    int tailJumps;
+
+    /*  Loop invariant code motion  */
+    int loops;
+    int hoisted;
+    int merged;
+
+    /*  Scalar promotion  */
+    int localWebs;
+    int globalWebs;
+    int accessesPromoted;
+    int accessesAdded;
+    int coalesced;
+} OptStats;
+
+/*--------------------------------------------/
+ *  Optimizer passes (run by midCodeGenerate() between codeGen() and allocateRegisters())
+ *---------------------------------*/
+
+/*  inlineCalls() → Expands the calls to small, non recursive functions into their callers, guided by the size they add
+ *  against the call sequences they save, within the program cluster; functions left without calls are dropped  */
+void inlineCalls(CompilerContext *ctx);
+
+/*  foldConstants() → Folds constant arithmetic, shifts and comparisons, propagates constants through temporaries and,
+ *  inside each basic block, through scalar variables; removes the definitions left unused  */
+void foldConstants(CompilerContext *ctx);
+
+/*  reduceStrength() → Turns multiplies by 2^k into left shifts and divides by 2^k into right shifts, the latter only when
+ *  the dividend is known to be non negative (srl is a logical shift: it would not round a negative one toward zero)  */
+void reduceStrength(CompilerContext *ctx);
+
+/*  eliminateDeadCode() → Folds constant branches, drops unreachable blocks, useless jumps and labels, then dead
+ *  computations and dead stores to frame slots until none is left  */
+void eliminateDeadCode(CompilerContext *ctx);
+
+/*  eliminateTailCalls() → Turns self recursive calls in tail position into loops (an accumulator taking what is added to
+ *  or multiplied by their result) and other tail calls into jumps that reuse the caller's frame  */
+void eliminateTailCalls(CompilerContext *ctx);
+
+/*  hoistInvariants() → Loop invariant code motion: finds the natural loops of every function (back edges to a dominating
+ *  header) and moves their invariant loads, address computations and arithmetic into a preheader  */
+void hoistInvariants(CompilerContext *ctx);
+
+/*  promoteScalars() → Keeps the scalar variables of every function in temporaries instead of their frame (or global)
+ *  slots, web by web, so that the allocator gives them registers; memory is only touched at the entry, the exit and
+ *  around calls  */
+void promoteScalars(CompilerContext *ctx);
+
+/*  printOptStats() → Prints what the passes did to the Quadruples List  */
+void printOptStats(CompilerContext *ctx);
+
+#endif
@@ -0,0 +1,2436 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 2
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+/* First part of user prologue.  */
+#line 8 "src/parser.y"
+
+
+#include "context.h"
+#include "utils.h"
+
+/*  yyerror() → Print Syntax error messages  */
+static void yyerror(CompilerContext *ctx, const char *msg);
+
+
+
+#line 82 "src/parser.tab.c"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "parser.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_INT = 3,                        /* INT  */
+  YYSYMBOL_VOID = 4,                       /* VOID  */
+  YYSYMBOL_IF = 5,                         /* IF  */
+  YYSYMBOL_WHILE = 6,                      /* WHILE  */
+  YYSYMBOL_RETURN = 7,                     /* RETURN  */
+  YYSYMBOL_AND = 8,                        /* AND  */
+  YYSYMBOL_OR = 9,                         /* OR  */
+  YYSYMBOL_LSHIFT = 10,                    /* LSHIFT  */
+  YYSYMBOL_RSHIFT = 11,                    /* RSHIFT  */
+  YYSYMBOL_MORE = 12,                      /* MORE  */
+  YYSYMBOL_LESS = 13,                      /* LESS  */
+  YYSYMBOL_EQUALMORE = 14,                 /* EQUALMORE  */
+  YYSYMBOL_EQUALLESS = 15,                 /* EQUALLESS  */
+  YYSYMBOL_EQUAL = 16,                     /* EQUAL  */
+  YYSYMBOL_DIFER = 17,                     /* DIFER  */
+  YYSYMBOL_ADD = 18,                       /* ADD  */
+  YYSYMBOL_SUB = 19,                       /* SUB  */
+  YYSYMBOL_MUL = 20,                       /* MUL  */
+  YYSYMBOL_DIV = 21,                       /* DIV  */
+  YYSYMBOL_GET = 22,                       /* GET  */
+  YYSYMBOL_LOWER_THAN_ELSE = 23,           /* LOWER_THAN_ELSE  */
+  YYSYMBOL_ELSE = 24,                      /* ELSE  */
+  YYSYMBOL_COMMA = 25,                     /* COMMA  */
+  YYSYMBOL_SEMI = 26,                      /* SEMI  */
+  YYSYMBOL_OPARENTHESIS = 27,              /* OPARENTHESIS  */
+  YYSYMBOL_CPARENTHESIS = 28,              /* CPARENTHESIS  */
+  YYSYMBOL_OBRACKETS = 29,                 /* OBRACKETS  */
+  YYSYMBOL_CBRACKETS = 30,                 /* CBRACKETS  */
+  YYSYMBOL_OKEYS = 31,                     /* OKEYS  */
+  YYSYMBOL_CKEYS = 32,                     /* CKEYS  */
+  YYSYMBOL_NUM = 33,                       /* NUM  */
+  YYSYMBOL_ID = 34,                        /* ID  */
+  YYSYMBOL_YYACCEPT = 35,                  /* $accept  */
+  YYSYMBOL_program = 36,                   /* program  */
+  YYSYMBOL_declaration_list = 37,          /* declaration_list  */
+  YYSYMBOL_declaration = 38,               /* declaration  */
+  YYSYMBOL_variable_declaration = 39,      /* variable_declaration  */
+  YYSYMBOL_type = 40,                      /* type  */
+  YYSYMBOL_function_declaration = 41,      /* function_declaration  */
+  YYSYMBOL_function_params = 42,           /* function_params  */
+  YYSYMBOL_parameter_list = 43,            /* parameter_list  */
+  YYSYMBOL_parameter = 44,                 /* parameter  */
+  YYSYMBOL_compound_stmt = 45,             /* compound_stmt  */
+  YYSYMBOL_local_declarations = 46,        /* local_declarations  */
+  YYSYMBOL_statement_list = 47,            /* statement_list  */
+  YYSYMBOL_statement = 48,                 /* statement  */
+  YYSYMBOL_expression_stmt = 49,           /* expression_stmt  */
+  YYSYMBOL_selection_stmt = 50,            /* selection_stmt  */
+  YYSYMBOL_iteration_stmt = 51,            /* iteration_stmt  */
+  YYSYMBOL_return_stmt = 52,               /* return_stmt  */
+  YYSYMBOL_expression = 53,                /* expression  */
+  YYSYMBOL_or_expression = 54,             /* or_expression  */
+  YYSYMBOL_and_expression = 55,            /* and_expression  */
+  YYSYMBOL_shift_expression = 56,          /* shift_expression  */
+  YYSYMBOL_shift = 57,                     /* shift  */
+  YYSYMBOL_variable = 58,                  /* variable  */
+  YYSYMBOL_simple_expression = 59,         /* simple_expression  */
+  YYSYMBOL_relational = 60,                /* relational  */
+  YYSYMBOL_add_expression = 61,            /* add_expression  */
+  YYSYMBOL_sum_sub = 62,                   /* sum_sub  */
+  YYSYMBOL_term = 63,                      /* term  */
+  YYSYMBOL_mul_div = 64,                   /* mul_div  */
+  YYSYMBOL_factor = 65,                    /* factor  */
+  YYSYMBOL_call = 66,                      /* call  */
+  YYSYMBOL_args = 67,                      /* args  */
+  YYSYMBOL_argument_list = 68              /* argument_list  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+/* Unqualified %code blocks.  */
+#line 23 "src/parser.y"
+
+  /*  yylex() → Call getToken()  */
+  static int yylex(YYSTYPE *lval, CompilerContext *ctx);
+
+#line 190 "src/parser.tab.c"
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if 1
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_USE_ALLOCA
+#  if YYSTACK_USE_ALLOCA
+#   ifdef __GNUC__
+#    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
+#   else
+#    define YYSTACK_ALLOC alloca
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
+#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
+#    endif
+#   endif
+#  endif
+# endif
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* 1 */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
+      + YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  11
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   149
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  35
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  34
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  76
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  125
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   289
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
+{
+       0,    96,    96,   102,   105,   111,   114,   120,   128,   137,
+     145,   146,   150,   163,   164,   168,   171,   177,   184,   195,
+     201,   206,   214,   221,   227,   234,   240,   241,   242,   243,
+     244,   248,   251,   257,   264,   271,   279,   285,   293,   298,
+     306,   313,   319,   327,   333,   341,   347,   355,   361,   362,
+     366,   373,   384,   392,   398,   399,   400,   401,   402,   403,
+     407,   415,   421,   422,   426,   434,   440,   441,   445,   448,
+     451,   454,   463,   472,   475,   481,   484
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "INT", "VOID", "IF",
+  "WHILE", "RETURN", "AND", "OR", "LSHIFT", "RSHIFT", "MORE", "LESS",
+  "EQUALMORE", "EQUALLESS", "EQUAL", "DIFER", "ADD", "SUB", "MUL", "DIV",
+  "GET", "LOWER_THAN_ELSE", "ELSE", "COMMA", "SEMI", "OPARENTHESIS",
+  "CPARENTHESIS", "OBRACKETS", "CBRACKETS", "OKEYS", "CKEYS", "NUM", "ID",
+  "$accept", "program", "declaration_list", "declaration",
+  "variable_declaration", "type", "function_declaration",
+  "function_params", "parameter_list", "parameter", "compound_stmt",
+  "local_declarations", "statement_list", "statement", "expression_stmt",
+  "selection_stmt", "iteration_stmt", "return_stmt", "expression",
+  "or_expression", "and_expression", "shift_expression", "shift",
+  "variable", "simple_expression", "relational", "add_expression",
+  "sum_sub", "term", "mul_div", "factor", "call", "args", "argument_list", YY_NULLPTR
+};
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-45)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-26)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int8 yypact[] =
+{
+      99,   -18,   -45,   -45,    24,    95,   -45,   -45,   -14,   -45,
+     -45,   -45,   -45,    78,   -45,    81,    19,    31,    63,    73,
+      88,   -45,    86,    89,    90,   106,    93,    87,     0,   -45,
+     -45,   -45,   -45,    92,     9,   -45,    25,   -45,    94,    39,
+     -45,    52,    20,    21,    35,   -45,   -16,   -45,   -45,    79,
+     -45,   -45,   -45,   -45,   -45,   -45,    97,   111,   114,    28,
+     103,   -45,    75,    91,   -45,   -45,    98,   -16,   101,   -16,
+     -45,   104,   105,   -16,   -16,   -45,   -16,   -16,   -45,   -45,
+     -16,   -16,   -45,   -45,   -45,   -45,   -45,   -45,   -45,   -45,
+     -16,   -16,   -45,   -45,   -16,    49,   107,    49,   108,   -45,
+     -45,   -45,   109,   102,   110,   114,   -45,    28,   -45,   -45,
+      96,    91,   -45,   -45,    49,   -45,    49,   -45,   -16,   -45,
+     115,   -45,   -45,    49,   -45
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
+{
+       0,     0,    10,    11,     0,     0,     4,     5,     0,     6,
+       9,     1,     3,     0,     7,     0,     0,    11,     0,     0,
+      13,    16,     0,    17,     0,     0,     0,     0,     0,    12,
+      15,     8,    18,     0,     0,    21,     0,    22,     0,     0,
+      20,     0,     0,     0,     0,    32,     0,    19,    71,    50,
+      27,    24,    26,    28,    29,    30,     0,    41,    43,    45,
+      69,    47,    53,    61,    65,    70,     0,     0,     0,     0,
+      38,     0,     0,    74,     0,    31,     0,     0,    48,    49,
+       0,     0,    54,    55,    56,    57,    58,    59,    62,    63,
+       0,     0,    66,    67,     0,     0,     0,     0,     0,    39,
+      68,    76,     0,    73,     0,    42,    69,    44,    46,    40,
+      52,    60,    64,    35,     0,    37,     0,    72,     0,    51,
+      33,    36,    75,     0,    34
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int8 yypgoto[] =
+{
+     -45,   -45,   -45,   126,   100,    -6,   -45,   -45,   -45,   113,
+     117,   -45,   -45,   -37,   -45,   -45,   -45,   -45,   -44,   -45,
+      56,    65,   -45,   -27,    64,   -45,    53,   -45,    54,   -45,
+      55,   -45,   -45,   -45
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int8 yydefgoto[] =
+{
+       0,     4,     5,     6,     7,     8,     9,    19,    20,    21,
+      50,    34,    39,    51,    52,    53,    54,    55,    56,    57,
+      58,    59,    80,    60,    61,    90,    62,    91,    63,    94,
+      64,    65,   102,   103
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int8 yytable[] =
+{
+      71,    33,    72,   -23,   -23,   -23,   -23,   -23,    10,    18,
+      36,    46,     2,     3,   -25,   -25,   -25,    48,    49,    18,
+      13,    66,    68,    96,    11,    98,   -23,   -23,    38,   101,
+     104,   -23,   -23,   -23,   -23,   -25,   -25,   109,    78,    79,
+     -25,   -25,   -25,   -25,    42,    43,    44,    67,    69,   106,
+     106,    10,    22,   106,    42,    43,    44,    40,   113,   -14,
+     115,    70,    46,   106,   106,    45,    46,   106,    48,    49,
+      28,    47,    48,    49,   122,    45,    46,   120,    14,   121,
+      28,    16,    48,    49,     2,    17,   124,    82,    83,    84,
+      85,    86,    87,    88,    89,    -2,     1,    23,     2,     3,
+       1,    24,     2,     3,    14,    15,    73,    16,    74,     2,
+       3,    92,    93,    25,    88,    89,    26,    32,    27,    31,
+      76,    28,    77,    75,    35,    81,    95,   118,    41,    97,
+      99,    12,   105,   100,    37,   114,   116,   117,    30,   123,
+     119,    29,   107,   110,   108,   111,     0,     0,     0,   112
+};
+
+static const yytype_int8 yycheck[] =
+{
+      44,     1,    46,     3,     4,     5,     6,     7,    26,    15,
+       1,    27,     3,     4,     5,     6,     7,    33,    34,    25,
+      34,     1,     1,    67,     0,    69,    26,    27,    34,    73,
+      74,    31,    32,    33,    34,    26,    27,    81,    10,    11,
+      31,    32,    33,    34,     5,     6,     7,    27,    27,    76,
+      77,    26,    33,    80,     5,     6,     7,    32,    95,    28,
+      97,    26,    27,    90,    91,    26,    27,    94,    33,    34,
+      31,    32,    33,    34,   118,    26,    27,   114,    26,   116,
+      31,    29,    33,    34,     3,     4,   123,    12,    13,    14,
+      15,    16,    17,    18,    19,     0,     1,    34,     3,     4,
+       1,    28,     3,     4,    26,    27,    27,    29,    29,     3,
+       4,    20,    21,    25,    18,    19,    30,    30,    29,    26,
+       9,    31,     8,    26,    32,    22,    28,    25,    34,    28,
+      26,     5,    76,    28,    34,    28,    28,    28,    25,    24,
+      30,    24,    77,    90,    80,    91,    -1,    -1,    -1,    94
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
+{
+       0,     1,     3,     4,    36,    37,    38,    39,    40,    41,
+      26,     0,    38,    34,    26,    27,    29,     4,    40,    42,
+      43,    44,    33,    34,    28,    25,    30,    29,    31,    45,
+      44,    26,    30,     1,    46,    32,     1,    39,    40,    47,
+      32,    34,     5,     6,     7,    26,    27,    32,    33,    34,
+      45,    48,    49,    50,    51,    52,    53,    54,    55,    56,
+      58,    59,    61,    63,    65,    66,     1,    27,     1,    27,
+      26,    53,    53,    27,    29,    26,     9,     8,    10,    11,
+      57,    22,    12,    13,    14,    15,    16,    17,    18,    19,
+      60,    62,    20,    21,    64,    28,    53,    28,    53,    26,
+      28,    53,    67,    68,    53,    55,    58,    56,    59,    53,
+      61,    63,    65,    48,    28,    48,    28,    28,    25,    30,
+      48,    48,    53,    24,    48
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    35,    36,    37,    37,    38,    38,    39,    39,    39,
+      40,    40,    41,    42,    42,    43,    43,    44,    44,    45,
+      45,    45,    46,    46,    47,    47,    48,    48,    48,    48,
+      48,    49,    49,    50,    50,    50,    51,    51,    52,    52,
+      53,    53,    54,    54,    55,    55,    56,    56,    57,    57,
+      58,    58,    59,    59,    60,    60,    60,    60,    60,    60,
+      61,    61,    62,    62,    63,    63,    64,    64,    65,    65,
+      65,    65,    66,    67,    67,    68,    68
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     2,     1,     1,     1,     3,     6,     2,
+       1,     1,     6,     1,     1,     3,     1,     2,     4,     4,
+       4,     3,     2,     0,     2,     0,     1,     1,     1,     1,
+       1,     2,     1,     5,     7,     4,     5,     4,     2,     3,
+       3,     1,     3,     1,     3,     1,     3,     1,     1,     1,
+       1,     4,     3,     1,     1,     1,     1,     1,     1,     1,
+       3,     1,     1,     1,     3,     1,     1,     1,     3,     1,
+       1,     1,     4,     1,     0,     3,     1
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (ctx, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, ctx); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, CompilerContext *ctx)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (ctx);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, CompilerContext *ctx)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  yy_symbol_value_print (yyo, yykind, yyvaluep, ctx);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, CompilerContext *ctx)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], ctx);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule, ctx); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
+
+
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
+/* Return the length of YYSTR.  */
+static YYPTRDIFF_T
+yystrlen (const char *yystr)
+{
+  YYPTRDIFF_T yylen;
+  for (yylen = 0; yystr[yylen]; yylen++)
+    continue;
+  return yylen;
+}
+# endif
+#endif
+
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
+/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
+   YYDEST.  */
+static char *
+yystpcpy (char *yydest, const char *yysrc)
+{
+  char *yyd = yydest;
+  const char *yys = yysrc;
+
+  while ((*yyd++ = *yys++) != '\0')
+    continue;
+
+  return yyd - 1;
+}
+# endif
+#endif
+
+#ifndef yytnamerr
+/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
+   quotes and backslashes, so that it's suitable for yyerror.  The
+   heuristic is that double-quoting is unnecessary unless the string
+   contains an apostrophe, a comma, or backslash (other than
+   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
+   null, do not copy; instead, return the length of what the result
+   would have been.  */
+static YYPTRDIFF_T
+yytnamerr (char *yyres, const char *yystr)
+{
+  if (*yystr == '"')
+    {
+      YYPTRDIFF_T yyn = 0;
+      char const *yyp = yystr;
+      for (;;)
+        switch (*++yyp)
+          {
+          case '\'':
+          case ',':
+            goto do_not_strip_quotes;
+
+          case '\\':
+            if (*++yyp != '\\')
+              goto do_not_strip_quotes;
+            else
+              goto append;
+
+          append:
+          default:
+            if (yyres)
+              yyres[yyn] = *yyp;
+            yyn++;
+            break;
+
+          case '"':
+            if (yyres)
+              yyres[yyn] = '\0';
+            return yyn;
+          }
+    do_not_strip_quotes: ;
+    }
+
+  if (yyres)
+    return yystpcpy (yyres, yystr) - yyres;
+  else
+    return yystrlen (yystr);
+}
+#endif
+
+
+static int
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  /* There are many possibilities here to consider:
+     - If this state is a consistent state with a default action, then
+       the only way this function was invoked is if the default action
+       is an error action.  In that case, don't check for expected
+       tokens because there are none.
+     - The only way there can be no lookahead present (in yychar) is if
+       this state is a consistent state with a default action.  Thus,
+       detecting the absence of a lookahead is sufficient to determine
+       that there is no unexpected or expected token to report.  In that
+       case, just report a simple "syntax error".
+     - Don't assume there isn't a lookahead just because this state is a
+       consistent state with a default action.  There might have been a
+       previous inconsistent state, consistent state with a non-default
+       action, or user semantic action that manipulated yychar.
+     - Of course, the expected token list depends on states to have
+       correct lookahead information, and it depends on the parser not
+       to perform extra reductions after fetching a lookahead from the
+       scanner and before detecting a syntax error.  Thus, state merging
+       (from LALR or IELR) and default reductions corrupt the expected
+       token list.  However, the list is correct for canonical LR with
+       one exception: it will still contain any token that will not be
+       accepted due to an error action in a later state.
+  */
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
+    {
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
+    }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
+
+  switch (yycount)
+    {
+#define YYCASE_(N, S)                       \
+      case N:                               \
+        yyformat = S;                       \
+        break
+    default: /* Avoid compiler warnings. */
+      YYCASE_(0, YY_("syntax error"));
+      YYCASE_(1, YY_("syntax error, unexpected %s"));
+      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
+      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
+      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
+      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
+#undef YYCASE_
+    }
+
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
+  {
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
+  }
+
+  if (*yymsg_alloc < yysize)
+    {
+      *yymsg_alloc = 2 * yysize;
+      if (! (yysize <= *yymsg_alloc
+             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
+        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
+      return -1;
+    }
+
+  /* Avoid sprintf, as that infringes on the user's name space.
+     Don't have undefined behavior even if the translation
+     produced a string with the wrong number of "%s"s.  */
+  {
+    char *yyp = *yymsg;
+    int yyi = 0;
+    while ((*yyp = *yyformat) != '\0')
+      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
+        {
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
+          yyformat += 2;
+        }
+      else
+        {
+          ++yyp;
+          ++yyformat;
+        }
+  }
+  return 0;
+}
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, CompilerContext *ctx)
+{
+  YY_USE (yyvaluep);
+  YY_USE (ctx);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (CompilerContext *ctx)
+{
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+
+  /* Buffer for error messages, and its allocated size.  */
+  char yymsgbuf[128];
+  char *yymsg = yymsgbuf;
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, ctx);
+    }
+
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 2: /* program: declaration_list  */
+#line 96 "src/parser.y"
+                   {
+    ctx->abstractSyntaxTree = (yyvsp[0].node);
+  }
+#line 1515 "src/parser.tab.c"
+    break;
+
+  case 3: /* declaration_list: declaration_list declaration  */
+#line 102 "src/parser.y"
+                               {
+    (yyval.node) = addSibling((yyvsp[-1].node), (yyvsp[0].node));
+  }
+#line 1523 "src/parser.tab.c"
+    break;
+
+  case 4: /* declaration_list: declaration  */
+#line 105 "src/parser.y"
+              {
+    (yyval.node) = (yyvsp[0].node);
+  }
+#line 1531 "src/parser.tab.c"
+    break;
+
+  case 5: /* declaration: variable_declaration  */
+#line 111 "src/parser.y"
+                       {
+    (yyval.node) = (yyvsp[0].node);
+  }
+#line 1539 "src/parser.tab.c"
+    break;
+
+  case 6: /* declaration: function_declaration  */
+#line 114 "src/parser.y"
+                       {
+    (yyval.node) = (yyvsp[0].node);
+  }
+#line 1547 "src/parser.tab.c"
+    break;
+
+  case 7: /* variable_declaration: type ID SEMI  */
+#line 120 "src/parser.y"
+               {
+    TreeNode *t = newDeclNode(ctx, DeclVariable);
+    t->type = (yyvsp[-2].type);
+    t->flags.isArray = false;
+    t->attr.name = (yyvsp[-1].id).name;
+    t->scope = ctx->globalScope;
+    (yyval.node) = t;
+  }
+#line 1560 "src/parser.tab.c"
+    break;
+
+  case 8: /* variable_declaration: type ID OBRACKETS NUM CBRACKETS SEMI  */
+#line 128 "src/parser.y"
+                                       {
+    TreeNode *t = newDeclNode(ctx, DeclArray);
+    t->type = (yyvsp[-5].type);
+    t->flags.isArray = true;
+    t->attr.arrayAttr.name = (yyvsp[-4].id).name;
+    t->attr.arrayAttr.size = (yyvsp[-2].num);
+    t->scope = ctx->globalScope;
+    (yyval.node) = t;
+  }
+#line 1574 "src/parser.tab.c"
+    break;
+
+  case 9: /* variable_declaration: error SEMI  */
+#line 137 "src/parser.y"
+             {
+    yyerror(ctx, "Invalid variable declaration");
+    yyerrok;
+    (yyval.node) = NULL;
+  }
+#line 1584 "src/parser.tab.c"
+    break;
+
+  case 10: /* type: INT  */
+#line 145 "src/parser.y"
+        { (yyval.type) = Integer; }
+#line 1590 "src/parser.tab.c"
+    break;
+
+  case 11: /* type: VOID  */
+#line 146 "src/parser.y"
+        { (yyval.type) = Void; }
+#line 1596 "src/parser.tab.c"
+    break;
+
+  case 12: /* function_declaration: type ID OPARENTHESIS function_params CPARENTHESIS compound_stmt  */
+#line 150 "src/parser.y"
+                                                                  {
+    TreeNode *t = newDeclNode(ctx, DeclFunction);
+    t->type = (yyvsp[-5].type);
+    t->attr.name = (yyvsp[-4].id).name;
+    t->scope = ctx->globalScope;
+    t->lineno = (yyvsp[-4].id).lineno; 
+    insertScope(t->child[0] = (yyvsp[-2].node), t->attr.name);
+    insertScope(t->child[1] = (yyvsp[0].node), t->attr.name);
+    (yyval.node) = t;
+  }
+#line 1611 "src/parser.tab.c"
+    break;
+
+  case 13: /* function_params: parameter_list  */
+#line 163 "src/parser.y"
+                  { (yyval.node) = (yyvsp[0].node); }
+#line 1617 "src/parser.tab.c"
+    break;
+
+  case 14: /* function_params: VOID  */
+#line 164 "src/parser.y"
+        { (yyval.node) = NULL; }
+#line 1623 "src/parser.tab.c"
+    break;
+
+  case 15: /* parameter_list: parameter_list COMMA parameter  */
+#line 168 "src/parser.y"
+                                 {
+    (yyval.node) = addSibling((yyvsp[-2].node), (yyvsp[0].node));
+  }
+#line 1631 "src/parser.tab.c"
+    break;
+
+  case 16: /* parameter_list: parameter  */
+#line 171 "src/parser.y"
+            {
+    (yyval.node) = (yyvsp[0].node);
+  }
+#line 1639 "src/parser.tab.c"
+    break;
+
+  case 17: /* parameter: type ID  */
+#line 177 "src/parser.y"
+          {
+    TreeNode *t = newDeclNode(ctx, DeclParameter);
+    t->type = (yyvsp[-1].type);
+    t->flags.isArray = false;
+    t->attr.name = (yyvsp[0].id).name;
+    (yyval.node) = t;
+  }
+#line 1651 "src/parser.tab.c"
+    break;
+
+  case 18: /* parameter: type ID OBRACKETS CBRACKETS  */
+#line 184 "src/parser.y"
+                              {
+    TreeNode *t = newDeclNode(ctx, DeclParameter);
+    t->type = (yyvsp[-3].type);
+    t->flags.isArray = true;
+    t->attr.arrayAttr.name = (yyvsp[-2].id).name;
+    t->attr.arrayAttr.size = 0;
+    (yyval.node) = t;
+  }
+#line 1664 "src/parser.tab.c"
+    break;
+
+  case 19: /* compound_stmt: OKEYS local_declarations statement_list CKEYS  */
+#line 195 "src/parser.y"
+                                              {
+    TreeNode *t = newStmtNode(ctx, StmtCompound);
+    t->child[0] = (yyvsp[-2].node);
+    t->child[1] = (yyvsp[-1].node);
+    (yyval.node) = t;
+  }
+#line 1675 "src/parser.tab.c"
+    break;
+
+  case 20: /* compound_stmt: OKEYS local_declarations error CKEYS  */
+#line 201 "src/parser.y"
+                                       {
+      yyerror(ctx, "Invalid compound statement → error in statements");
+      yyerrok;
+      (yyval.node) = NULL;
+  }
+#line 1685 "src/parser.tab.c"
+    break;
+
+  case 21: /* compound_stmt: OKEYS error CKEYS  */
+#line 206 "src/parser.y"
+                    {
+      yyerror(ctx, "Invalid compound statement → error in statements");
+      yyerrok;
+      (yyval.node) = NULL;
+  }
+#line 1695 "src/parser.tab.c"
+    break;
+
+  case 22: /* local_declarations: local_declarations variable_declaration  */
+#line 214 "src/parser.y"
+                                          {
+    if ((yyvsp[-1].node) != NULL) {
+      (yyval.node) = addSibling((yyvsp[-1].node), (yyvsp[0].node));
+    } else {
+      (yyval.node) = (yyvsp[0].node);
+    }
+  }
+#line 1707 "src/parser.tab.c"
+    break;
+
+  case 23: /* local_declarations: %empty  */
+#line 221 "src/parser.y"
+              {
+    (yyval.node) = NULL;
+  }
+#line 1715 "src/parser.tab.c"
+    break;
+
+  case 24: /* statement_list: statement_list statement  */
+#line 227 "src/parser.y"
+                           {
+    if ((yyvsp[-1].node) != NULL) {
+      (yyval.node) = addSibling((yyvsp[-1].node), (yyvsp[0].node));
+    } else {
+      (yyval.node) = (yyvsp[0].node);
+    }
+  }
+#line 1727 "src/parser.tab.c"
+    break;
+
+  case 25: /* statement_list: %empty  */
+#line 234 "src/parser.y"
+              {
+    (yyval.node) = NULL;
+  }
+#line 1735 "src/parser.tab.c"
+    break;
+
+  case 26: /* statement: expression_stmt  */
+#line 240 "src/parser.y"
+                  { (yyval.node) = (yyvsp[0].node); }
+#line 1741 "src/parser.tab.c"
+    break;
+
+  case 27: /* statement: compound_stmt  */
+#line 241 "src/parser.y"
+                  { (yyval.node) = (yyvsp[0].node); }
+#line 1747 "src/parser.tab.c"
+    break;
+
+  case 28: /* statement: selection_stmt  */
+#line 242 "src/parser.y"
+                  { (yyval.node) = (yyvsp[0].node); }
+#line 1753 "src/parser.tab.c"
+    break;
+
+  case 29: /* statement: iteration_stmt  */
+#line 243 "src/parser.y"
+                  { (yyval.node) = (yyvsp[0].node); }
+#line 1759 "src/parser.tab.c"
+    break;
+
+  case 30: /* statement: return_stmt  */
+#line 244 "src/parser.y"
+                  { (yyval.node) = (yyvsp[0].node); }
+#line 1765 "src/parser.tab.c"
+    break;
+
+  case 31: /* expression_stmt: expression SEMI  */
+#line 248 "src/parser.y"
+                  {
+    (yyval.node) = (yyvsp[-1].node);
+  }
+#line 1773 "src/parser.tab.c"
+    break;
+
+  case 32: /* expression_stmt: SEMI  */
+#line 251 "src/parser.y"
+       {
+    (yyval.node) = NULL;
+  }
+#line 1781 "src/parser.tab.c"
+    break;
+
+  case 33: /* selection_stmt: IF OPARENTHESIS expression CPARENTHESIS statement  */
+#line 257 "src/parser.y"
+                                                                         {
+    TreeNode *t = newStmtNode(ctx, StmtIf);
+    t->child[0] = (yyvsp[-2].node);   // if   → ( Expression )
+    t->child[1] = (yyvsp[0].node);   // if   → { Statement }
+    t->child[2] = NULL; // else → NULL
+    (yyval.node) = t;
+  }
+#line 1793 "src/parser.tab.c"
+    break;
+
+  case 34: /* selection_stmt: IF OPARENTHESIS expression CPARENTHESIS statement ELSE statement  */
+#line 264 "src/parser.y"
+                                                                   {
+    TreeNode *t = newStmtNode(ctx, StmtIf);
+    t->child[0] = (yyvsp[-4].node);   // if   → ( Expression )
+    t->child[1] = (yyvsp[-2].node);   // if   → { Statement }
+    t->child[2] = (yyvsp[0].node);   // else → { Statement }
+    (yyval.node) = t;
+  }
+#line 1805 "src/parser.tab.c"
+    break;
+
+  case 35: /* selection_stmt: IF error CPARENTHESIS statement  */
+#line 271 "src/parser.y"
+                                  {
+    yyerror(ctx, "Invalid selection (IF-ELSE) statement");
+    yyerrok;
+    (yyval.node) = NULL;  // Continua o código após o erro
+  }
+#line 1815 "src/parser.tab.c"
+    break;
+
+  case 36: /* iteration_stmt: WHILE OPARENTHESIS expression CPARENTHESIS statement  */
+#line 279 "src/parser.y"
+                                                       {
+    TreeNode *t = newStmtNode(ctx, StmtWhile);
+    t->child[0] = (yyvsp[-2].node);   // while → ( Expression )
+    t->child[1] = (yyvsp[0].node);   // while → { Statement }
+    (yyval.node) = t;
+  }
+#line 1826 "src/parser.tab.c"
+    break;
+
+  case 37: /* iteration_stmt: WHILE error CPARENTHESIS statement  */
+#line 285 "src/parser.y"
+                                     {
+    yyerror(ctx, "Invalid iteration (WHILE) statement");
+    yyerrok;
+    (yyval.node) = NULL;
+  }
+#line 1836 "src/parser.tab.c"
+    break;
+
+  case 38: /* return_stmt: RETURN SEMI  */
+#line 293 "src/parser.y"
+              {
+    TreeNode *t = newStmtNode(ctx, StmtReturn);
+    t->child[0] = NULL; // return → NULL
+    (yyval.node) = t;
+  }
+#line 1846 "src/parser.tab.c"
+    break;
+
+  case 39: /* return_stmt: RETURN expression SEMI  */
+#line 298 "src/parser.y"
+                         {
+    TreeNode *t = newStmtNode(ctx, StmtReturn);
+    t->child[0] = (yyvsp[-1].node);   // return → Expression
+    (yyval.node) = t;
+  }
+#line 1856 "src/parser.tab.c"
+    break;
+
+  case 40: /* expression: variable GET expression  */
+#line 306 "src/parser.y"
+                          {
+    TreeNode *t = newStmtNode(ctx, StmtAssign);
+    t->child[0] = (yyvsp[-2].node);       // Expression → Variable
+    t->attr.operator = GET; // Expression → Operator (=)
+    t->child[1] = (yyvsp[0].node);       // Expression → Expression
+    (yyval.node) = t;
+  }
+#line 1868 "src/parser.tab.c"
+    break;
+
+  case 41: /* expression: or_expression  */
+#line 313 "src/parser.y"
+                {
+    (yyval.node) = (yyvsp[0].node);
+  }
+#line 1876 "src/parser.tab.c"
+    break;
+
+  case 42: /* or_expression: or_expression OR and_expression  */
+#line 319 "src/parser.y"
+                                  {
+    TreeNode *t = newExpNode(ctx, ExpOperator);
+    t->type = Integer;
+    t->child[0] = (yyvsp[-2].node);
+    t->attr.operator = OR;
+    t->child[1] = (yyvsp[0].node);
+    (yyval.node) = t;
+  }
+#line 1889 "src/parser.tab.c"
+    break;
+
+  case 43: /* or_expression: and_expression  */
+#line 327 "src/parser.y"
+                 {
+    (yyval.node) = (yyvsp[0].node);
+  }
+#line 1897 "src/parser.tab.c"
+    break;
+
+  case 44: /* and_expression: and_expression AND shift_expression  */
+#line 333 "src/parser.y"
+                                      {
+    TreeNode *t = newExpNode(ctx, ExpOperator);
+    t->type = Integer;
+    t->child[0] = (yyvsp[-2].node);
+    t->attr.operator = AND;
+    t->child[1] = (yyvsp[0].node);
+    (yyval.node) = t;
+  }
+#line 1910 "src/parser.tab.c"
+    break;
+
+  case 45: /* and_expression: shift_expression  */
+#line 341 "src/parser.y"
+                   {
+    (yyval.node) = (yyvsp[0].node);
+  }
+#line 1918 "src/parser.tab.c"
+    break;
+
+  case 46: /* shift_expression: shift_expression shift simple_expression  */
+#line 347 "src/parser.y"
+                                           {
+    TreeNode *t = newExpNode(ctx, ExpOperator);
+    t->type = Integer;
+    t->child[0] = (yyvsp[-2].node);
+    t->attr.operator = (yyvsp[-1].op);
+    t->child[1] = (yyvsp[0].node);
+    (yyval.node) = t;
+  }
+#line 1931 "src/parser.tab.c"
+    break;
+
+  case 47: /* shift_expression: simple_expression  */
+#line 355 "src/parser.y"
+                    {
+    (yyval.node) = (yyvsp[0].node);
+  }
+#line 1939 "src/parser.tab.c"
+    break;
+
+  case 48: /* shift: LSHIFT  */
+#line 361 "src/parser.y"
+              { (yyval.op) = LSHIFT; }
+#line 1945 "src/parser.tab.c"
+    break;
+
+  case 49: /* shift: RSHIFT  */
+#line 362 "src/parser.y"
+              { (yyval.op) = RSHIFT; }
+#line 1951 "src/parser.tab.c"
+    break;
+
+  case 50: /* variable: ID  */
+#line 366 "src/parser.y"
+     {
+    TreeNode *t = newExpNode(ctx, ExpID);
+    t->type = Integer;
+    t->flags.isArray = false;
+    t->attr.name = (yyvsp[0].id).name;  // Variable → <id> (Name)
+    (yyval.node) = t;
+  }
+#line 1963 "src/parser.tab.c"
+    break;
+
+  case 51: /* variable: ID OBRACKETS expression CBRACKETS  */
+#line 373 "src/parser.y"
+                                    {
+    TreeNode *t = newExpNode(ctx, ExpID);
+    t->type = Integer;
+    t->flags.isArray = true;
+    t->attr.arrayAttr.name = (yyvsp[-3].id).name;  // Variable → <id> (Name)
+    t->child[0] = (yyvsp[-1].node);                          // Variable → [ Expression ]
+    (yyval.node) = t;
+ }
+#line 1976 "src/parser.tab.c"
+    break;
+
+  case 52: /* simple_expression: add_expression relational add_expression  */
+#line 384 "src/parser.y"
+                                           {
+    TreeNode *t = newExpNode(ctx, ExpOperator);
+    t->type = Integer;
+    t->child[0] = (yyvsp[-2].node);       // Simple Expression → Expression
+    t->attr.operator = (yyvsp[-1].op);  // Simple Expression → Relational Symbol
+    t->child[1] = (yyvsp[0].node);       // Simple Expression → Expression
+    (yyval.node) = t;
+  }
+#line 1989 "src/parser.tab.c"
+    break;
+
+  case 53: /* simple_expression: add_expression  */
+#line 392 "src/parser.y"
+                 {
+    (yyval.node) = (yyvsp[0].node);
+  }
+#line 1997 "src/parser.tab.c"
+    break;
+
+  case 54: /* relational: MORE  */
+#line 398 "src/parser.y"
+            { (yyval.op) = MORE; }
+#line 2003 "src/parser.tab.c"
+    break;
+
+  case 55: /* relational: LESS  */
+#line 399 "src/parser.y"
+            { (yyval.op) = LESS; }
+#line 2009 "src/parser.tab.c"
+    break;
+
+  case 56: /* relational: EQUALMORE  */
+#line 400 "src/parser.y"
+            { (yyval.op) = EQUALMORE; }
+#line 2015 "src/parser.tab.c"
+    break;
+
+  case 57: /* relational: EQUALLESS  */
+#line 401 "src/parser.y"
+            { (yyval.op) = EQUALLESS; }
+#line 2021 "src/parser.tab.c"
+    break;
+
+  case 58: /* relational: EQUAL  */
+#line 402 "src/parser.y"
+            { (yyval.op) = EQUAL; }
+#line 2027 "src/parser.tab.c"
+    break;
+
+  case 59: /* relational: DIFER  */
+#line 403 "src/parser.y"
+            { (yyval.op) = DIFER; }
+#line 2033 "src/parser.tab.c"
+    break;
+
+  case 60: /* add_expression: add_expression sum_sub term  */
+#line 407 "src/parser.y"
+                              {
+    TreeNode *t = newExpNode(ctx, ExpOperator);
+    t->type = Integer;
+    t->child[0] = (yyvsp[-2].node);       // Add Expression → Add Expression
+    t->attr.operator = (yyvsp[-1].op);  // Add Expression → Operator (+ or -)
+    t->child[1] = (yyvsp[0].node);       // Add Expression → Term
+    (yyval.node) = t;
+  }
+#line 2046 "src/parser.tab.c"
+    break;
+
+  case 61: /* add_expression: term  */
+#line 415 "src/parser.y"
+       {
+    (yyval.node) = (yyvsp[0].node);
+  }
+#line 2054 "src/parser.tab.c"
+    break;
+
+  case 62: /* sum_sub: ADD  */
+#line 421 "src/parser.y"
+      { (yyval.op) = ADD; }
+#line 2060 "src/parser.tab.c"
+    break;
+
+  case 63: /* sum_sub: SUB  */
+#line 422 "src/parser.y"
+      { (yyval.op) = SUB; }
+#line 2066 "src/parser.tab.c"
+    break;
+
+  case 64: /* term: term mul_div factor  */
+#line 426 "src/parser.y"
+                      {
+    TreeNode *t = newExpNode(ctx, ExpOperator);
+    t->type = Integer;
+    t->child[0] = (yyvsp[-2].node);       // Term → Term
+    t->attr.operator = (yyvsp[-1].op);  // Term → Operator (* or /)
+    t->child[1] = (yyvsp[0].node);       // Term → Factor
+    (yyval.node) = t;
+  }
+#line 2079 "src/parser.tab.c"
+    break;
+
+  case 65: /* term: factor  */
+#line 434 "src/parser.y"
+         {
+    (yyval.node) = (yyvsp[0].node);
+  }
+#line 2087 "src/parser.tab.c"
+    break;
+
+  case 66: /* mul_div: MUL  */
+#line 440 "src/parser.y"
+      { (yyval.op) = MUL; }
+#line 2093 "src/parser.tab.c"
+    break;
+
+  case 67: /* mul_div: DIV  */
+#line 441 "src/parser.y"
+      { (yyval.op) = DIV; }
+#line 2099 "src/parser.tab.c"
+    break;
+
+  case 68: /* factor: OPARENTHESIS expression CPARENTHESIS  */
+#line 445 "src/parser.y"
+                                       {
+    (yyval.node) = (yyvsp[-1].node);
+  }
+#line 2107 "src/parser.tab.c"
+    break;
+
+  case 69: /* factor: variable  */
+#line 448 "src/parser.y"
+           {
+    (yyval.node) = (yyvsp[0].node);
+  }
+#line 2115 "src/parser.tab.c"
+    break;
+
+  case 70: /* factor: call  */
+#line 451 "src/parser.y"
+       {
+    (yyval.node) = (yyvsp[0].node);
+  }
+#line 2123 "src/parser.tab.c"
+    break;
+
+  case 71: /* factor: NUM  */
+#line 454 "src/parser.y"
+      {
+    TreeNode *t = newExpNode(ctx, ExpConst);
+    t->type = Integer;
+    t->attr.value = (yyvsp[0].num);
+    (yyval.node) = t;
+  }
+#line 2134 "src/parser.tab.c"
+    break;
+
+  case 72: /* call: ID OPARENTHESIS args CPARENTHESIS  */
+#line 463 "src/parser.y"
+                                    {
+    TreeNode *t = newExpNode(ctx, ExpCall);
+    t->attr.name = (yyvsp[-3].id).name;
+    t->child[0] = (yyvsp[-1].node); // Call → Arguments
+    (yyval.node) = t;
+  }
+#line 2145 "src/parser.tab.c"
+    break;
+
+  case 73: /* args: argument_list  */
+#line 472 "src/parser.y"
+                {
+    (yyval.node) = (yyvsp[0].node);
+  }
+#line 2153 "src/parser.tab.c"
+    break;
+
+  case 74: /* args: %empty  */
+#line 475 "src/parser.y"
+              {
+    (yyval.node) = NULL;
+  }
+#line 2161 "src/parser.tab.c"
+    break;
+
+  case 75: /* argument_list: argument_list COMMA expression  */
+#line 481 "src/parser.y"
+                                 {
+    (yyval.node) = addSibling((yyvsp[-2].node), (yyvsp[0].node));
+  }
+#line 2169 "src/parser.tab.c"
+    break;
+
+  case 76: /* argument_list: expression  */
+#line 484 "src/parser.y"
+             {
+     (yyval.node) = (yyvsp[0].node);
+  }
+#line 2177 "src/parser.tab.c"
+    break;
+
+
+#line 2181 "src/parser.tab.c"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      {
+        yypcontext_t yyctx
+          = {yyssp, yytoken};
+        char const *yymsgp = YY_("syntax error");
+        int yysyntax_error_status;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+        if (yysyntax_error_status == 0)
+          yymsgp = yymsg;
+        else if (yysyntax_error_status == -1)
+          {
+            if (yymsg != yymsgbuf)
+              YYSTACK_FREE (yymsg);
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
+              {
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
+              }
+            else
+              {
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
+              }
+          }
+        yyerror (ctx, yymsgp);
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
+      }
+    }
+
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, ctx);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, ctx);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (ctx, YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, ctx);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, ctx);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+  if (yymsg != yymsgbuf)
+    YYSTACK_FREE (yymsg);
+  return yyresult;
+}
+
+#line 489 "src/parser.y"
+
+
+/*  traceParser() → Check TraceParse and log the AST  */
+static void traceParser(CompilerContext *ctx) {
+  if (beginTrace(ctx, TraceParse)) {
+    printTree(ctx, ctx->abstractSyntaxTree);
+    endTrace(ctx);
+  }
+  fprintf(ctx->listing, "\n> Syntax Analysis completed.\n");
+}
+
+ /*  syntaxAnalysis() → Call yyparse() and build the AST ---> Traceable    */
+void syntaxAnalysis(CompilerContext *ctx) {
+  scannerInit(ctx);
+  yyparse(ctx);
+  scannerDestroy(ctx);
+  traceParser(ctx);
+}
+
+/*  yylex() → Call getToken()  */
+static int yylex(YYSTYPE *lval, CompilerContext *ctx) {
+  return getToken(lval, ctx);
+}
+
+/*  yyerror() → Print Syntax error messages  */
+static void yyerror(CompilerContext *ctx, const char *msg) {
+  printBars(ctx); 
+  fprintf(ctx->listing, "> Syntax Error\n     Line %d - %s.", ctx->lineno, msg);
+  printBars(ctx);
+  ctx->failed = true;
+  newLine(ctx);
+}
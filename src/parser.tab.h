@@ -0,0 +1,130 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_SRC_PARSER_TAB_H_INCLUDED
+# define YY_YY_SRC_PARSER_TAB_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 1
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+/* "%code requires" blocks.  */
+#line 19 "src/parser.y"
+
+  #include "globals.h"
+
+#line 53 "src/parser.tab.h"
+
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    INT = 258,                     /* INT  */
+    VOID = 259,                    /* VOID  */
+    IF = 260,                      /* IF  */
+    WHILE = 261,                   /* WHILE  */
+    RETURN = 262,                  /* RETURN  */
+    AND = 263,                     /* AND  */
+    OR = 264,                      /* OR  */
+    LSHIFT = 265,                  /* LSHIFT  */
+    RSHIFT = 266,                  /* RSHIFT  */
+    MORE = 267,                    /* MORE  */
+    LESS = 268,                    /* LESS  */
+    EQUALMORE = 269,               /* EQUALMORE  */
+    EQUALLESS = 270,               /* EQUALLESS  */
+    EQUAL = 271,                   /* EQUAL  */
+    DIFER = 272,                   /* DIFER  */
+    ADD = 273,                     /* ADD  */
+    SUB = 274,                     /* SUB  */
+    MUL = 275,                     /* MUL  */
+    DIV = 276,                     /* DIV  */
+    GET = 277,                     /* GET  */
+    LOWER_THAN_ELSE = 278,         /* LOWER_THAN_ELSE  */
+    ELSE = 279,                    /* ELSE  */
+    COMMA = 280,                   /* COMMA  */
+    SEMI = 281,                    /* SEMI  */
+    OPARENTHESIS = 282,            /* OPARENTHESIS  */
+    CPARENTHESIS = 283,            /* CPARENTHESIS  */
+    OBRACKETS = 284,               /* OBRACKETS  */
+    CBRACKETS = 285,               /* CBRACKETS  */
+    OKEYS = 286,                   /* OKEYS  */
+    CKEYS = 287,                   /* CKEYS  */
+    NUM = 288,                     /* NUM  */
+    ID = 289                       /* ID  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+union YYSTYPE
+{
+#line 35 "src/parser.y"
+
+  int op;
+  int num;
+
+  struct {
+    char *name;
+    int lineno;
+  } id;
+  
+  TreeNode *node;
+  ExpType type;
+
+#line 117 "src/parser.tab.h"
+
+};
+typedef union YYSTYPE YYSTYPE;
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
+#endif
+
+
+
+
+int yyparse (CompilerContext *ctx);
+
+
+#endif /* !YY_YY_SRC_PARSER_TAB_H_INCLUDED  */
@@ -7,20 +7,12 @@
 
 %{
 
-#include "globals.h"
+#include "context.h"
 #include "utils.h"
 
-/*  yylex() → Call getToken()  */
-static int yylex(void);
-
 /*  yyerror() → Print Syntax error messages  */
-static void yyerror(const char *msg);
+static void yyerror(CompilerContext *ctx, const char *msg);
 
-/*  globalScope → Global scope of analyzed tree node  */
-char *globalScope = "global";
-
-/*  AbstractSyntaxTree → Pointer to TreeNode base of Abstract Syntax Tree    */
-TreeNode *abstractSyntaxTree;
 
 %}
 
@@ -28,6 +20,15 @@ TreeNode *abstractSyntaxTree;
   #include "globals.h"
 }
 
+%code {
+  /*  yylex() → Call getToken()  */
+  static int yylex(YYSTYPE *lval, CompilerContext *ctx);
+}
+
+%define api.pure full
+%parse-param {CompilerContext *ctx}
+%lex-param {CompilerContext *ctx}
+
 %define parse.error verbose
 %expect 1
 
@@ -93,7 +94,7 @@ TreeNode *abstractSyntaxTree;
 
 program:
   declaration_list {
-    abstractSyntaxTree = $1;
+    ctx->abstractSyntaxTree = $1;
   }
 ;
 
@@ -117,24 +118,24 @@ declaration:
 
 variable_declaration:
   type ID SEMI {
-    TreeNode *t = newDeclNode(DeclVariable);
+    TreeNode *t = newDeclNode(ctx, DeclVariable);
     t->type = $1;
     t->flags.isArray = false;
-    t->attr.name = strdup($2.name);
-    t->scope = strdup(globalScope);
+    t->attr.name = $2.name;
+    t->scope = ctx->globalScope;
     $$ = t;
   }
 | type ID OBRACKETS NUM CBRACKETS SEMI {
-    TreeNode *t = newDeclNode(DeclArray);
+    TreeNode *t = newDeclNode(ctx, DeclArray);
     t->type = $1;
     t->flags.isArray = true;
-    t->attr.arrayAttr.name = strdup($2.name);
+    t->attr.arrayAttr.name = $2.name;
     t->attr.arrayAttr.size = $4;
-    t->scope = strdup(globalScope);
+    t->scope = ctx->globalScope;
     $$ = t;
   }
 | error SEMI {
-    yyerror("Invalid variable declaration");
+    yyerror(ctx, "Invalid variable declaration");
     yyerrok;
     $$ = NULL;
   }
@@ -147,10 +148,10 @@ type:
 
 function_declaration:
   type ID OPARENTHESIS function_params CPARENTHESIS compound_stmt {
-    TreeNode *t = newDeclNode(DeclFunction);
+    TreeNode *t = newDeclNode(ctx, DeclFunction);
     t->type = $1;
-    t->attr.name = strdup($2.name);
-    t->scope = strdup("global");
+    t->attr.name = $2.name;
+    t->scope = ctx->globalScope;
     t->lineno = $2.lineno; 
     insertScope(t->child[0] = $4, t->attr.name);
     insertScope(t->child[1] = $6, t->attr.name);
@@ -174,34 +175,36 @@ parameter_list:
 
 parameter:
   type ID {
-    TreeNode *t = newDeclNode(DeclParameter);
+    TreeNode *t = newDeclNode(ctx, DeclParameter);
     t->type = $1;
-    t->attr.name = strdup($2.name);
+    t->flags.isArray = false;
+    t->attr.name = $2.name;
     $$ = t;
   }
 | type ID OBRACKETS CBRACKETS {
-    TreeNode *t = newDeclNode(DeclParameter);
+    TreeNode *t = newDeclNode(ctx, DeclParameter);
     t->type = $1;
     t->flags.isArray = true;
-    t->attr.arrayAttr.name = strdup($2.name);
+    t->attr.arrayAttr.name = $2.name;
+    t->attr.arrayAttr.size = 0;
     $$ = t;
   }
 ;
 
 compound_stmt:
 OKEYS local_declarations statement_list CKEYS {
-    TreeNode *t = newStmtNode(StmtCompound);
+    TreeNode *t = newStmtNode(ctx, StmtCompound);
     t->child[0] = $2;
     t->child[1] = $3;
     $$ = t;
   }
 | OKEYS local_declarations error CKEYS {
-      yyerror("Invalid compound statement → error in statements");
+      yyerror(ctx, "Invalid compound statement → error in statements");
       yyerrok;
       $$ = NULL;
   }
 | OKEYS error CKEYS {
-      yyerror("Invalid compound statement → error in statements");
+      yyerror(ctx, "Invalid compound statement → error in statements");
       yyerrok;
       $$ = NULL;
   }
@@ -252,21 +255,21 @@ expression_stmt:
 
 selection_stmt:
   IF OPARENTHESIS expression CPARENTHESIS statement %prec LOWER_THAN_ELSE{
-    TreeNode *t = newStmtNode(StmtIf);
+    TreeNode *t = newStmtNode(ctx, StmtIf);
     t->child[0] = $3;   // if   → ( Expression )
     t->child[1] = $5;   // if   → { Statement }
     t->child[2] = NULL; // else → NULL
     $$ = t;
   }
 | IF OPARENTHESIS expression CPARENTHESIS statement ELSE statement {
-    TreeNode *t = newStmtNode(StmtIf);
+    TreeNode *t = newStmtNode(ctx, StmtIf);
     t->child[0] = $3;   // if   → ( Expression )
     t->child[1] = $5;   // if   → { Statement }
     t->child[2] = $7;   // else → { Statement }
     $$ = t;
   }
 | IF error CPARENTHESIS statement {
-    yyerror("Invalid selection (IF-ELSE) statement");
+    yyerror(ctx, "Invalid selection (IF-ELSE) statement");
     yyerrok;
     $$ = NULL;  // Continua o código após o erro
   }
@@ -274,13 +277,13 @@ selection_stmt:
 
 iteration_stmt:
   WHILE OPARENTHESIS expression CPARENTHESIS statement {
-    TreeNode *t = newStmtNode(StmtWhile);
+    TreeNode *t = newStmtNode(ctx, StmtWhile);
     t->child[0] = $3;   // while → ( Expression )
     t->child[1] = $5;   // while → { Statement }
     $$ = t;
   }
 | WHILE error CPARENTHESIS statement {
-    yyerror("Invalid iteration (WHILE) statement");
+    yyerror(ctx, "Invalid iteration (WHILE) statement");
     yyerrok;
     $$ = NULL;
   }
@@ -288,12 +291,12 @@ iteration_stmt:
 
 return_stmt:
   RETURN SEMI {
-    TreeNode *t = newStmtNode(StmtReturn);
+    TreeNode *t = newStmtNode(ctx, StmtReturn);
     t->child[0] = NULL; // return → NULL
     $$ = t;
   }
 | RETURN expression SEMI {
-    TreeNode *t = newStmtNode(StmtReturn);
+    TreeNode *t = newStmtNode(ctx, StmtReturn);
     t->child[0] = $2;   // return → Expression
     $$ = t;
   }
@@ -301,7 +304,7 @@ return_stmt:
 
 expression:
   variable GET expression {
-    TreeNode *t = newStmtNode(StmtAssign);
+    TreeNode *t = newStmtNode(ctx, StmtAssign);
     t->child[0] = $1;       // Expression → Variable
     t->attr.operator = GET; // Expression → Operator (=)
     t->child[1] = $3;       // Expression → Expression
@@ -314,7 +317,7 @@ expression:
 
 or_expression:
   or_expression OR and_expression {
-    TreeNode *t = newExpNode(ExpOperator);
+    TreeNode *t = newExpNode(ctx, ExpOperator);
     t->type = Integer;
     t->child[0] = $1;
     t->attr.operator = OR;
@@ -328,7 +331,7 @@ or_expression:
 
 and_expression:
   and_expression AND shift_expression {
-    TreeNode *t = newExpNode(ExpOperator);
+    TreeNode *t = newExpNode(ctx, ExpOperator);
     t->type = Integer;
     t->child[0] = $1;
     t->attr.operator = AND;
@@ -342,7 +345,7 @@ and_expression:
 
 shift_expression:
   shift_expression shift simple_expression {
-    TreeNode *t = newExpNode(ExpOperator);
+    TreeNode *t = newExpNode(ctx, ExpOperator);
     t->type = Integer;
     t->child[0] = $1;
     t->attr.operator = $2;
@@ -361,17 +364,17 @@ shift:
 
 variable:
   ID {
-    TreeNode *t = newExpNode(ExpID);
+    TreeNode *t = newExpNode(ctx, ExpID);
     t->type = Integer;
     t->flags.isArray = false;
-    t->attr.name = strdup($1.name);  // Variable → <id> (Name)
+    t->attr.name = $1.name;  // Variable → <id> (Name)
     $$ = t;
   }
 | ID OBRACKETS expression CBRACKETS {
-    TreeNode *t = newExpNode(ExpID);
+    TreeNode *t = newExpNode(ctx, ExpID);
     t->type = Integer;
     t->flags.isArray = true;
-    t->attr.arrayAttr.name = strdup($1.name);  // Variable → <id> (Name)
+    t->attr.arrayAttr.name = $1.name;  // Variable → <id> (Name)
     t->child[0] = $3;                          // Variable → [ Expression ]
     $$ = t;
  }
@@ -379,7 +382,7 @@ variable:
 
 simple_expression:
   add_expression relational add_expression {
-    TreeNode *t = newExpNode(ExpOperator);
+    TreeNode *t = newExpNode(ctx, ExpOperator);
     t->type = Integer;
     t->child[0] = $1;       // Simple Expression → Expression
     t->attr.operator = $2;  // Simple Expression → Relational Symbol
@@ -402,7 +405,7 @@ relational:
 
 add_expression:
   add_expression sum_sub term {
-    TreeNode *t = newExpNode(ExpOperator);
+    TreeNode *t = newExpNode(ctx, ExpOperator);
     t->type = Integer;
     t->child[0] = $1;       // Add Expression → Add Expression
     t->attr.operator = $2;  // Add Expression → Operator (+ or -)
@@ -421,7 +424,7 @@ sum_sub:
 
 term:
   term mul_div factor {
-    TreeNode *t = newExpNode(ExpOperator);
+    TreeNode *t = newExpNode(ctx, ExpOperator);
     t->type = Integer;
     t->child[0] = $1;       // Term → Term
     t->attr.operator = $2;  // Term → Operator (* or /)
@@ -449,7 +452,7 @@ factor:
     $$ = $1;
   }
 | NUM {
-    TreeNode *t = newExpNode(ExpConst);
+    TreeNode *t = newExpNode(ctx, ExpConst);
     t->type = Integer;
     t->attr.value = $1;
     $$ = t;
@@ -458,8 +461,8 @@ factor:
 
 call:
   ID OPARENTHESIS args CPARENTHESIS {
-    TreeNode *t = newExpNode(ExpCall);
-    t->attr.name = strdup($1.name);
+    TreeNode *t = newExpNode(ctx, ExpCall);
+    t->attr.name = $1.name;
     t->child[0] = $3; // Call → Arguments
     $$ = t;
   }
@@ -485,34 +488,33 @@ argument_list:
 
 %%
 
-/*  traceParser() → Check TraceParse and print out the AST  */
-static void traceParser(void) {
-  if (TraceParse) {
-    newLine();
-    printf("> Syntax Analysis ----------------------------------------------------------");
-    printBars();
-    printTree(abstractSyntaxTree);
-    printf("\n> END OF FILE → (EOF)\n");
-  } else {
-    printf("\n> Syntax Analysis completed.\n");
+/*  traceParser() → Check TraceParse and log the AST  */
+static void traceParser(CompilerContext *ctx) {
+  if (beginTrace(ctx, TraceParse)) {
+    printTree(ctx, ctx->abstractSyntaxTree);
+    endTrace(ctx);
   }
+  fprintf(ctx->listing, "\n> Syntax Analysis completed.\n");
 }
 
  /*  syntaxAnalysis() → Call yyparse() and build the AST ---> Traceable    */
-void syntaxAnalysis(void) {
-  yyparse();
-  traceParser();
+void syntaxAnalysis(CompilerContext *ctx) {
+  scannerInit(ctx);
+  yyparse(ctx);
+  scannerDestroy(ctx);
+  traceParser(ctx);
 }
 
 /*  yylex() → Call getToken()  */
-static int yylex(void) {
-  return getToken();
+static int yylex(YYSTYPE *lval, CompilerContext *ctx) {
+  return getToken(lval, ctx);
 }
 
 /*  yyerror() → Print Syntax error messages  */
-static void yyerror(const char *msg) {
-  printBars(); 
-  printf("> Syntax Error\n     Line %d - %s.", yylineno, msg);
-  printBars();
-  newLine();
+static void yyerror(CompilerContext *ctx, const char *msg) {
+  printBars(ctx); 
+  fprintf(ctx->listing, "> Syntax Error\n     Line %d - %s.", ctx->lineno, msg);
+  printBars(ctx);
+  ctx->failed = true;
+  newLine(ctx);
 }
\ No newline at end of file
@@ -0,0 +1,589 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Register Allocator (liveness analysis + linear scan) for a C- Compiler
+ *  File: reg_alloc.c
+ *---------------------------------*/
+
+#include "context.h"
+#include "cfg.h"
+#include "utils.h"
+
+#include <limits.h>
+#include <stdint.h>
+
+/*--------------------------------------------/
+ *  Function being allocated
+ *---------------------------------*/
+
+/*  Interval → Lifetime of a temporary, in positions (2 * quad for reads, 2 * quad + 1 for writes, so that a quadruple
+ *  may write the register its last read operand frees), and where it ended up  */
+typedef struct {
+    int start, end;
+    int reg;
+    int slot;
+    bool pinned;
+} Interval;
+
+/*  Liveness → Sets (bitsets over the function temporaries) of one basic block  */
+typedef struct {
+    uint64_t *use, *def, *in, *out;
+} Liveness;
+
+/*  Function → Quadruples [first, last] of one function (FunBGN to FunEND) and its temporaries, renumbered 0..count-1
+ *  through "index" (indexed by temporary, -1 for those of other functions)  */
+typedef struct {
+    QuadBuffer *quads;
+    int first, last;
+    int *index, count;
+
+    CFG cfg;
+    Liveness *live;
+    int words;
+
+    Interval *intervals;
+    int spilled;
+} Function;
+
+/*  tempOf() → Index (inside the function) of the temporary at an operand, or -1  */
+static int tempOf(Function *f, Address *a) {
+    return (a->type == addrTemp) ? f->index[a->content.value] : -1;
+}
+
+/*  isUserCall() → Whether the quadruple calls a user function (predefined ones are lowered inline and keep r6–r25)  */
+static bool isUserCall(CompilerContext *ctx, QuadBuffer *q, int i) {
+    if (q->op[i] != Call) return false;
+    if (q->src[i].symbolId == NO_SYMBOL) return true;
+
+    return ctx->symbolTable.symbols[q->src[i].symbolId]->builtin == NotBuiltin;
+}
+
+#define BIT_SET(set, i)   ((set)[(i) >> 6] |= (uint64_t)1 << ((i) & 63))
+#define BIT_CLEAR(set, i) ((set)[(i) >> 6] &= ~((uint64_t)1 << ((i) & 63)))
+#define BIT_TEST(set, i)  (((set)[(i) >> 6] >> ((i) & 63)) & 1)
+
+/*  computeLiveness() → Backward dataflow over the blocks: in = use ∪ (out − def), out = ∪ in(successors)  */
+static void computeLiveness(Function *f) {
+    QuadBuffer *q = f->quads;
+    int words = f->words = (f->count + 63) / 64;
+    uint64_t *sets = allocOrDie(4 * (size_t)f->cfg.count * words * sizeof(uint64_t));
+
+    f->live = allocOrDie(f->cfg.count * sizeof(Liveness));
+
+    for (int b = 0; b < f->cfg.count; b++) {
+        BasicBlock *block = &f->cfg.blocks[b];
+        Liveness *l = &f->live[b];
+
+        l->use = sets + (4 * (size_t)b) * words;
+        l->def = l->use + words;
+        l->in = l->def + words;
+        l->out = l->in + words;
+
+        for (int i = block->first; i <= block->last; i++) {
+            int roles = operandRoles(q->op[i]);
+            int t;
+
+            if ((roles & USE_SRC) && (t = tempOf(f, &q->src[i])) >= 0 && !BIT_TEST(l->def, t)) BIT_SET(l->use, t);
+            if ((roles & USE_TGT) && (t = tempOf(f, &q->tgt[i])) >= 0 && !BIT_TEST(l->def, t)) BIT_SET(l->use, t);
+            if ((roles & USE_DST) && (t = tempOf(f, &q->dst[i])) >= 0 && !BIT_TEST(l->def, t)) BIT_SET(l->use, t);
+            if ((roles & DEF_TGT) && (t = tempOf(f, &q->tgt[i])) >= 0) BIT_SET(l->def, t);
+            if ((roles & DEF_DST) && (t = tempOf(f, &q->dst[i])) >= 0) BIT_SET(l->def, t);
+        }
+    }
+
+    bool changed = true;
+
+    while (changed) {
+        changed = false;
+
+        for (int b = f->cfg.count - 1; b >= 0; b--) {
+            BasicBlock *block = &f->cfg.blocks[b];
+            Liveness *l = &f->live[b];
+
+            for (int w = 0; w < words; w++) {
+                uint64_t out = 0;
+
+                if (block->succ[0] >= 0) out |= f->live[block->succ[0]].in[w];
+                if (block->succ[1] >= 0) out |= f->live[block->succ[1]].in[w];
+
+                uint64_t in = l->use[w] | (out & ~l->def[w]);
+
+                if (in != l->in[w] || out != l->out[w]) changed = true;
+
+                l->in[w] = in;
+                l->out[w] = out;
+            }
+        }
+    }
+}
+
+/*  liveAcrossCalls() → Temporaries live right after each user call (walking its block backwards from the live out), in
+ *  bitsets indexed by quadruple: an interval spans the holes of its temporary, so it may cover a call it is not live
+ *  across (a value reloaded after it)  */
+static uint64_t *liveAcrossCalls(CompilerContext *ctx, Function *f) {
+    QuadBuffer *q = f->quads;
+    uint64_t *across = allocOrDie((size_t)(f->last - f->first + 1) * f->words * sizeof(uint64_t));
+    uint64_t *live = allocOrDie(f->words * sizeof(uint64_t));
+
+    for (int b = 0; b < f->cfg.count; b++) {
+        BasicBlock *block = &f->cfg.blocks[b];
+
+        memcpy(live, f->live[b].out, f->words * sizeof(uint64_t));
+
+        for (int i = block->last; i >= block->first; i--) {
+            int roles = operandRoles(q->op[i]);
+            int t;
+
+            if (isUserCall(ctx, q, i)) memcpy(across + (size_t)(i - f->first) * f->words, live, f->words * sizeof(uint64_t));
+
+            if ((roles & DEF_TGT) && (t = tempOf(f, &q->tgt[i])) >= 0) BIT_CLEAR(live, t);
+            if ((roles & DEF_DST) && (t = tempOf(f, &q->dst[i])) >= 0) BIT_CLEAR(live, t);
+            if ((roles & USE_SRC) && (t = tempOf(f, &q->src[i])) >= 0) BIT_SET(live, t);
+            if ((roles & USE_TGT) && (t = tempOf(f, &q->tgt[i])) >= 0) BIT_SET(live, t);
+            if ((roles & USE_DST) && (t = tempOf(f, &q->dst[i])) >= 0) BIT_SET(live, t);
+        }
+    }
+
+    free(live);
+    return across;
+}
+
+static void extend(Interval *iv, int position) {
+    if (position < iv->start) iv->start = position;
+    if (position > iv->end) iv->end = position;
+}
+
+/*  buildIntervals() → One interval per temporary, covering its reads, writes and every block boundary it is live at;
+ *  the temporaries of the Params are read again (and must sit in a register) at their Call  */
+static void buildIntervals(Function *f) {
+    QuadBuffer *q = f->quads;
+    int *pending = allocOrDie((f->last - f->first + 1) * sizeof(int));
+    int pendingCount = 0;
+
+    f->intervals = allocOrDie(f->count * sizeof(Interval));
+
+    for (int t = 0; t < f->count; t++) {
+        f->intervals[t].start = INT_MAX;
+        f->intervals[t].end = -1;
+        f->intervals[t].reg = -1;
+        f->intervals[t].slot = -1;
+    }
+
+    for (int b = 0; b < f->cfg.count; b++) {
+        BasicBlock *block = &f->cfg.blocks[b];
+        Liveness *l = &f->live[b];
+
+        for (int w = 0; w < f->words; w++) {
+            if ((l->in[w] | l->out[w]) == 0) continue;
+
+            for (int t = 64 * w; t < f->count && t < 64 * (w + 1); t++) {
+                if (BIT_TEST(l->in, t)) extend(&f->intervals[t], 2 * block->first);
+                if (BIT_TEST(l->out, t)) extend(&f->intervals[t], 2 * block->last + 1);
+            }
+        }
+
+        for (int i = block->first; i <= block->last; i++) {
+            int roles = operandRoles(q->op[i]);
+            int t;
+
+            if ((roles & USE_SRC) && (t = tempOf(f, &q->src[i])) >= 0) extend(&f->intervals[t], 2 * i);
+            if ((roles & USE_TGT) && (t = tempOf(f, &q->tgt[i])) >= 0) extend(&f->intervals[t], 2 * i);
+            if ((roles & USE_DST) && (t = tempOf(f, &q->dst[i])) >= 0) extend(&f->intervals[t], 2 * i);
+            if ((roles & DEF_TGT) && (t = tempOf(f, &q->tgt[i])) >= 0) extend(&f->intervals[t], 2 * i + 1);
+            if ((roles & DEF_DST) && (t = tempOf(f, &q->dst[i])) >= 0) extend(&f->intervals[t], 2 * i + 1);
+
+            if (q->op[i] == Param) {
+                pending[pendingCount++] = tempOf(f, &q->src[i]);
+            } else if (q->op[i] == Call) {
+                for (int n = q->tgt[i].content.value; n > 0 && pendingCount > 0; n--) {
+                    t = pending[--pendingCount];
+
+                    if (t >= 0) {
+                        extend(&f->intervals[t], 2 * i);
+                        f->intervals[t].pinned = true;
+                    }
+                }
+            }
+        }
+    }
+
+    free(pending);
+}
+
+static int compareStarts(const void *a, const void *b) {
+    return (*(Interval *const *)a)->start - (*(Interval *const *)b)->start;
+}
+
+/*  linearScan() → Assigns registers [REG_FIRST, last] to the intervals in start order; when none is free, the interval
+ *  ending last is spilled (never a pinned one). Returns how many were spilled, or -1 (and fails the unit) when only
+ *  pinned ones are left to spill  */
+static int linearScan(CompilerContext *ctx, Function *f, int last, char *name) {
+    Interval **order = allocOrDie(f->count * sizeof(Interval *));
+    Interval *active[REG_SIZE];
+    bool busy[REG_SIZE] = { false };
+    int count = 0, activeCount = 0, spilled = 0;
+
+    for (int t = 0; t < f->count; t++) {
+        f->intervals[t].reg = f->intervals[t].slot = -1;
+        if (f->intervals[t].end >= 0) order[count++] = &f->intervals[t];
+    }
+    qsort(order, count, sizeof(Interval *), compareStarts);
+
+    for (int n = 0; n < count; n++) {
+        Interval *iv = order[n];
+
+        /* Expire the intervals that ended before this one starts   */
+        for (int a = 0; a < activeCount; a++) {
+            if (active[a]->end < iv->start) {
+                busy[active[a]->reg] = false;
+                active[a--] = active[--activeCount];
+            }
+        }
+
+        int reg = -1;
+        for (int r = REG_FIRST; r <= last && reg < 0; r++) if (!busy[r]) reg = r;
+
+        if (reg >= 0) {
+            iv->reg = reg;
+            busy[reg] = true;
+            active[activeCount++] = iv;
+
+            if (activeCount > ctx->regAllocStats.maxPressure) ctx->regAllocStats.maxPressure = activeCount;
+            continue;
+        }
+
+        /* No free register: spill whichever ends last   */
+        int victim = -1;
+        for (int a = 0; a < activeCount; a++) {
+            if (!active[a]->pinned && (victim < 0 || active[a]->end > active[victim]->end)) victim = a;
+        }
+
+        if (!iv->pinned && (victim < 0 || iv->end >= active[victim]->end)) {
+            spilled++;
+        } else if (victim >= 0) {
+            iv->reg = active[victim]->reg;
+            active[victim]->reg = -1;
+            active[victim] = iv;
+            spilled++;
+        } else {
+            fprintf(ctx->listing, "> Misc Error\n     Too many call arguments alive at once in \"%s\". (Register Allocation)\n", name);
+            ctx->failed = true;
+            spilled = -1;
+            break;
+        }
+    }
+
+    free(order);
+    return spilled;
+}
+
+/*--------------------------------------------/
+ *  Rewriting of a function
+ *---------------------------------*/
+
+/*  Names → Interned names of the physical registers, and the function (scope of its spill slots) being rewritten  */
+typedef struct {
+    char *reg[REG_SIZE];
+    char *name;
+} Names;
+
+static Address regAddress(Names *names, int reg) {
+    Address a;
+
+    a.type = addrString;
+    a.symbolId = NO_SYMBOL;
+    a.content.name = names->reg[reg];
+
+    return a;
+}
+
+static Address slotAddress(CompilerContext *ctx, int slot) {
+    Address a;
+    char name[16];
+
+    sprintf(name, "$s%d", slot);
+
+    a.type = addrString;
+    a.symbolId = NO_SYMBOL;
+    a.content.name = internName(ctx, name);
+
+    return a;
+}
+
+/*  rewriteUse() → Replaces a read temporary by its register, or loads it from its spill slot into a scratch register  */
+static void rewriteUse(CompilerContext *ctx, Function *f, Names *names, QuadBuffer *out, Address *a, int *scratch) {
+    int t = tempOf(f, a);
+
+    if (t < 0) return;
+
+    if (f->intervals[t].reg >= 0) {
+        *a = regAddress(names, f->intervals[t].reg);
+    } else {
+        Address scope = { addrString, NO_SYMBOL };
+        scope.content.name = names->name;
+
+        *a = regAddress(names, (*scratch)++);
+
+        appendQuad(out, LoadVAR, scope, slotAddress(ctx, f->intervals[t].slot), *a);
+        ctx->regAllocStats.spillLoads++;
+    }
+}
+
+/*  rewriteFunction() → Appends the function to "out" with registers instead of temporaries, its spill slots (after the
+ *  first allocations, so the parameters keep their offsets), the spill code and, around each user call, the Push/Pop
+ *  of the registers whose values are live across it  */
+static void rewriteFunction(CompilerContext *ctx, Function *f, Names *names, QuadBuffer *out) {
+    QuadBuffer *q = f->quads;
+    Address empty = { addrVoid, NO_SYMBOL };
+    Address scope = { addrString, NO_SYMBOL };
+    Interval **byStart = allocOrDie(f->count * sizeof(Interval *));
+    Interval *holder[REG_SIZE] = { NULL };
+    uint64_t *across = liveAcrossCalls(ctx, f);
+    bool used[REG_SIZE] = { false };
+    int slots = 0, started = 0, count = 0, scratchFirst = REG_LAST - REG_SCRATCH + 1;
+    int i = f->first;
+
+    scope.content.name = names->name;
+
+    for (int t = 0; t < f->count; t++) {
+        if (f->intervals[t].end < 0) continue;
+
+        if (f->intervals[t].reg >= 0) {
+            used[f->intervals[t].reg] = true;
+            byStart[count++] = &f->intervals[t];
+        } else {
+            f->intervals[t].slot = slots++;
+        }
+    }
+    qsort(byStart, count, sizeof(Interval *), compareStarts);
+
+    /* FunBGN and the allocations of parameters (and first locals), then the spill slots   */
+    appendQuad(out, q->op[i], q->src[i], q->tgt[i], q->dst[i]);
+    for (i++; i <= f->last && (q->op[i] == AllocVAR || q->op[i] == AllocARRAY); i++) {
+        appendQuad(out, q->op[i], q->src[i], q->tgt[i], q->dst[i]);
+    }
+    for (int s = 0; s < slots; s++) {
+        appendQuad(out, AllocVAR, scope, slotAddress(ctx, s), empty);
+    }
+
+    for (; i <= f->last; i++) {
+        Operation op = q->op[i];
+        Address src = q->src[i], tgt = q->tgt[i], dst = q->dst[i];
+        int roles = operandRoles(op);
+        int scratch = scratchFirst;
+
+        if (roles & USE_SRC) rewriteUse(ctx, f, names, out, &src, &scratch);
+        if (roles & USE_TGT) rewriteUse(ctx, f, names, out, &tgt, &scratch);
+        if (roles & USE_DST) rewriteUse(ctx, f, names, out, &dst, &scratch);
+
+        Address *def = (roles & DEF_TGT) ? &tgt : (roles & DEF_DST) ? &dst : NULL;
+        int spilledDef = -1;
+
+        if (def != NULL && tempOf(f, def) >= 0) {
+            Interval *iv = &f->intervals[tempOf(f, def)];
+
+            if (iv->reg >= 0) {
+                *def = regAddress(names, iv->reg);
+            } else {
+                spilledDef = iv->slot;
+                *def = regAddress(names, scratchFirst);
+            }
+        }
+
+        bool userCall = isUserCall(ctx, q, i);
+        bool saved[REG_SIZE] = { false };
+
+        /* A register is saved only if its value was set before the call and is read after it (the intervals sharing a
+         * register never overlap, so the one that started last is the only candidate, and it must be live across or be
+         * the argument of a later Call)   */
+        if (userCall) {
+            while (started < count && byStart[started]->start < 2 * i) {
+                holder[byStart[started]->reg] = byStart[started];
+                started++;
+            }
+
+            for (int r = REG_FIRST; r < REG_SIZE; r++) {
+                if (!used[r]) continue;
+
+                if (holder[r] != NULL && holder[r]->end > 2 * i + 1 && (holder[r]->pinned || BIT_TEST(across + (size_t)(i - f->first) * f->words, holder[r] - f->intervals))) {
+                    saved[r] = true;
+                    appendQuad(out, Push, regAddress(names, r), empty, empty);
+                    ctx->regAllocStats.saves++;
+                } else {
+                    ctx->regAllocStats.savesRemoved++;
+                }
+            }
+        }
+
+        appendQuad(out, op, src, tgt, dst);
+
+        if (userCall) {
+            for (int r = REG_SIZE - 1; r >= REG_FIRST; r--) {
+                if (saved[r]) appendQuad(out, Pop, regAddress(names, r), empty, empty);
+            }
+        }
+
+        if (spilledDef >= 0) {
+            appendQuad(out, StoreVAR, regAddress(names, scratchFirst), scope, slotAddress(ctx, spilledDef));
+            ctx->regAllocStats.spillStores++;
+        }
+    }
+
+    free(byStart);
+    free(across);
+}
+
+/*  allocateFunction() → Liveness, linear scan (retried with the scratch registers kept aside if anything spills) and
+ *  rewriting of the function [first, last]  */
+static void allocateFunction(CompilerContext *ctx, Names *names, QuadBuffer *out, int *index, int first, int last) {
+    QuadBuffer *q = &ctx->quadruples;
+    Function f = { q, first, last, index, 0 };
+
+    for (int i = first; i <= last; i++) {
+        Address *operands[3] = { &q->src[i], &q->tgt[i], &q->dst[i] };
+
+        for (int k = 0; k < 3; k++) {
+            if (operands[k]->type == addrTemp && index[operands[k]->content.value] < 0) index[operands[k]->content.value] = f.count++;
+        }
+    }
+
+    names->name = q->src[first].content.name;
+    ctx->regAllocStats.functions++;
+
+    /* Leaf functions (no user calls) keep $ra in its register: FunBGN/FunEND are marked so the back end skips its
+     * store/load   */
+    bool leaf = (names->name != ctx->mainName);
+
+    for (int i = first; i <= last && leaf; i++) {
+        if (isUserCall(ctx, q, i)) leaf = false;
+    }
+
+    if (leaf) {
+        q->dst[first].type = q->dst[last].type = addrString;
+        q->dst[first].content.name = q->dst[last].content.name = internName(ctx, "leaf");
+        ctx->regAllocStats.leaves++;
+    }
+
+    /* No temporaries: nothing to allocate   */
+    if (f.count == 0) {
+        for (int i = first; i <= last; i++) appendQuad(out, q->op[i], q->src[i], q->tgt[i], q->dst[i]);
+        return;
+    }
+
+    ctx->regAllocStats.temporaries += f.count;
+
+    buildCFG(&f.cfg, q, first, last);
+    computeLiveness(&f);
+    buildIntervals(&f);
+
+    f.spilled = linearScan(ctx, &f, REG_LAST, names->name);
+    if (f.spilled > 0) f.spilled = linearScan(ctx, &f, REG_LAST - REG_SCRATCH, names->name);
+
+    if (f.spilled >= 0) {
+        ctx->regAllocStats.spilled += f.spilled;
+        rewriteFunction(ctx, &f, names, out);
+    }
+
+    free(f.live[0].use);
+    free(f.live);
+    freeCFG(&f.cfg);
+    free(f.intervals);
+
+    for (int i = first; i <= last; i++) {
+        if (q->src[i].type == addrTemp) index[q->src[i].content.value] = -1;
+        if (q->tgt[i].type == addrTemp) index[q->tgt[i].content.value] = -1;
+        if (q->dst[i].type == addrTemp) index[q->dst[i].content.value] = -1;
+    }
+}
+
+/*  measurePressure() → How many intervals of the function [first, last] cover each of its quadruples ("pressure", indexed
+ *  from "first"): what linear scan will have to fit in r6–r25, for the passes that lengthen lifetimes. "index" (one
+ *  entry per temporary, all -1) is left as it was found  */
+void measurePressure(CompilerContext *ctx, int first, int last, int *index, int *pressure) {
+    QuadBuffer *q = &ctx->quadruples;
+    int *delta = allocOrDie((last - first + 2) * sizeof(int));
+    Function f = { q, first, last, index, 0 };
+
+    for (int i = first; i <= last; i++) {
+        Address *operands[3] = { &q->src[i], &q->tgt[i], &q->dst[i] };
+
+        for (int k = 0; k < 3; k++) {
+            if (operands[k]->type == addrTemp && index[operands[k]->content.value] < 0) index[operands[k]->content.value] = f.count++;
+        }
+    }
+
+    if (f.count > 0) {
+        buildCFG(&f.cfg, q, first, last);
+        computeLiveness(&f);
+        buildIntervals(&f);
+
+        for (int t = 0; t < f.count; t++) {
+            if (f.intervals[t].end < 0) continue;
+
+            delta[f.intervals[t].start / 2 - first]++;
+            delta[f.intervals[t].end / 2 - first + 1]--;
+        }
+
+        free(f.live[0].use);
+        free(f.live);
+        freeCFG(&f.cfg);
+        free(f.intervals);
+    }
+
+    for (int i = 0, covered = 0; i <= last - first; i++) {
+        covered += delta[i];
+        pressure[i] = covered;
+    }
+
+    for (int i = first; i <= last; i++) {
+        if (q->src[i].type == addrTemp) index[q->src[i].content.value] = -1;
+        if (q->tgt[i].type == addrTemp) index[q->tgt[i].content.value] = -1;
+        if (q->dst[i].type == addrTemp) index[q->dst[i].content.value] = -1;
+    }
+
+    free(delta);
+}
+
+/*  allocateRegisters() → Maps the temporaries of every function onto r6–r25 (liveness + linear scan), adding the spill
+ *  code and the Push/Pop of the registers live across calls, and marks the leaf functions  */
+void allocateRegisters(CompilerContext *ctx) {
+    QuadBuffer *q = &ctx->quadruples;
+    QuadBuffer out = { 0 };
+    Names names;
+    int *index = allocOrDie(ctx->tempsCounter * sizeof(int));
+
+    for (int t = 0; t < ctx->tempsCounter; t++) index[t] = -1;
+
+    for (int r = 0; r < REG_SIZE; r++) {
+        char name[16];
+
+        sprintf(name, "r%d", r);
+        names.reg[r] = internName(ctx, name);
+    }
+
+    for (int i = 0; i < q->count && !ctx->failed; i++) {
+        if (q->op[i] != FunBGN) {
+            appendQuad(&out, q->op[i], q->src[i], q->tgt[i], q->dst[i]);
+            continue;
+        }
+
+        int last = i;
+        while (last + 1 < q->count && q->op[last] != FunEND) last++;
+
+        allocateFunction(ctx, &names, &out, index, i, last);
+        i = last;
+    }
+
+    free(index);
+    freeQuads(q);
+    *q = out;
+}
+
+/*  printRegAllocStats() → Prints how many temporaries were allocated and spilled, and the call overhead saved  */
+void printRegAllocStats(CompilerContext *ctx) {
+    RegAllocStats *stats = &ctx->regAllocStats;
+    int removed = stats->savesRemoved + stats->leaves;
+
+    fprintf(ctx->listing, "\n> Register Allocation: %d temporarie(s) in %d function(s) onto r%d–r%d, max. %d live at once, %d spilled (%d load(s), %d store(s))\n",
+        stats->temporaries, stats->functions, REG_FIRST, REG_LAST, stats->maxPressure, stats->spilled, stats->spillLoads, stats->spillStores);
+    fprintf(ctx->listing, "> Call overhead: %d register save(s) kept around calls, %d skipped (not live across the call), %d leaf function(s) without $ra save → %d store(s) and %d load(s) removed\n",
+        stats->saves, stats->savesRemoved, stats->leaves, removed, removed);
+}
@@ -0,0 +1,52 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Register Allocator interface for a C- Compiler
+ *  File: reg_alloc.h
+ *---------------------------------*/
+
+#ifndef REGALLOC_H
+#define REGALLOC_H
+
+#include "globals.h"
+#include "mid_codegen.h"
+
+/*--------------------------------------------/
+ *  Register Allocator structure
+ *---------------------------------*/
+
+/*  REG_FIRST..REG_LAST → General purpose registers handed out to temporaries; when a function spills, the last
+ *  REG_SCRATCH of them are kept aside to load/store the spilled temporaries around each quadruple  */
+#define REG_FIRST 6
+#define REG_LAST 25
+#define REG_SCRATCH 2
+
+/*  RegAllocStats → What the allocator did over a whole compilation; each register save is a Push/Pop pair (one store
+ *  and one load) around a call, each leaf function one store and one load of $ra less  */
+typedef struct {
+    int functions;
+    int temporaries;
+    int maxPressure;
+    int spilled;
+    int spillLoads;
+    int spillStores;
+    int saves;
+    int savesRemoved;
+    int leaves;
+} RegAllocStats;
+
+/*--------------------------------------------/
+ *  Register Allocator functions
+ *---------------------------------*/
+
+/*  allocateRegisters() → Maps the temporaries of every function onto r6–r25 (liveness + linear scan), adding the spill
+ *  code and the Push/Pop of the registers live across calls, and marks the leaf functions  */
+void allocateRegisters(CompilerContext *ctx);
+
+/*  measurePressure() → How many intervals of the function [first, last] cover each of its quadruples ("pressure", indexed
+ *  from "first"): what linear scan will have to fit in r6–r25, for the passes that lengthen lifetimes. "index" (one
+ *  entry per temporary, all -1) is left as it was found  */
+void measurePressure(CompilerContext *ctx, int first, int last, int *index, int *pressure);
+
+/*  printRegAllocStats() → Prints how many temporaries were allocated and spilled, and the call overhead saved  */
+void printRegAllocStats(CompilerContext *ctx);
+
+#endif
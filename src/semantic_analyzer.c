@@ -3,76 +3,75 @@
  *  File: semantic_analyzer.c
  *---------------------------------*/
 
-#include "symbol_table.h"
+#include "context.h"
 #include "utils.h"
 
-/*  mainDeclared → Flag to catch if main() was declared into code compiled  */
-static bool mainDeclared = false;
-
-/* currentFunctionType → Type of the current function being analyzed  */
-static TreeNode *lastFunctionDeclared = NULL;
-
 /*  traverse() → Traverse the Abstract Syntax Tree (AST) applying pre-order and post-order functions to each node */
-static void traverse(TreeNode *t, void (*preProc)(TreeNode *), void (*postProc)(TreeNode *)) {
+static void traverse(CompilerContext *ctx, TreeNode *t, void (*preProc)(CompilerContext *, TreeNode *), void (*postProc)(CompilerContext *, TreeNode *)) {
     if (t != NULL) {
-        preProc(t);
+        preProc(ctx, t);
 
         for (int i = 0; i < MAXCHILDREN; i++) {
-            traverse(t->child[i], preProc, postProc);
+            traverse(ctx, t->child[i], preProc, postProc);
         }
 
-        postProc(t);
+        postProc(ctx, t);
 
-        traverse(t->sibling, preProc, postProc);
+        traverse(ctx, t->sibling, preProc, postProc);
     }
 }
 
 /*  insertNode() → Inserts nodes into the Symbol Table */
-static void insertNode(TreeNode *t) {
+static void insertNode(CompilerContext *ctx, TreeNode *t) {
     switch (t->nodekind) {
         case NodeDeclaration:
             switch (t->kind.decl) {
                 case DeclVariable:
                     if (t->type == Void) {
-                        printBars();
-                        printf("> Semantic Error\n     Line %d - Invalid Declaration: variable '%s' cannot be of type 'void'.", t->lineno, t->attr.name);
-                        printBars();
-                    } else if (st_lookup(t) == NULL) {
-                        st_insert(t, t->scope);
+                        printBars(ctx);
+                        fprintf(ctx->listing, "> Semantic Error\n     Line %d - Invalid Declaration: variable '%s' cannot be of type 'void'.", t->lineno, t->attr.name);
+                        printBars(ctx);
+                        ctx->failed = true;
+                    } else if (st_lookup(ctx, t) == NULL) {
+                        st_bind(t, st_insert(ctx, t, t->scope));
                     } else {
-                        printBars(); 
-                        printf("> Semantic Error\n     Line %d - Redeclaration: variable '%s' was already declared.\n", t->lineno, t->attr.name);
-                        printBars();
+                        printBars(ctx); 
+                        fprintf(ctx->listing, "> Semantic Error\n     Line %d - Redeclaration: variable '%s' was already declared.\n", t->lineno, t->attr.name);
+                        printBars(ctx);
+                        ctx->failed = true;
                     }
                     break;
                 case DeclFunction:
-                    if (strcmp(t->attr.name, "main") == 0) mainDeclared = true;
+                    if (t->attr.name == ctx->mainName) ctx->mainDeclared = true;
 
-                    if (st_lookup(t) == NULL) {
-                        st_insert(t, t->scope);
-                        lastFunctionDeclared = t;
+                    if (st_lookup(ctx, t) == NULL) {
+                        st_bind(t, st_insert(ctx, t, t->scope));
+                        ctx->lastFunctionDeclared = t;
                     } else {
-                        printBars(); 
-                        printf("> Semantic Error\n     Line %d - Redeclaration: function '%s' was already declared.", t->lineno, t->attr.name);
-                        printBars();
+                        printBars(ctx); 
+                        fprintf(ctx->listing, "> Semantic Error\n     Line %d - Redeclaration: function '%s' was already declared.", t->lineno, t->attr.name);
+                        printBars(ctx);
+                        ctx->failed = true;
                     }
                     break;
                 case DeclParameter:
-                    if (st_lookup(t) == NULL) {
-                        st_insert(t, t->scope);
+                    if (st_lookup(ctx, t) == NULL) {
+                        st_bind(t, st_insert(ctx, t, t->scope));
                     } else {
-                        printBars(); 
-                        printf("> Semantic Error\n     Line %d - Redeclaration: parameter '%s' was already declared.", t->lineno, t->attr.name);
-                        printBars();
+                        printBars(ctx); 
+                        fprintf(ctx->listing, "> Semantic Error\n     Line %d - Redeclaration: parameter '%s' was already declared.", t->lineno, t->attr.name);
+                        printBars(ctx);
+                        ctx->failed = true;
                     }
                     break;
                 case DeclArray:
-                    if (st_lookup(t) == NULL) {
-                        st_insert(t, t->scope);
+                    if (st_lookup(ctx, t) == NULL) {
+                        st_bind(t, st_insert(ctx, t, t->scope));
                     } else {
-                        printBars(); 
-                        printf("> Semantic Error\n     Line %d - Redeclaration: array '%s' was already declared.", t->lineno, t->attr.name);
-                        printBars();
+                        printBars(ctx); 
+                        fprintf(ctx->listing, "> Semantic Error\n     Line %d - Redeclaration: array '%s' was already declared.", t->lineno, t->attr.name);
+                        printBars(ctx);
+                        ctx->failed = true;
                     }
                     break;
             }
@@ -83,34 +82,39 @@ static void insertNode(TreeNode *t) {
 }
 
 /*  checkNode() → Check nodes inserted into the Symbol Table */
-static void checkNode(TreeNode *t) {
+static void checkNode(CompilerContext *ctx, TreeNode *t) {
     TreeNode *lookup;
+    Symbol symbol;
 
     switch (t->nodekind) {
         case NodeExpression:
             switch (t->kind.exp) {
                 case ExpID:
-                    lookup = st_lookup(t);
+                    symbol = st_resolve(ctx, t);
 
-                    if (st_lookup(t) == NULL) {
-                        printBars(); 
-                        printf("> Semantic Error\n     Line %d - Not Declared: variable '%s' was not declared.", t->lineno, t->attr.name);
-                        printBars();
+                    if (symbol == NULL) {
+                        printBars(ctx); 
+                        fprintf(ctx->listing, "> Semantic Error\n     Line %d - Not Declared: variable '%s' was not declared.", t->lineno, t->attr.name);
+                        printBars(ctx);
+                        ctx->failed = true;
                     } else {
-                        st_insert(t, lookup->scope);
+                        st_bind(t, symbol);
+                        st_addLine(ctx, symbol, t->lineno);
                     }
                     break;
 
                 case ExpCall:
-                    lookup = st_lookup(t);
+                    symbol = st_resolve(ctx, t);
 
-                    if (lookup == NULL) {
-                        printBars(); 
-                        printf("> Semantic Error\n     Line %d - Not Declared: function '%s' was not declared.", t->lineno, t->attr.name);
-                        printBars();
+                    if (symbol == NULL) {
+                        printBars(ctx); 
+                        fprintf(ctx->listing, "> Semantic Error\n     Line %d - Not Declared: function '%s' was not declared.", t->lineno, t->attr.name);
+                        printBars(ctx);
+                        ctx->failed = true;
                     } else {
-                        t->type = lookup->type;
-                        st_insert(t, lookup->scope);
+                        t->type = symbol->treeNode->type;
+                        st_bind(t, symbol);
+                        st_addLine(ctx, symbol, t->lineno);
                     }
                     break;
 
@@ -123,39 +127,44 @@ static void checkNode(TreeNode *t) {
             switch (t->kind.stmt) {
                 case StmtAssign:
                     if (t->child[0] == NULL || t->child[1] == NULL) {
-                        printBars();
-                        printf("> Semantic Error\n     Line %d - Incomplete Assignment: missing operand(s).", t->lineno);
-                        printBars();
+                        printBars(ctx);
+                        fprintf(ctx->listing, "> Semantic Error\n     Line %d - Incomplete Assignment: missing operand(s).", t->lineno);
+                        printBars(ctx);
+                        ctx->failed = true;
                     } else if (t->child[0]->type != t->child[1]->type) {
-                        printBars();
-                        printf("> Semantic Error\n     Line %d - Mismatch Type: '%s → %s' and '%s → %s' types do not match.", 
+                        printBars(ctx);
+                        fprintf(ctx->listing, "> Semantic Error\n     Line %d - Mismatch Type: '%s → %s' and '%s → %s' types do not match.", 
                             t->lineno,
                             t->child[0]->attr.name,
                             expTypeToString(t->child[0]->type),
                             t->child[1]->attr.name,
                             expTypeToString(t->child[1]->type));
-                        printBars();
+                        printBars(ctx);
+                        ctx->failed = true;
                     }
                     break;
 
                 case StmtReturn:
-                    lookup = st_lookup(lastFunctionDeclared);
+                    lookup = ctx->lastFunctionDeclared;
 
                     if (lookup == NULL) {
-                        printBars();
-                        printf("> Semantic Error\n     Line %d - Invalid Return: function was not declared.", t->lineno);
-                        printBars();
+                        printBars(ctx);
+                        fprintf(ctx->listing, "> Semantic Error\n     Line %d - Invalid Return: function was not declared.", t->lineno);
+                        printBars(ctx);
+                        ctx->failed = true;
                     }
 
                     if (lookup->type == Void && t->child[0] != NULL) {
-                        printBars();
-                        printf("> Semantic Error\n     Line %d - Invalid Return: cannot return a value from a void function.", t->lineno);
-                        printBars();
+                        printBars(ctx);
+                        fprintf(ctx->listing, "> Semantic Error\n     Line %d - Invalid Return: cannot return a value from a void function.", t->lineno);
+                        printBars(ctx);
+                        ctx->failed = true;
                     }
                     else if (lookup->type == Integer && t->child[0] == NULL) {
-                        printBars();
-                        printf("> Semantic Error\n     Line %d - Invalid Return: function with return type 'int' must return a value.", t->lineno);
-                        printBars();
+                        printBars(ctx);
+                        fprintf(ctx->listing, "> Semantic Error\n     Line %d - Invalid Return: function with return type 'int' must return a value.", t->lineno);
+                        printBars(ctx);
+                        ctx->failed = true;
                     }
                     break;
 
@@ -169,83 +178,84 @@ static void checkNode(TreeNode *t) {
     }
 
     if (t->nodekind == NodeDeclaration && t->kind.decl == DeclVariable) {
-        lookup = st_lookup(t);
+        lookup = st_lookup(ctx, t);
 
         if (lookup != NULL && lookup->kind.decl == DeclFunction) {
-            printBars();
-            printf("> Semantic Error\n     Line %d - Conflict: variable '%s' collided with a function with same\n name.", t->lineno, t->attr.name);
-            printBars();
+            printBars(ctx);
+            fprintf(ctx->listing, "> Semantic Error\n     Line %d - Conflict: variable '%s' collided with a function with same\n name.", t->lineno, t->attr.name);
+            printBars(ctx);
+            ctx->failed = true;
         }
     }
 }
 
 /*  initiPredefinedFunctions() → Inserts predefined functions into the Symbol Table  */
-static void initPredefinedFunctions() {
-    TreeNode *haltFunc = newDeclNode(DeclFunction);   // Halt()
+static void initPredefinedFunctions(CompilerContext *ctx) {
+    TreeNode *haltFunc = newDeclNode(ctx, DeclFunction);   // Halt()
     haltFunc->type = Void;
     haltFunc->lineno = 0;
-    haltFunc->attr.name = "halt";
-    haltFunc->scope = "global";
+    haltFunc->attr.name = internName(ctx, "halt");
+    haltFunc->scope = ctx->globalScope;
     haltFunc->child[0] = NULL;
     haltFunc->child[1] = NULL;
-    st_insert(haltFunc, "global");
+    st_insert(ctx, haltFunc, ctx->globalScope)->builtin = BuiltinHalt;
 //----------------------------------------------------
-    TreeNode *execFunc = newDeclNode(DeclFunction);   // Execute(IMoffset, DMoffset)
+    TreeNode *execFunc = newDeclNode(ctx, DeclFunction);   // Execute(IMoffset, DMoffset)
     execFunc->type = Void;
     execFunc->lineno = 0;
-    execFunc->attr.name = "execute";
-    execFunc->scope = "global";
+    execFunc->attr.name = internName(ctx, "execute");
+    execFunc->scope = ctx->globalScope;
     
-    TreeNode *exec_IMoffset = newDeclNode(DeclParameter);
+    TreeNode *exec_IMoffset = newDeclNode(ctx, DeclParameter);
     exec_IMoffset->type = Integer;
-    exec_IMoffset->attr.name = strdup("IMoffset");
+    exec_IMoffset->attr.name = internName(ctx, "IMoffset");
 
-    TreeNode *exec_DMoffset = newDeclNode(DeclParameter);
+    TreeNode *exec_DMoffset = newDeclNode(ctx, DeclParameter);
     exec_DMoffset->type = Integer;
-    exec_DMoffset->attr.name = strdup("DMoffset");
+    exec_DMoffset->attr.name = internName(ctx, "DMoffset");
 
     addSibling(exec_IMoffset, exec_DMoffset);
 
     execFunc->child[0] = exec_IMoffset;
     execFunc->child[1] = NULL;
-    st_insert(execFunc, "global");
+    st_insert(ctx, execFunc, ctx->globalScope)->builtin = BuiltinExecute;
 
 //----------------------------------------------------
-    TreeNode *setupProgramFunc = newDeclNode(DeclFunction);   // SetupProgram(DMoffset)
+    TreeNode *setupProgramFunc = newDeclNode(ctx, DeclFunction);   // SetupProgram(DMoffset)
     setupProgramFunc->type = Void;
     setupProgramFunc->lineno = 0;
-    setupProgramFunc->attr.name = "setupProgram";
-    setupProgramFunc->scope = "global";
+    setupProgramFunc->attr.name = internName(ctx, "setupProgram");
+    setupProgramFunc->scope = ctx->globalScope;
 
-    TreeNode *setup_DMoffset = newDeclNode(DeclParameter);
+    TreeNode *setup_DMoffset = newDeclNode(ctx, DeclParameter);
     setup_DMoffset->type = Integer;
-    setup_DMoffset->attr.name = strdup("DMoffset");
+    setup_DMoffset->attr.name = internName(ctx, "DMoffset");
 
     setupProgramFunc->child[0] = setup_DMoffset;
     setupProgramFunc->child[1] = NULL;
-    st_insert(setupProgramFunc, "global");
+    st_insert(ctx, setupProgramFunc, ctx->globalScope)->builtin = BuiltinSetupProgram;
 //----------------------------------------------------
-    TreeNode *execRRFunc = newDeclNode(DeclFunction);   // ExecuteRR(PC, IMoffset, DMoffset, quantum)
+    TreeNode *execRRFunc = newDeclNode(ctx, DeclFunction);   // ExecuteRR(PC, IMoffset, DMoffset, quantum)
     execRRFunc->type = Integer;
     execRRFunc->lineno = 0;
-    execRRFunc->attr.name = "executeRR";
-    execRRFunc->scope = "global";
+    execRRFunc->attr.name = internName(ctx, "executeRR");
+    execRRFunc->scope = ctx->globalScope;
     
-    TreeNode *execRR_pc = newDeclNode(DeclParameter);
+    TreeNode *execRR_pc = newDeclNode(ctx, DeclParameter);
     execRR_pc->type = Integer;
-    execRR_pc->attr.name = strdup("pc");
+    execRR_pc->attr.name = internName(ctx, "pc");
 
-    TreeNode *execRR_IMoffset = newDeclNode(DeclParameter);
+    TreeNode *execRR_IMoffset = newDeclNode(ctx, DeclParameter);
     execRR_IMoffset->type = Integer;
-    execRR_IMoffset->attr.name = strdup("IMoffset");
+    execRR_IMoffset->attr.name = internName(ctx, "IMoffset");
 
-    TreeNode *execRR_DMoffset = newDeclNode(DeclParameter);
+    TreeNode *execRR_DMoffset = newDeclNode(ctx, DeclParameter);
     execRR_DMoffset->type = Integer;
-    execRR_DMoffset->attr.name = strdup("DMoffset");
+    execRR_DMoffset->attr.name = internName(ctx, "DMoffset");
 
-    TreeNode *execRR_quantum = newDeclNode(DeclParameter);
+    TreeNode *execRR_quantum = newDeclNode(ctx, DeclParameter);
     execRR_quantum->type = Integer;
-    execRR_quantum->attr.name = strdup("quantum");
+    execRR_quantum->attr.name = internName(ctx, "quantum");
 
     addSibling(execRR_pc, execRR_IMoffset);
     addSibling(execRR_pc, execRR_DMoffset);
@@ -253,204 +263,204 @@ static void initPredefinedFunctions() {
 
     execRRFunc->child[0] = execRR_pc;
     execRRFunc->child[1] = NULL;
-    st_insert(execRRFunc, "global");
+    st_insert(ctx, execRRFunc, ctx->globalScope)->builtin = BuiltinExecuteRR;
     
 //----------------------------------------------------
-    TreeNode *peekFunc = newDeclNode(DeclFunction);     // Peek()
+    TreeNode *peekFunc = newDeclNode(ctx, DeclFunction);     // Peek()
     peekFunc->type = Integer;
     peekFunc->lineno = 0;
-    peekFunc->attr.name = "peek";
-    peekFunc->scope = "global";
+    peekFunc->attr.name = internName(ctx, "peek");
+    peekFunc->scope = ctx->globalScope;
     peekFunc->child[0] = NULL;
     peekFunc->child[1] = NULL;
-    st_insert(peekFunc, "global");
+    st_insert(ctx, peekFunc, ctx->globalScope)->builtin = BuiltinPeek;
 
 //----------------------------------------------------    
-    TreeNode *inputFunc = newDeclNode(DeclFunction);    // Input()
+    TreeNode *inputFunc = newDeclNode(ctx, DeclFunction);    // Input()
     inputFunc->type = Integer;
     inputFunc->lineno = 0;
-    inputFunc->attr.name = "input";
-    inputFunc->scope = "global";
+    inputFunc->attr.name = internName(ctx, "input");
+    inputFunc->scope = ctx->globalScope;
     inputFunc->child[0] = NULL;
     inputFunc->child[1] = NULL;
-    st_insert(inputFunc, "global");
+    st_insert(ctx, inputFunc, ctx->globalScope)->builtin = BuiltinInput;
     
 //----------------------------------------------------
-    TreeNode *uartFunc = newDeclNode(DeclFunction);     // UART()
+    TreeNode *uartFunc = newDeclNode(ctx, DeclFunction);     // UART()
     uartFunc->type = Integer;
     uartFunc->lineno = 0;
-    uartFunc->attr.name = "UART";
-    uartFunc->scope = "global";
+    uartFunc->attr.name = internName(ctx, "UART");
+    uartFunc->scope = ctx->globalScope;
     uartFunc->child[0] = NULL;
     uartFunc->child[1] = NULL;
-    st_insert(uartFunc, "global");
+    st_insert(ctx, uartFunc, ctx->globalScope)->builtin = BuiltinUART;
 
 //----------------------------------------------------
-    TreeNode *outputFunc = newDeclNode(DeclFunction);   // Output(value)
+    TreeNode *outputFunc = newDeclNode(ctx, DeclFunction);   // Output(value)
     outputFunc->type = Void;
     outputFunc->lineno = 0;
-    outputFunc->attr.name = "output";
-    outputFunc->scope = "global";
+    outputFunc->attr.name = internName(ctx, "output");
+    outputFunc->scope = ctx->globalScope;
 
-    TreeNode *out_value = newDeclNode(DeclParameter);
+    TreeNode *out_value = newDeclNode(ctx, DeclParameter);
     out_value->type = Integer;
-    out_value->attr.name = strdup("value");
+    out_value->attr.name = internName(ctx, "value");
 
     outputFunc->child[0] = out_value;
     outputFunc->child[1] = NULL;
-    st_insert(outputFunc, "global");
+    st_insert(ctx, outputFunc, ctx->globalScope)->builtin = BuiltinOutput;
 
 //----------------------------------------------------
-    TreeNode *loadHDFunc = newDeclNode(DeclFunction);   // LoadHD(offset, line)
+    TreeNode *loadHDFunc = newDeclNode(ctx, DeclFunction);   // LoadHD(offset, line)
     loadHDFunc->type = Integer;
     loadHDFunc->lineno = 0;
-    loadHDFunc->attr.name = "loadHD";
-    loadHDFunc->scope = "global";
+    loadHDFunc->attr.name = internName(ctx, "loadHD");
+    loadHDFunc->scope = ctx->globalScope;
     
-    TreeNode *lHD_offset = newDeclNode(DeclParameter);
+    TreeNode *lHD_offset = newDeclNode(ctx, DeclParameter);
     lHD_offset->type = Integer;
-    lHD_offset->attr.name = strdup("offset");
+    lHD_offset->attr.name = internName(ctx, "offset");
 
-    TreeNode *lHD_line = newDeclNode(DeclParameter);
+    TreeNode *lHD_line = newDeclNode(ctx, DeclParameter);
     lHD_line->type = Integer;
-    lHD_line->attr.name = strdup("line");
+    lHD_line->attr.name = internName(ctx, "line");
 
     addSibling(lHD_offset, lHD_line);
 
     loadHDFunc->child[0] = lHD_offset;
     loadHDFunc->child[1] = NULL;
-    st_insert(loadHDFunc, "global");
+    st_insert(ctx, loadHDFunc, ctx->globalScope)->builtin = BuiltinLoadHD;
 
 //----------------------------------------------------
-    TreeNode *storeHDFunc = newDeclNode(DeclFunction);   // StoreHD(offset, line, value)
+    TreeNode *storeHDFunc = newDeclNode(ctx, DeclFunction);   // StoreHD(offset, line, value)
     storeHDFunc->type = Void;
     storeHDFunc->lineno = 0;
-    storeHDFunc->attr.name = "storeHD";
-    storeHDFunc->scope = "global";
+    storeHDFunc->attr.name = internName(ctx, "storeHD");
+    storeHDFunc->scope = ctx->globalScope;
     
-    TreeNode *sHD_offset = newDeclNode(DeclParameter);
+    TreeNode *sHD_offset = newDeclNode(ctx, DeclParameter);
     sHD_offset->type = Integer;
-    sHD_offset->attr.name = strdup("offset");
+    sHD_offset->attr.name = internName(ctx, "offset");
 
-    TreeNode *sHD_line = newDeclNode(DeclParameter);
+    TreeNode *sHD_line = newDeclNode(ctx, DeclParameter);
     sHD_line->type = Integer;
-    sHD_line->attr.name = strdup("line");
+    sHD_line->attr.name = internName(ctx, "line");
 
-    TreeNode *sHD_value = newDeclNode(DeclParameter);
+    TreeNode *sHD_value = newDeclNode(ctx, DeclParameter);
     sHD_value->type = Integer;
-    sHD_value->attr.name = strdup("value");
+    sHD_value->attr.name = internName(ctx, "value");
 
     addSibling(sHD_offset, sHD_line);
     addSibling(sHD_offset, sHD_value);
 
     storeHDFunc->child[0] = sHD_offset;
     storeHDFunc->child[1] = NULL;
-    st_insert(storeHDFunc, "global");
+    st_insert(ctx, storeHDFunc, ctx->globalScope)->builtin = BuiltinStoreHD;
 
 //----------------------------------------------------
-    TreeNode *HD2IMFunc = newDeclNode(DeclFunction);   // HD2IM(offset, line, address)
+    TreeNode *HD2IMFunc = newDeclNode(ctx, DeclFunction);   // HD2IM(offset, line, address)
     HD2IMFunc->type = Void;
     HD2IMFunc->lineno = 0;
-    HD2IMFunc->attr.name = "HDtoIM";
-    HD2IMFunc->scope = "global";
+    HD2IMFunc->attr.name = internName(ctx, "HDtoIM");
+    HD2IMFunc->scope = ctx->globalScope;
     
-    TreeNode *HD2IM_offset = newDeclNode(DeclParameter);
+    TreeNode *HD2IM_offset = newDeclNode(ctx, DeclParameter);
     HD2IM_offset->type = Integer;
-    HD2IM_offset->attr.name = strdup("offset");
+    HD2IM_offset->attr.name = internName(ctx, "offset");
 
-    TreeNode *HD2IM_line = newDeclNode(DeclParameter);
+    TreeNode *HD2IM_line = newDeclNode(ctx, DeclParameter);
     HD2IM_line->type = Integer;
-    HD2IM_line->attr.name = strdup("line");
+    HD2IM_line->attr.name = internName(ctx, "line");
 
-    TreeNode *HD2IM_address = newDeclNode(DeclParameter);
+    TreeNode *HD2IM_address = newDeclNode(ctx, DeclParameter);
     HD2IM_address->type = Integer;
-    HD2IM_address->attr.name = strdup("address");
+    HD2IM_address->attr.name = internName(ctx, "address");
 
     addSibling(HD2IM_offset, HD2IM_line);
     addSibling(HD2IM_offset, HD2IM_address);
 
     HD2IMFunc->child[0] = HD2IM_offset;
     HD2IMFunc->child[1] = NULL;
-    st_insert(HD2IMFunc, "global");
+    st_insert(ctx, HD2IMFunc, ctx->globalScope)->builtin = BuiltinHDtoIM;
 
 //----------------------------------------------------
-    TreeNode *LCDwriteFunc = newDeclNode(DeclFunction);   // LCDwrite(c0, c1, ..., c14, c15, line)
+    TreeNode *LCDwriteFunc = newDeclNode(ctx, DeclFunction);   // LCDwrite(c0, c1, ..., c14, c15, line)
     LCDwriteFunc->type = Void;
     LCDwriteFunc->lineno = 0;
-    LCDwriteFunc->attr.name = "LCDwrite";
-    LCDwriteFunc->scope = "global";
+    LCDwriteFunc->attr.name = internName(ctx, "LCDwrite");
+    LCDwriteFunc->scope = ctx->globalScope;
 
-    TreeNode *LCD_c0  = newDeclNode(DeclParameter);
+    TreeNode *LCD_c0  = newDeclNode(ctx, DeclParameter);
     LCD_c0->type = Integer;
-    LCD_c0->attr.name = strdup("c0");
+    LCD_c0->attr.name = internName(ctx, "c0");
 
-    TreeNode *LCD_c1  = newDeclNode(DeclParameter);
+    TreeNode *LCD_c1  = newDeclNode(ctx, DeclParameter);
     LCD_c1->type = Integer;
-    LCD_c1->attr.name = strdup("c1");
+    LCD_c1->attr.name = internName(ctx, "c1");
 
-    TreeNode *LCD_c2  = newDeclNode(DeclParameter);
+    TreeNode *LCD_c2  = newDeclNode(ctx, DeclParameter);
     LCD_c2->type = Integer;
-    LCD_c2->attr.name = strdup("c2");
+    LCD_c2->attr.name = internName(ctx, "c2");
 
-    TreeNode *LCD_c3  = newDeclNode(DeclParameter);
+    TreeNode *LCD_c3  = newDeclNode(ctx, DeclParameter);
     LCD_c3->type = Integer;
-    LCD_c3->attr.name = strdup("c3");
+    LCD_c3->attr.name = internName(ctx, "c3");
 
-    TreeNode *LCD_c4  = newDeclNode(DeclParameter);
+    TreeNode *LCD_c4  = newDeclNode(ctx, DeclParameter);
     LCD_c4->type = Integer;
-    LCD_c4->attr.name = strdup("c4");
+    LCD_c4->attr.name = internName(ctx, "c4");
 
-    TreeNode *LCD_c5  = newDeclNode(DeclParameter);
+    TreeNode *LCD_c5  = newDeclNode(ctx, DeclParameter);
     LCD_c5->type = Integer;
-    LCD_c5->attr.name = strdup("c5");
+    LCD_c5->attr.name = internName(ctx, "c5");
 
-    TreeNode *LCD_c6  = newDeclNode(DeclParameter);
+    TreeNode *LCD_c6  = newDeclNode(ctx, DeclParameter);
     LCD_c6->type = Integer;
-    LCD_c6->attr.name = strdup("c6");
+    LCD_c6->attr.name = internName(ctx, "c6");
 
-    TreeNode *LCD_c7  = newDeclNode(DeclParameter);
+    TreeNode *LCD_c7  = newDeclNode(ctx, DeclParameter);
     LCD_c7->type = Integer;
-    LCD_c7->attr.name = strdup("c7");
+    LCD_c7->attr.name = internName(ctx, "c7");
 
-    TreeNode *LCD_c8  = newDeclNode(DeclParameter);
+    TreeNode *LCD_c8  = newDeclNode(ctx, DeclParameter);
     LCD_c8->type = Integer;
-    LCD_c8->attr.name = strdup("c8");
+    LCD_c8->attr.name = internName(ctx, "c8");
 
-    TreeNode *LCD_c9  = newDeclNode(DeclParameter);
+    TreeNode *LCD_c9  = newDeclNode(ctx, DeclParameter);
     LCD_c9->type = Integer;
-    LCD_c9->attr.name = strdup("c9");
+    LCD_c9->attr.name = internName(ctx, "c9");
 
-    TreeNode *LCD_c10 = newDeclNode(DeclParameter);
+    TreeNode *LCD_c10 = newDeclNode(ctx, DeclParameter);
     LCD_c10->type = Integer;
-    LCD_c10->attr.name = strdup("c10");
+    LCD_c10->attr.name = internName(ctx, "c10");
 
-    TreeNode *LCD_c11 = newDeclNode(DeclParameter);
+    TreeNode *LCD_c11 = newDeclNode(ctx, DeclParameter);
     LCD_c11->type = Integer;
-    LCD_c11->attr.name = strdup("c11");
+    LCD_c11->attr.name = internName(ctx, "c11");
 
-    TreeNode *LCD_c12 = newDeclNode(DeclParameter);
+    TreeNode *LCD_c12 = newDeclNode(ctx, DeclParameter);
     LCD_c12->type = Integer;
-    LCD_c12->attr.name = strdup("c12");
+    LCD_c12->attr.name = internName(ctx, "c12");
 
-    TreeNode *LCD_c13 = newDeclNode(DeclParameter);
+    TreeNode *LCD_c13 = newDeclNode(ctx, DeclParameter);
     LCD_c13->type = Integer;
-    LCD_c13->attr.name = strdup("c13");
+    LCD_c13->attr.name = internName(ctx, "c13");
 
-    TreeNode *LCD_c14 = newDeclNode(DeclParameter);
+    TreeNode *LCD_c14 = newDeclNode(ctx, DeclParameter);
     LCD_c14->type = Integer;
-    LCD_c14->attr.name = strdup("c14");
+    LCD_c14->attr.name = internName(ctx, "c14");
 
-    TreeNode *LCD_c15 = newDeclNode(DeclParameter);
+    TreeNode *LCD_c15 = newDeclNode(ctx, DeclParameter);
     LCD_c15->type = Integer;
-    LCD_c15->attr.name = strdup("c15");
+    LCD_c15->attr.name = internName(ctx, "c15");
 
-    TreeNode *LCD_c16 = newDeclNode(DeclParameter);
+    TreeNode *LCD_c16 = newDeclNode(ctx, DeclParameter);
     LCD_c16->type = Integer;
-    LCD_c16->attr.name = strdup("c16");
+    LCD_c16->attr.name = internName(ctx, "c16");
 
-    TreeNode *LCD_line = newDeclNode(DeclParameter);
+    TreeNode *LCD_line = newDeclNode(ctx, DeclParameter);
     HD2IM_line->type = Integer;
-    HD2IM_line->attr.name = strdup("line");
+    HD2IM_line->attr.name = internName(ctx, "line");
 
     addSibling(LCD_c0, LCD_c1);
     addSibling(LCD_c0, LCD_c2);
@@ -472,31 +482,33 @@ static void initPredefinedFunctions() {
 
     LCDwriteFunc->child[0] = LCD_c0;
     LCDwriteFunc->child[1] = NULL;
-    st_insert(LCDwriteFunc, "global");
+    st_insert(ctx, LCDwriteFunc, ctx->globalScope)->builtin = BuiltinLCDwrite;
 }
 
-/*  traceSemantic() → Check TraceSemantic and print out the Symbol Table  */
-static void traceSemantic(void) {
-  if (TraceSemantic) {
-    printSymbolTable();
-  } else {
-    printf("\n> Semantic Analysis completed.\n");
+/*  traceSemantic() → Check TraceSemantic and log the Symbol Table  */
+static void traceSemantic(CompilerContext *ctx) {
+  if (beginTrace(ctx, TraceSemantic)) {
+    printSymbolTable(ctx);
+    endTrace(ctx);
   }
+  fprintf(ctx->listing, "\n> Semantic Analysis completed.\n");
 }
 
 /*  semanticAnalysis() → Traverses the entire Abstract Syntax Tree and performs the Semantic Analysis  */
-void semanticAnalysis(TreeNode *AST) {
-    initPredefinedFunctions(); // [TODO]: Add a bool in main to config this
+void semanticAnalysis(CompilerContext *ctx) {
+    initPredefinedFunctions(ctx); // [TODO]: Add a bool in main to config this
 
     
-    traverse(AST, insertNode, checkNode);
-    printf("\n> Starting Semantic Analysis...\n");
+    traverse(ctx, ctx->abstractSyntaxTree, insertNode, checkNode);
+    fprintf(ctx->listing, "\n> Starting Semantic Analysis...\n");
     
-    if (!mainDeclared) {
-        printBars(); 
-        printf("> Semantic Error\n     Main Missing: function 'main' was not declared.");
-        printBars();
+    if (!ctx->mainDeclared) {
+        printBars(ctx); 
+        fprintf(ctx->listing, "> Semantic Error\n     Main Missing: function 'main' was not declared.");
+        printBars(ctx);
+        ctx->failed = true;
     }
     
-    traceSemantic();
+    traceSemantic(ctx);
+    printSymbolStats(ctx);
 }
\ No newline at end of file
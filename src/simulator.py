@@ -0,0 +1,380 @@
+import sys
+from bisect import bisect_right
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+import binary_codegen
+from binary_codegen import Instruction, fields, formats, registers
+
+traceSimulation = False
+
+memorySize = 1024
+stackStart = 127
+stepLimit = 10_000_000
+
+registerNames = {code: name for name, code in registers.items()}
+registerIndex = {name: int(code, 2) for name, code in registers.items()}
+
+decoding = {(f.opcode, f.funct): name for name, f in formats.items() if name != "nop"}
+
+def decodeWord(word: str) -> Instruction:
+    if (word == "0" * 32):
+        return Instruction("nop", "-", "-", "-")
+
+    funct = word[26:32] if word[0:6] == "000000" else None
+    name = decoding.get((word[0:6], funct))
+
+    if (name is None):
+        raise ValueError(f"unknown instruction word {word}")
+
+    operands = []
+    for place in formats[name].operands:
+        if (place == "-"):
+            operands.append("-")
+            continue
+
+        bits = word[fields[place][0]:fields[place][1]]
+        if (place in ("rs", "rt", "rd")):
+            operands.append(registerNames[bits])
+        elif (place == "imm"):
+            value = int(bits, 2)
+            operands.append(str(value - (1 << 16) if value & 0x8000 else value))
+        else:
+            operands.append(str(int(bits, 2)))
+
+    return Instruction(name, *operands)
+
+def encodingCheck():
+    # Encodes one instruction of every format with binary_codegen.py and decodes it back: encoder and decoder must agree
+    probe = {"rs": "r6", "rt": "r7", "rd": "r8", "shamt": "3", "imm": "-5", "addr": "17", "-": "-"}
+
+    for name, f in formats.items():
+        instr = Instruction(name, *[probe[place] for place in f.operands])
+        word = format(binary_codegen.binaryCodeGenerate([instr])[0], '032b')
+
+        if (decodeWord(word) != instr):
+            raise RuntimeError(f"decodeWord() does not invert the encoding of \"{name}\"")
+
+# Program loading ---------------------------------------------------------------------------------------------------------
+
+def loadProgram(path: str) -> Tuple[str, List[Instruction]]:
+    # A packed image (binary.bin, .hex or .mif, see binary_codegen.py), the binary.txt listing (32 bit words, comments and
+    # padding) or assembly.txt ("[index] instr src tgt dst" after the source line)
+    source = path
+    program = []
+
+    if (Path(path).suffix in (".bin", ".hex", ".mif")):
+        words = binary_codegen.loadImage(path)
+
+        # The system image starts with its size (the words that follow it), not with code
+        if (len(words) > 1 and words[0] == len(words) - 1):
+            words = words[1:]
+        return source, [decodeWord(format(word, '032b')) for word in words]
+
+    with open(path, 'r') as file:
+        lines = file.read().splitlines()
+
+    if (len(lines) > 0 and len(lines[0].split("//")[0].strip()) == 32 and set(lines[0].split("//")[0].strip()) <= {"0", "1"}):
+        for index, line in enumerate(lines):
+            word, _, comment = line.partition("//")
+            word = word.strip()
+
+            if ("START OF CLUSTER (" in comment):
+                source = comment.split("(", 1)[1].rsplit(")", 1)[0]
+            if (index == 0 and "Size =" in comment):
+                continue
+            if (len(word) == 32):
+                program.append(decodeWord(word))
+
+        # The cluster is padded with zero words (nop) up to programRange/systemRange
+        while (len(program) > 0 and program[-1].instr == "nop"):
+            program.pop()
+    else:
+        source = lines[0].strip() if len(lines) > 0 else path
+
+        for line in lines[1:]:
+            parts = line.strip().split(' ')[1:]
+            if len(parts) == 4:
+                program.append(Instruction(*[p.strip() for p in parts]))
+
+    return source, program
+
+def loadValues(path: Optional[str]) -> List[int]:
+    # Whitespace separated integers (or 32 bit words) of a device file
+    if (path is None):
+        return []
+
+    values = []
+    for token in Path(path).read_text().split():
+        values.append(int(token, 2) if len(token) == 32 and set(token) <= {"0", "1"} else int(token, 0))
+    return values
+
+def functionEntries(path: str, size: int) -> Dict[int, str]:
+    # Entry address of every function, found by running the midcode.ir (or midcode.txt) next to the program through
+    # assembly_codegen.py again (the addresses are only known there); the start of the program otherwise
+    midcode = Path(path).with_name("midcode.ir")
+    if (not midcode.exists()):
+        midcode = Path(path).with_name("midcode.txt")
+
+    if (midcode.exists()):
+        try:
+            import assembly_codegen
+
+            assembly_codegen.traceFile = None
+            code = assembly_codegen.assemblyCodeGenerate(assembly_codegen.midcodeTranslate(str(midcode)))
+
+            if (len(code) == size):
+                return {address: name for name, address in assembly_codegen.functionAddresses.items()}
+        except Exception:
+            pass
+
+    return {0: "(program)"}
+
+# Execution ---------------------------------------------------------------------------------------------------------------
+
+@dataclass
+class FunctionStats:
+    name: str
+    instructions: int = 0
+    loads: int = 0
+    stores: int = 0
+    entries: int = 0
+
+@dataclass
+class Run:
+    source: str
+    stop: str = ""
+    pc: int = 0
+    instructions: int = 0
+    loads: int = 0
+    stores: int = 0
+    stackPeak: int = 0
+    output: List[int] = field(default_factory=list)
+    lcd: Dict[int, List[int]] = field(default_factory=dict)
+    counts: Dict[str, int] = field(default_factory=dict)
+    functions: List[FunctionStats] = field(default_factory=list)
+    timer: Optional[int] = None
+
+def s32(value: int) -> int:
+    value &= 0xFFFFFFFF
+    return value - (1 << 32) if value & 0x80000000 else value
+
+arithmetic = {
+    "add":  lambda x, y: x + y,
+    "sub":  lambda x, y: x - y,
+    "mul":  lambda x, y: x * y,
+    "and":  lambda x, y: x & y,
+    "or":   lambda x, y: x | y,
+    "set":  lambda x, y: int(x == y),
+    "sdt":  lambda x, y: int(x != y),
+    "sgt":  lambda x, y: int(x > y),
+    "slt":  lambda x, y: int(x < y),
+    "segt": lambda x, y: int(x >= y),
+    "selt": lambda x, y: int(x <= y),
+}
+
+def truncatingDivide(x: int, y: int) -> int:
+    quotient = abs(x) // abs(y)
+    return quotient if (x >= 0) == (y >= 0) else -quotient
+
+def simulate(path: str, inputs: List[int] = [], uart: List[int] = [], switches: int = 0, hd: List[int] = [],
+             limit: Optional[int] = None) -> Run:
+    source, program = loadProgram(path)
+    limit = stepLimit if limit is None else limit
+
+    entries = functionEntries(path, len(program))
+    starts = sorted(entries)
+    stats = [FunctionStats(entries[address]) for address in starts]
+    owner = [max(bisect_right(starts, pc) - 1, 0) for pc in range(len(program))]
+
+    regs = [0] * 32
+    sp = registerIndex["$sp"]
+    regs[registerIndex["$fp"]] = regs[sp] = stackStart
+
+    banks: Dict[int, List[int]] = {}
+    bank = 0
+    memory = banks.setdefault(bank, [0] * memorySize)
+    disk = {address: value for address, value in enumerate(hd)}
+    inputs, uart = list(inputs), list(uart)
+
+    run = Run(source)
+    counts: Dict[str, int] = {}
+    pc = 0
+
+    def operand(value: str) -> int:
+        return regs[registerIndex[value]]
+
+    def write(name: str, value: int):
+        index = registerIndex[name]
+        if (index != 0):
+            regs[index] = s32(value)
+
+    while (True):
+        if (pc < 0 or pc >= len(program)):
+            run.stop = f"pc {pc} left the program"
+            break
+        if (run.instructions >= limit):
+            run.stop = f"step limit ({limit}) reached"
+            break
+
+        instr = program[pc]
+        name, src, tgt, dst = instr.instr, instr.addr_src, instr.addr_tgt, instr.addr_dst
+        function = stats[owner[pc]]
+
+        if (traceSimulation):
+            print(f"    > [{pc}] {name} {src} {tgt} {dst}")
+
+        run.instructions += 1
+        function.instructions += 1
+        counts[name] = counts.get(name, 0) + 1
+        pc += 1
+
+        if (name in arithmetic):
+            write(dst, arithmetic[name](operand(src), operand(tgt)))
+        elif (name.endswith("i") and name[:-1] in arithmetic):
+            write(tgt, arithmetic[name[:-1]](operand(src), int(dst)))
+        elif (name in ("div", "divi")):
+            divisor = operand(tgt) if name == "div" else int(dst)
+            if (divisor == 0):
+                run.stop = f"division by zero at {pc - 1}"
+                break
+            write(dst if name == "div" else tgt, truncatingDivide(operand(src), divisor))
+        elif (name == "sll"):
+            write(dst, operand(src) << int(tgt))
+        elif (name == "srl"):
+            write(dst, (operand(src) & 0xFFFFFFFF) >> int(tgt))
+        elif (name == "move"):
+            write(dst, operand(src))
+        elif (name == "movei"):
+            write(dst, int(src))
+        elif (name in ("load", "store")):
+            address = operand(src) + int(dst)
+            if (address < 0 or address >= memorySize):
+                run.stop = f"data memory access out of range ({address}) at {pc - 1}"
+                break
+            if (name == "load"):
+                write(tgt, memory[address])
+                run.loads += 1
+                function.loads += 1
+            else:
+                memory[address] = operand(tgt)
+                run.stores += 1
+                function.stores += 1
+        elif (name == "beq"):
+            if (operand(src) == operand(tgt)):
+                pc = int(dst)
+        elif (name in ("j", "jal")):
+            if (name == "jal"):
+                write("$ra", pc)
+            target = int(src)
+            if (target in entries and (name == "jal" or stats[owner[target]] is not function)):
+                stats[owner[target]].entries += 1
+            pc = target
+        elif (name == "jr"):
+            pc = operand(src)
+        elif (name == "in"):
+            if (len(inputs) == 0):
+                run.stop = f"waiting for input at {pc - 1} (none left)"
+                break
+            write(dst, inputs.pop(0))
+        elif (name == "uart"):
+            if (len(uart) == 0):
+                run.stop = f"waiting for the UART at {pc - 1} (nothing left)"
+                break
+            write(dst, uart.pop(0))
+        elif (name == "peek"):
+            write(dst, switches)
+        elif (name == "out"):
+            run.output.append(operand(src))
+        elif (name == "writeLCD"):
+            run.lcd.setdefault(operand(tgt), []).append(operand(src))
+        elif (name == "loadHD"):
+            write(dst, disk.get(operand(src) + operand(tgt), 0))
+        elif (name == "storeHD"):
+            disk[operand(src)] = operand(tgt)
+        elif (name == "HDtoIM"):
+            pass
+        elif (name == "setTimer"):
+            run.timer = operand(src)
+        elif (name == "dmset"):
+            bank = operand(src)
+            memory = banks.setdefault(bank, [0] * memorySize)
+        elif (name == "pcbkp"):
+            write(tgt, pc)
+        elif (name == "jimset"):
+            run.stop = f"jimset to {operand(src)} of instruction cluster {operand(tgt)}"
+            break
+        elif (name == "halt"):
+            run.stop = "halt"
+            break
+        elif (name == "nop"):
+            pass
+        else:
+            run.stop = f"unknown instruction \"{name}\" at {pc - 1}"
+            break
+
+        if (regs[sp] - stackStart > run.stackPeak):
+            run.stackPeak = regs[sp] - stackStart
+
+    run.pc = pc
+    run.counts = counts
+    run.functions = stats
+    return run
+
+# Report ------------------------------------------------------------------------------------------------------------------
+
+def printReport(path: str, run: Run):
+    print(f"\n> Simulation of {path} ({run.source}) ----------------------------------------")
+    print(f"> Stopped: {run.stop} (pc {run.pc})")
+    print(f"> Output: {' '.join(str(value) for value in run.output) if run.output else '-'}")
+    for line, chars in sorted(run.lcd.items()):
+        text = "".join(chr(c) if 32 <= c < 127 else "?" for c in chars[-16:])
+        print(f"> LCD line {line}: \"{text}\" ({len(chars)} write(s))")
+    if (run.timer is not None):
+        print(f"> Timer: last set to {run.timer}")
+
+    print(f"> Instructions retired: {run.instructions} (one cycle each)")
+    print(f"> Memory accesses: {run.loads} load(s), {run.stores} store(s)")
+    print(f"> Peak stack depth: {run.stackPeak} word(s) above $sp = {stackStart}")
+
+    print("> Per function:")
+    print(f"\t{'function':<20} {'instructions':>12} {'loads':>8} {'stores':>8} {'entries':>8}")
+    for f in sorted(run.functions, key=lambda f: -f.instructions):
+        print(f"\t{f.name:<20} {f.instructions:>12} {f.loads:>8} {f.stores:>8} {f.entries:>8}")
+
+    print("> Per instruction:")
+    for name, count in sorted(run.counts.items(), key=lambda item: -item[1]):
+        print(f"\t{name:<10} {count:>12}")
+
+def main(argv: List[str]):
+    global traceSimulation, memorySize, stackStart
+
+    # Usage: simulator.py [binary | assembly] [--input file] [--uart file] [--hd file] [--switches n] [--limit n]
+    #                     [--memory n] [--stack n] [-t]
+    options = {}
+    paths = []
+    arguments = iter(argv)
+
+    for arg in arguments:
+        if (arg == "-t"):
+            traceSimulation = True
+        elif (arg.startswith("--")):
+            options[arg[2:]] = next(arguments, None)
+        else:
+            paths.append(arg)
+
+    memorySize = int(options.get("memory", memorySize))
+    stackStart = int(options.get("stack", stackStart))
+
+    encodingCheck()
+
+    path = paths[0] if len(paths) > 0 else "outputs/binary.bin"
+    limit = int(options["limit"]) if "limit" in options else None
+
+    run = simulate(path, loadValues(options.get("input")), loadValues(options.get("uart")),
+                   int(options.get("switches", 0)), loadValues(options.get("hd")), limit)
+    printReport(path, run)
+
+if __name__ == "__main__":
+    main(sys.argv[1:])
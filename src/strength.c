@@ -0,0 +1,75 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Strength Reduction over the Quadruples List for a C- Compiler
+ *  File: strength.c
+ *---------------------------------*/
+
+#include "context.h"
+#include "utils.h"
+#include "optimizer.h"
+
+/*  log2Exact() → k when value is 2^k (k ≥ 1), -1 otherwise  */
+static int log2Exact(int value) {
+    int k = 0;
+
+    if (value < 2 || (value & (value - 1)) != 0) return -1;
+
+    while ((1 << k) != value) k++;
+    return k;
+}
+
+/*  isNonNegative() → Whether an operand is known to be ≥ 0 (a constant, or a temporary marked so)  */
+static bool isNonNegative(Address *a, bool *nonNegative) {
+    if (a->type == addrConst) return a->content.value >= 0;
+    if (a->type == addrTemp) return nonNegative[a->content.value];
+
+    return false;
+}
+
+/*  reduceStrength() → Turns multiplies by 2^k into left shifts and divides by 2^k into right shifts, the latter only when
+ *  the dividend is known to be non negative (srl is a logical shift: it would not round a negative one toward zero)  */
+void reduceStrength(CompilerContext *ctx) {
+    QuadBuffer *q = &ctx->quadruples;
+    bool *nonNegative = allocOrDie(ctx->tempsCounter * sizeof(bool));
+
+    for (int i = 0; i < q->count; i++) {
+        Address *src = &q->src[i], *tgt = &q->tgt[i], *dst = &q->dst[i];
+        int k = (tgt->type == addrConst) ? log2Exact(tgt->content.value) : -1;
+
+        if (q->op[i] == Mul && k > 0 && src->type != addrConst) {
+            q->op[i] = Lshift;
+            tgt->content.value = k;
+            ctx->optStats.multiplies++;
+        } else if (q->op[i] == Div && k > 0 && isNonNegative(src, nonNegative)) {
+            q->op[i] = Rshift;
+            tgt->content.value = k;
+            ctx->optStats.divides++;
+        }
+
+        /* Temporaries are written once, before they are read: their sign is known from their definition on   */
+        if (dst->type != addrTemp && q->op[i] != Move) continue;
+
+        switch (q->op[i]) {
+            case SGT: case SLT: case SGET: case SLET: case SET: case SDT:
+                nonNegative[dst->content.value] = true;
+                break;
+            case Rshift:
+                /* A logical shift clears the sign bit only when it moves by at least one: by 0 (or by a variable that
+                 * may be 0) a negative value comes out as it went in   */
+                nonNegative[dst->content.value] = (tgt->type == addrConst && tgt->content.value >= 1) || isNonNegative(src, nonNegative);
+                break;
+            case And:
+                nonNegative[dst->content.value] = isNonNegative(src, nonNegative) || isNonNegative(tgt, nonNegative);
+                break;
+            case Div:
+                nonNegative[dst->content.value] = isNonNegative(src, nonNegative) && isNonNegative(tgt, nonNegative);
+                break;
+            case Move:
+                if (tgt->type == addrTemp) nonNegative[tgt->content.value] = isNonNegative(src, nonNegative);
+                break;
+            default:
+                break;
+        }
+    }
+
+    free(nonNegative);
+}
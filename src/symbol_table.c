@@ -3,144 +3,255 @@
  *  File: symbol_table.c
  *---------------------------------*/
 
-#include "symbol_table.h"
+#include "context.h"
 #include "utils.h"
 
-#define HASH_SIZE 211
-#define SHIFT 4
+#include <stdint.h>
 
-static BucketList hashTable[HASH_SIZE];
+/*  hash() → Mixes the (interned) name and scope handles into a table index  */
+static unsigned hash(char *name, char *scope) {
+    uint64_t key = (uint64_t)(uintptr_t)name ^ ((uint64_t)(uintptr_t)scope * 0x9e3779b97f4a7c15ULL);
 
-/*  hash() → transforms a string (identifier name) into a numeric table (to Symbol Table) index  */
-static int hash(char *key, char *salt) {
-    int temp = 0;
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
 
-    for (; *key != '\0'; key++) {
-        temp = ((temp << SHIFT) + *key) % HASH_SIZE;
-    }
-    
-    for (; *salt != '\0'; salt++) {
-        temp = ((temp << SHIFT) + *salt) % HASH_SIZE;
+    return (unsigned)key;
+}
+
+/*  findSlot() → Probes for (name, scope) and returns its slot: either the one holding it or the empty one where it belongs  */
+static int findSlot(SymbolTable *table, char *name, char *scope) {
+    int mask = table->capacity - 1;
+    int i = hash(name, scope) & mask;
+    int probe = 1;
+
+    table->stats.lookups++;
+
+    while (table->slots[i] != -1) {
+        Symbol s = table->symbols[table->slots[i]];
+
+        if (s->name == name && s->scope == scope) break;
+
+        i = (i + 1) & mask;
+        probe++;
     }
 
-    return temp;
+    table->stats.probes += probe;
+    if (probe > table->stats.maxProbe) table->stats.maxProbe = probe;
+
+    return i;
 }
 
-/*  st_insert() → Inserts or updates an identifier in the Symbol Table  */
-void st_insert(TreeNode *t, char *scope) {
-    int h = hash(t->attr.name, scope);
-    BucketList l = hashTable[h];
+/*  growSlots() → Doubles the slots (kept at most half full) and rehashes every symbol  */
+static void growSlots(SymbolTable *table) {
+    int capacity = (table->capacity == 0) ? SYMTAB_INITIAL : table->capacity * 2;
+    int *slots = malloc(capacity * sizeof(int));
 
-    while (l != NULL) {
-        if (strcmp(t->attr.name, l->name) == 0) {
-            break;
-        }
-        l = l->next;
+    if (slots == NULL) {
+        printf("> Misc Error\n     Out of memory error. (Symbol Table)\n");
+        exit(EXIT_FAILURE);
     }
 
+    for (int i = 0; i < capacity; i++) slots[i] = -1;
+
+    for (int n = 0; n < table->count; n++) {
+        int i = hash(table->symbols[n]->name, table->symbols[n]->scope) & (capacity - 1);
+
+        while (slots[i] != -1) i = (i + 1) & (capacity - 1);
+        slots[i] = n;
+    }
+
+    if (table->capacity != 0) table->stats.resizes++;
+
+    free(table->slots);
+    table->slots = slots;
+    table->capacity = capacity;
+}
+
+/*  lookupSymbol() → Returns the symbol (name, scope), or NULL  */
+static Symbol lookupSymbol(SymbolTable *table, char *name, char *scope) {
+    if (table->capacity == 0) return NULL;
+
+    int slot = table->slots[findSlot(table, name, scope)];
+
+    return (slot == -1) ? NULL : table->symbols[slot];
+}
+
+/*  newLineRec() → Allocates a usage line  */
+static LineList newLineRec(CompilerContext *ctx, int lineno) {
+    LineList line = arenaAlloc(&ctx->arena, sizeof(struct LineListRec));
+
+    line->lineno = lineno;
+    line->next = NULL;
+
+    return line;
+}
+
+/*  st_insert() → Inserts or updates an identifier in the Symbol Table and returns its symbol  */
+Symbol st_insert(CompilerContext *ctx, TreeNode *t, char *scope) {
+    SymbolTable *table = &ctx->symbolTable;
+
+    if (2 * (table->count + 1) > table->capacity) growSlots(table);
+
+    int i = findSlot(table, t->attr.name, scope);
+
     /* New Symbol   */
-    if (l == NULL) {
-        l = malloc(sizeof(struct BucketListRec));
+    if (table->slots[i] == -1) {
+        if (table->count == table->symbolsCapacity) {
+            table->symbolsCapacity = (table->symbolsCapacity == 0) ? SYMTAB_INITIAL : table->symbolsCapacity * 2;
+            table->symbols = realloc(table->symbols, table->symbolsCapacity * sizeof(Symbol));
+
+            if (table->symbols == NULL) {
+                printf("> Misc Error\n     Out of memory error. (Symbol Table)\n");
+                exit(EXIT_FAILURE);
+            }
+        }
 
-        l->name = strdup(t->attr.name);
-        l->scope = strdup(scope);
+        if (i != (int)(hash(t->attr.name, scope) & (table->capacity - 1))) table->stats.collisions++;
 
-        l->lines = malloc(sizeof(struct LineListRec));
-        l->lines->lineno = t->lineno;
-        l->lines->next = NULL;
+        Symbol s = arenaAlloc(&ctx->arena, sizeof(struct SymbolRec));
 
-        l->treeNode = t;
-        
-        l->next = hashTable[h];
+        s->id = table->count;
+        s->builtin = NotBuiltin;
+        s->name = t->attr.name;
+        s->scope = scope;
+        s->lines = s->lastLine = newLineRec(ctx, t->lineno);
+        s->treeNode = t;
 
-        hashTable[h] = l;
+        table->slots[i] = table->count;
+        table->symbols[table->count++] = s;
+
+        return s;
 
     /* Symbol already exists, add a new line   */
     } else {
-        LineList ll = l->lines;
-
-        while (ll->next != NULL) {
-            ll = ll->next;
-        }
+        Symbol s = table->symbols[table->slots[i]];
 
-        ll->next = malloc(sizeof(struct LineListRec));
-        ll->next->lineno = t->lineno;
-        ll->next->next = NULL;
+        st_addLine(ctx, s, t->lineno);
+        return s;
     }
 }
 
-/*  st_lookup() → Checks if the identifier is already declared in the Symbol Table and return the result (NULL or treeNode pointer)  */
-TreeNode *st_lookup(TreeNode *t) {
-    int h = hash(t->attr.name, t->scope);
-    BucketList l = hashTable[h];
+/*  st_addLine() → Records one more use of an already resolved symbol  */
+void st_addLine(CompilerContext *ctx, Symbol s, int lineno) {
+    s->lastLine->next = newLineRec(ctx, lineno);
+    s->lastLine = s->lastLine->next;
+}
 
-    while (l != NULL) {
-        if (strcmp(t->attr.name, l->name) == 0) {
-            return l->treeNode;
-        }
-        l = l->next;
-    }
+/*  st_resolve() → Same search as st_lookup(), returning the symbol itself (or NULL)  */
+Symbol st_resolve(CompilerContext *ctx, TreeNode *t) {
+    Symbol s = lookupSymbol(&ctx->symbolTable, t->attr.name, t->scope);
+
+    if (s != NULL) return s;
 
     if (t->nodekind == NodeExpression &&
        (t->kind.exp == ExpID) ||
         t->kind.exp == ExpCall)
     {
-        h = hash(t->attr.name, "global");
-        l = hashTable[h];
+        s = lookupSymbol(&ctx->symbolTable, t->attr.name, ctx->globalScope);
+    }
 
-        while (l != NULL) {
-            if (strcmp(t->attr.name, l->name) == 0) {
-                return l->treeNode;
-            }
-            l = l->next;
+    return s;
+}
+
+/*  st_lookup() → Checks if the identifier is already declared in the Symbol Table and return the result (NULL or treeNode pointer)  */
+TreeNode *st_lookup(CompilerContext *ctx, TreeNode *t) {
+    Symbol s = st_resolve(ctx, t);
+
+    return (s != NULL) ? s->treeNode : NULL;
+}
+
+/*  st_copy() → Adds a copy of a symbol under another name and scope (the locals of an inlined function); it is only
+ *  reached by its ID, never looked up by name  */
+Symbol st_copy(CompilerContext *ctx, Symbol s, char *name, char *scope) {
+    SymbolTable *table = &ctx->symbolTable;
+
+    if (table->count == table->symbolsCapacity) {
+        table->symbolsCapacity = (table->symbolsCapacity == 0) ? SYMTAB_INITIAL : table->symbolsCapacity * 2;
+        table->symbols = realloc(table->symbols, table->symbolsCapacity * sizeof(Symbol));
+
+        if (table->symbols == NULL) {
+            printf("> Misc Error\n     Out of memory error. (Symbol Table)\n");
+            exit(EXIT_FAILURE);
         }
     }
 
-    return NULL;
+    Symbol copy = arenaAlloc(&ctx->arena, sizeof(struct SymbolRec));
+
+    *copy = *s;
+    copy->id = table->count;
+    copy->name = name;
+    copy->scope = scope;
+
+    table->symbols[table->count++] = copy;
+
+    return copy;
+}
+
+/*  st_bind() → Caches a resolved symbol (and its ID) on an AST node  */
+void st_bind(TreeNode *t, Symbol s) {
+    t->symbol = s;
+    t->symbolId = s->id;
+}
+
+/*  st_release() → Releases the Symbol Table (symbols and lines belong to the arena)  */
+void st_release(SymbolTable *table) {
+    free(table->slots);
+    free(table->symbols);
+
+    memset(table, 0, sizeof(SymbolTable));
 }
 
 /*  printSymbolTable() → Prints the Symbol Table for debugging and/or viewing   */
-void printSymbolTable() {
-    newLine();
-    printf("> Semantic Analysis --------------------------------------------------------\n");
-    printf("\t\t\t    Symbol Table                 [%s]", source);
-    printBars();
-    printf("↓ Kind\t\t↓ Type\t\t↓ Name\t\t↓ Scope\t\t↓ At line(s)");
-    printBars();
-
-    for (int i = 0; i < HASH_SIZE; i++) {
-        BucketList l = hashTable[i];
-
-        while (l != NULL) {
-            if(l->treeNode->kind.decl == DeclArray) printf("%s[%d]", declKindToString(l->treeNode->kind.decl), l->treeNode->attr.arrayAttr.size);
-            else printf("%s", declKindToString(l->treeNode->kind.decl));
-
-            printf("\t%s", expTypeToString(l->treeNode->type));
-            printf("\t\t%s", l->name);
-            printf("\t\t%s\t\t", l->scope);
-
-            int firstLoop = 1;
-            LineList lines = l->lines;
-
-            while (lines != NULL) {
-                if (firstLoop) {
-                    firstLoop = 0;
-                    printf("~%d", lines->lineno);
-                } else printf("%d", lines->lineno);
-                
-                if(lines->next != NULL) {
-                    printf(", ");
-                }
-
-                lines = lines->next;
-            }
+void printSymbolTable(CompilerContext *ctx) {
+    newLine(ctx);
+    fprintf(ctx->listing, "> Semantic Analysis --------------------------------------------------------\n");
+    fprintf(ctx->listing, "\t\t\t    Symbol Table                 [%s]", ctx->source);
+    printBars(ctx);
+    fprintf(ctx->listing, "↓ Kind\t\t↓ Type\t\t↓ Name\t\t↓ Scope\t\t↓ At line(s)");
+    printBars(ctx);
+
+    for (int i = 0; i < ctx->symbolTable.count; i++) {
+        Symbol l = ctx->symbolTable.symbols[i];
+
+        if(l->treeNode->kind.decl == DeclArray) fprintf(ctx->listing, "%s[%d]", declKindToString(l->treeNode->kind.decl), l->treeNode->attr.arrayAttr.size);
+        else fprintf(ctx->listing, "%s", declKindToString(l->treeNode->kind.decl));
+
+        fprintf(ctx->listing, "\t%s", expTypeToString(l->treeNode->type));
+        fprintf(ctx->listing, "\t\t%s", l->name);
+        fprintf(ctx->listing, "\t\t%s\t\t", l->scope);
 
-            newLine();
+        int firstLoop = 1;
+        LineList lines = l->lines;
+
+        while (lines != NULL) {
+            if (firstLoop) {
+                firstLoop = 0;
+                fprintf(ctx->listing, "~%d", lines->lineno);
+            } else fprintf(ctx->listing, "%d", lines->lineno);
             
-            l = l->next;
+            if(lines->next != NULL) {
+                fprintf(ctx->listing, ", ");
+            }
+
+            lines = lines->next;
         }
+
+        newLine(ctx);
     }
 
-    printf("\n*[~line]: \"line\" = declaration line.");
-    printBars();
-}
\ No newline at end of file
+    fprintf(ctx->listing, "\n*[~line]: \"line\" = declaration line.");
+    printBars(ctx);
+}
+
+/*  printSymbolStats() → Prints the size, load, collisions and probe lengths of the Symbol Table  */
+void printSymbolStats(CompilerContext *ctx) {
+    SymbolTable *table = &ctx->symbolTable;
+    SymbolStats *stats = &table->stats;
+
+    fprintf(ctx->listing, "\n> Symbol Table: %d symbol(s) in %d slot(s) (load %.2f, %d resize(s)), %ld lookup(s), %.2f probe(s) per lookup, max. probe %d, %ld collision(s)\n",
+        table->count, table->capacity, (table->capacity) ? (double)table->count / table->capacity : 0.0, stats->resizes,
+        stats->lookups, (stats->lookups) ? (double)stats->probes / stats->lookups : 0.0, stats->maxProbe, stats->collisions);
+}
@@ -12,32 +12,85 @@
  *  Symbol Table structure
  *---------------------------------*/
 
+#define SYMTAB_INITIAL 256
+
 /*  LineList → Linked list containing all lines of code where the symbol was used  */
 typedef struct LineListRec {
     int lineno;
     struct LineListRec *next;
 } *LineList;
 
-/*  BucketList → Bucket list that stores a symbol, its scope, usage lines, AST node, and points to the next symbol in case of a hash table collision  */
-typedef struct BucketListRec {
+/*  Builtin → Predefined function a symbol stands for (see initPredefinedFunctions())  */
+typedef enum {
+    NotBuiltin,
+    BuiltinHalt, BuiltinExecute, BuiltinSetupProgram, BuiltinExecuteRR,
+    BuiltinPeek, BuiltinInput, BuiltinUART, BuiltinOutput,
+    BuiltinLoadHD, BuiltinStoreHD, BuiltinHDtoIM, BuiltinLCDwrite
+} Builtin;
+
+/*  Symbol → A symbol (interned name and scope), its ID (declaration order), usage lines (with the tail, for O(1)
+ *  recording), AST node and, for predefined functions, which one it is  */
+typedef struct SymbolRec {
+    int id;
+    Builtin builtin;
     char *name;
     char *scope;
     LineList lines;
+    LineList lastLine;
     TreeNode *treeNode;
-    struct BucketListRec *next;
-} *BucketList;
+} *Symbol;
+
+/*  SymbolStats → Behaviour of the Symbol Table, to watch it on big inputs  */
+typedef struct {
+    long lookups;
+    long probes;
+    long collisions;
+    int maxProbe;
+    int resizes;
+} SymbolStats;
+
+/*  SymbolTable → Resizable open addressed table keyed by (name, scope) handles; slots hold indexes into "symbols",
+ *  which keeps every symbol in declaration order  */
+typedef struct {
+    int *slots;
+    int capacity;
+
+    Symbol *symbols;
+    int count;
+    int symbolsCapacity;
+
+    SymbolStats stats;
+} SymbolTable;
 
 /*--------------------------------------------/
  *  Symbol Table functions
  *---------------------------------*/
 
-/*  st_insert() → Inserts or updates an identifier in the Symbol Table  */
-void st_insert(TreeNode *t, char *scope);
+/*  st_insert() → Inserts or updates an identifier in the Symbol Table and returns its symbol  */
+Symbol st_insert(CompilerContext *ctx, TreeNode *t, char *scope);
 
 /*  st_lookup() → Checks if the identifier is already declared in the Symbol Table and return the result (NULL or treeNode pointer)  */
-TreeNode *st_lookup(TreeNode *t);
+TreeNode *st_lookup(CompilerContext *ctx, TreeNode *t);
+
+/*  st_resolve() → Same search as st_lookup(), returning the symbol itself (or NULL)  */
+Symbol st_resolve(CompilerContext *ctx, TreeNode *t);
+
+/*  st_addLine() → Records one more use of an already resolved symbol  */
+void st_addLine(CompilerContext *ctx, Symbol s, int lineno);
+
+/*  st_copy() → Adds a copy of a symbol under another name and scope (reached by its ID only, never looked up)  */
+Symbol st_copy(CompilerContext *ctx, Symbol s, char *name, char *scope);
+
+/*  st_bind() → Caches a resolved symbol (and its ID) on an AST node  */
+void st_bind(TreeNode *t, Symbol s);
 
 /*  printSymbolTable() → Prints the Symbol Table for debugging and/or viewing*/
-void printSymbolTable(void);
+void printSymbolTable(CompilerContext *ctx);
+
+/*  printSymbolStats() → Prints the size, load, collisions and probe lengths of the Symbol Table  */
+void printSymbolStats(CompilerContext *ctx);
+
+/*  st_release() → Releases the Symbol Table (symbols and lines belong to the arena)  */
+void st_release(SymbolTable *table);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,357 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Tail Call Elimination over the Quadruples List for a C- Compiler
+ *  File: tail_call.c
+ *---------------------------------*/
+
+#include "context.h"
+#include "optimizer.h"
+#include "utils.h"
+#include "cfg.h"
+
+/*  ValueKind → What a temporary (or a local) holds after a call, next to the call's result: something unrelated to it,
+ *  the result itself, or "operand op result"  */
+typedef enum { Unrelated, Result, Combined } ValueKind;
+
+typedef struct {
+    ValueKind kind;
+    Operation op;
+    Address operand;
+} Value;
+
+/*  TailKind → What becomes of a call: nothing, a jump back to the start of its own function (a loop), or a jump into
+ *  the callee that reuses the caller's frame  */
+typedef enum { NotTail, TailLoop, TailJump } TailKind;
+
+/*  TailSite → A call in tail position: the quadruples up to its return ("end", only labels may follow before FunEND),
+ *  what it returns and which of the quadruples after it (unrelated to its result) stay in a loop  */
+typedef struct {
+    TailKind kind;
+    int end;
+    bool returns;
+    Value value;
+    bool *keep;
+} TailSite;
+
+/*  Function → The function being rewritten: its quadruples [first, last], its return type, the label right before its
+ *  FunEND (NULL if none) and whether its frame may be reused (not main, no local arrays a call could get the address of)  */
+typedef struct {
+    char *name;
+    int first, last;
+    bool isVoid, reusable;
+    char *exit;
+} Function;
+
+/*--------------------------------------------/
+ *  Calls in tail position
+ *---------------------------------*/
+
+/*  isUserCall() → Whether the quadruple calls a user function  */
+static bool isUserCall(CompilerContext *ctx, QuadBuffer *q, int i) {
+    if (q->op[i] != Call) return false;
+    if (q->src[i].symbolId == NO_SYMBOL) return true;
+
+    return ctx->symbolTable.symbols[q->src[i].symbolId]->builtin == NotBuiltin;
+}
+
+/*  isLocal() → Whether a LoadVAR/StoreVAR variable lives in the function's frame (a call never writes it)  */
+static bool isLocal(CompilerContext *ctx, Address *var) {
+    return var->symbolId != NO_SYMBOL && ctx->symbolTable.symbols[var->symbolId]->scope != ctx->globalScope;
+}
+
+static Value valueOf(Value *temps, Address a) {
+    Value unrelated = { Unrelated };
+
+    return (a.type == addrTemp) ? temps[a.content.value] : unrelated;
+}
+
+/*  leaves() → Whether control at quadruple j goes straight to FunEND (through labels only, or a jump to the exit)  */
+static bool leaves(Function *f, QuadBuffer *q, int j) {
+    while (j < f->last && q->op[j] == Label) j++;
+
+    return j == f->last || (q->op[j] == Jump && f->exit != NULL && q->src[j].content.name == f->exit);
+}
+
+/*  findTail() → Follows what the function does after the call at quadruple i: copies of its result (through
+ *  temporaries and locals), computations unrelated to it and at most one Add/Mul of the result with an unrelated
+ *  operand, then a return of that value (or, in a void function, a plain return); anything else (a global, an array,
+ *  a branch, another call) and the call is not in tail position  */
+static bool findTail(CompilerContext *ctx, Function *f, QuadBuffer *q, int i, TailSite *site) {
+    Value *temps = allocOrDie(ctx->tempsCounter * sizeof(Value));
+    char **vars = allocOrDie((f->last - i) * sizeof(char *));
+    Value *values = allocOrDie((f->last - i) * sizeof(Value));
+    char *rf = internName(ctx, "r2");
+    int varsCount = 0;
+    bool tail = false;
+
+    site->keep = allocOrDie((f->last - i + 1) * sizeof(bool));
+
+    for (int j = i + 1; j <= f->last; j++) {
+        Operation op = q->op[j];
+        bool *keep = &site->keep[j - i];
+
+        /* A plain return (what follows leaves the function)   */
+        if (leaves(f, q, j)) {
+            site->end = (q->op[j] == Jump) ? j : j - 1;
+            tail = f->isVoid;
+            break;
+        }
+
+        /* The return of a value   */
+        if (op == Move && q->tgt[j].type == addrString && q->tgt[j].content.name == rf) {
+            site->returns = true;
+            site->value = valueOf(temps, q->src[j]);
+            site->end = (q->op[j + 1] == Jump) ? j + 1 : j;
+            tail = leaves(f, q, j + 1) && site->value.kind != Unrelated;
+            break;
+        }
+
+        if (op == Move && q->src[j].type == addrString && q->src[j].content.name == rf) {
+            if (q->tgt[j].type != addrTemp) break;
+            temps[q->tgt[j].content.value].kind = Result;
+        } else if (op == Move && q->tgt[j].type == addrTemp) {
+            temps[q->tgt[j].content.value] = valueOf(temps, q->src[j]);
+            *keep = (temps[q->tgt[j].content.value].kind == Unrelated);
+        } else if (op == LoadVAR && isLocal(ctx, &q->tgt[j])) {
+            int v = 0;
+
+            while (v < varsCount && vars[v] != q->tgt[j].content.name) v++;
+
+            temps[q->dst[j].content.value] = (v < varsCount) ? values[v] : (Value){ Unrelated };
+            *keep = (temps[q->dst[j].content.value].kind == Unrelated);
+        } else if (op == StoreVAR && isLocal(ctx, &q->dst[j])) {
+            int v = 0;
+
+            while (v < varsCount && vars[v] != q->dst[j].content.name) v++;
+            if (v == varsCount) vars[varsCount++] = q->dst[j].content.name;
+
+            values[v] = valueOf(temps, q->src[j]);
+            *keep = (values[v].kind == Unrelated);
+        } else if (operandRoles(op) == (USE_SRC | USE_TGT | DEF_DST)) {
+            Value a = valueOf(temps, q->src[j]), b = valueOf(temps, q->tgt[j]);
+            Value *result = &temps[q->dst[j].content.value];
+
+            if (a.kind == Unrelated && b.kind == Unrelated) {
+                result->kind = Unrelated;
+                *keep = true;
+            } else if ((op == Add || op == Mul) && a.kind == Result && b.kind == Unrelated) {
+                *result = (Value){ Combined, op, q->tgt[j] };
+            } else if ((op == Add || op == Mul) && b.kind == Result && a.kind == Unrelated) {
+                *result = (Value){ Combined, op, q->src[j] };
+            } else {
+                break;
+            }
+        } else {
+            break;
+        }
+    }
+
+    free(temps);
+    free(vars);
+    free(values);
+
+    return tail;
+}
+
+/*--------------------------------------------/
+ *  Rewriting
+ *---------------------------------*/
+
+/*  identity() → Whether "a" is the constant that leaves the accumulator's operation unchanged (0 for Add, 1 for Mul)  */
+static bool identity(Operation op, Address a) {
+    return a.type == addrConst && a.content.value == ((op == Add) ? 0 : 1);
+}
+
+static Address newTemp(CompilerContext *ctx) {
+    Address t = { addrTemp, NO_SYMBOL };
+
+    t.content.value = ctx->tempsCounter++;
+    return t;
+}
+
+/*  rewriteFunction() → Appends the function [first, last] to "out" with its tail calls eliminated: a call to itself
+ *  stores its arguments into the parameters and jumps back to a label after the allocations (all of them hoisted there,
+ *  so that each pass keeps the same frame); when the return combines the result with something else ("n * f(n - 1)"),
+ *  that goes into an accumulator every other return then applies. A tail call to another function keeps its Params
+ *  and becomes a jump the back end lowers over the caller's own frame  */
+static void rewriteFunction(CompilerContext *ctx, QuadBuffer *q, Function *f, QuadBuffer *out) {
+    int size = f->last - f->first + 1;
+    TailSite *sites = allocOrDie(size * sizeof(TailSite));
+    int *owner = allocOrDie(size * sizeof(int));
+    int *pending = allocOrDie(size * sizeof(int));
+    int pendingCount = 0, loops = 0;
+    bool accumulate = false;
+    Operation accOp = Add;
+
+    /* The call each Param belongs to: the last ones still pending at it   */
+    for (int i = f->first; i <= f->last; i++) {
+        if (q->op[i] == Param) pending[pendingCount++] = i;
+
+        if (q->op[i] == Call) {
+            for (int a = 0; a < q->tgt[i].content.value; a++) owner[pending[--pendingCount] - f->first] = i;
+        }
+    }
+
+    for (int i = f->first; i <= f->last && f->reusable; i++) {
+        TailSite *site = &sites[i - f->first];
+        char *callee = q->src[i].content.name;
+
+        if (!isUserCall(ctx, q, i) || callee == ctx->mainName || !findTail(ctx, f, q, i, site)) continue;
+
+        if (callee != f->name) {
+            site->kind = (site->value.kind == Combined) ? NotTail : TailJump;
+        } else if (site->value.kind != Combined) {
+            site->kind = TailLoop;
+        } else if (!accumulate || site->value.op == accOp) {
+            site->kind = TailLoop;
+            accumulate = true;
+            accOp = site->value.op;
+        }
+
+        if (site->kind == TailLoop) loops++;
+    }
+
+    /* With an accumulator every return applies it: a call elsewhere can no longer be the function's last act   */
+    for (int i = 0; i < size && accumulate; i++) {
+        if (sites[i].kind == TailJump) sites[i].kind = NotTail;
+    }
+
+    Address empty = { addrVoid, NO_SYMBOL };
+    Address scope = { addrString, NO_SYMBOL };
+    Address acc = { addrString, NO_SYMBOL };
+    Address loop = { addrString, NO_SYMBOL };
+    Address tail = { addrString, NO_SYMBOL };
+    char *rf = internName(ctx, "r2");
+    char name[256];
+    int prologue = f->first + 1;
+
+    scope.content.name = f->name;
+    tail.content.name = internName(ctx, "tail");
+
+    while (prologue < f->last && (q->op[prologue] == AllocVAR || q->op[prologue] == AllocARRAY)) prologue++;
+
+    /* Prologue: FunBGN, the allocations (a loop takes those of nested blocks too), the accumulator and the loop label   */
+    for (int i = f->first; i < prologue; i++) appendQuad(out, q->op[i], q->src[i], q->tgt[i], q->dst[i]);
+
+    for (int i = prologue; i <= f->last && loops > 0; i++) {
+        if (q->op[i] == AllocVAR || q->op[i] == AllocARRAY) appendQuad(out, q->op[i], q->src[i], q->tgt[i], q->dst[i]);
+    }
+
+    if (accumulate) {
+        Address init = { addrConst, NO_SYMBOL };
+
+        snprintf(name, sizeof(name), "%s.acc", f->name);
+        acc.content.name = internName(ctx, name);
+
+        Symbol s = st_copy(ctx, ctx->symbolTable.symbols[q->src[f->first].symbolId], acc.content.name, f->name);
+        s->treeNode = NULL;
+        acc.symbolId = s->id;
+
+        init.content.value = (accOp == Add) ? 0 : 1;
+
+        appendQuad(out, AllocVAR, scope, acc, empty);
+        appendQuad(out, StoreVAR, init, scope, acc);
+        ctx->optStats.accumulators++;
+    }
+
+    if (loops > 0) {
+        sprintf(name, "l%d", ctx->labelsCounter++);
+        loop.content.name = internName(ctx, name);
+
+        appendQuad(out, Label, loop, empty, empty);
+    }
+
+    for (int i = prologue; i <= f->last; i++) {
+        TailSite *site = &sites[i - f->first];
+
+        if (loops > 0 && (q->op[i] == AllocVAR || q->op[i] == AllocARRAY)) continue;
+        if (q->op[i] == Param && owner[i - f->first] > 0 && sites[owner[i - f->first] - f->first].kind == TailLoop) continue;
+
+        if (site->kind == TailJump) {
+            appendQuad(out, Call, q->src[i], q->tgt[i], tail);
+            ctx->optStats.tailJumps++;
+            i = site->end;
+            continue;
+        }
+
+        if (site->kind == TailLoop) {
+            int param = f->first + 1;
+
+            for (int k = i + 1; k <= site->end; k++) {
+                if (site->keep[k - i]) appendQuad(out, q->op[k], q->src[k], q->tgt[k], q->dst[k]);
+            }
+
+            if (site->returns && site->value.kind == Combined) {
+                Address a = newTemp(ctx), b = newTemp(ctx);
+
+                appendQuad(out, LoadVAR, scope, acc, a);
+                appendQuad(out, accOp, a, site->value.operand, b);
+                appendQuad(out, StoreVAR, b, scope, acc);
+            }
+
+            /* The arguments (already computed) go into the parameters, the first allocations of the function   */
+            for (int k = f->first; k < i; k++) {
+                if (q->op[k] != Param || owner[k - f->first] != i) continue;
+
+                appendQuad(out, StoreVAR, q->src[k], scope, q->tgt[param++]);
+            }
+            appendQuad(out, Jump, loop, empty, empty);
+
+            ctx->optStats.tailLoops++;
+            i = site->end;
+            continue;
+        }
+
+        /* Any other return hands back the accumulator applied to its value   */
+        if (accumulate && q->op[i] == Move && q->tgt[i].type == addrString && q->tgt[i].content.name == rf) {
+            Address a = newTemp(ctx), b = newTemp(ctx);
+
+            appendQuad(out, LoadVAR, scope, acc, a);
+
+            if (identity(accOp, q->src[i])) {
+                appendQuad(out, Move, a, q->tgt[i], empty);
+            } else {
+                appendQuad(out, accOp, a, q->src[i], b);
+                appendQuad(out, Move, b, q->tgt[i], empty);
+            }
+            continue;
+        }
+
+        appendQuad(out, q->op[i], q->src[i], q->tgt[i], q->dst[i]);
+    }
+
+    for (int i = 0; i < size; i++) free(sites[i].keep);
+    free(sites);
+    free(owner);
+    free(pending);
+}
+
+/*  eliminateTailCalls() → Turns the self recursive calls in tail position into loops (through an accumulator when the
+ *  result is added to or multiplied by something first) and the other tail calls into jumps that reuse the frame  */
+void eliminateTailCalls(CompilerContext *ctx) {
+    QuadBuffer *q = &ctx->quadruples;
+    QuadBuffer out = { 0 };
+    int first, last, next = 0;
+
+    for (first = nextFunction(q, 0, &last); first >= 0; first = nextFunction(q, last + 1, &last)) {
+        Function f = { q->src[first].content.name, first, last };
+
+        f.isVoid = strcmp(q->tgt[first].content.name, "void") == 0;
+        f.reusable = f.name != ctx->mainName;
+        f.exit = (q->op[last - 1] == Label) ? q->src[last - 1].content.name : NULL;
+
+        for (int i = first; i <= last; i++) {
+            if (q->op[i] == AllocARRAY && q->dst[i].content.value > 0) f.reusable = false;
+        }
+
+        /* What lies between functions (globals, End) stays   */
+        for (; next < first; next++) appendQuad(&out, q->op[next], q->src[next], q->tgt[next], q->dst[next]);
+
+        rewriteFunction(ctx, q, &f, &out);
+        next = last + 1;
+    }
+
+    for (; next < q->count; next++) appendQuad(&out, q->op[next], q->src[next], q->tgt[next], q->dst[next]);
+
+    freeQuads(q);
+    *q = out;
+}
@@ -0,0 +1,98 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Tracing for a C- Compiler
+ *  File: trace.c
+ *---------------------------------*/
+
+#include "trace.h"
+#include "context.h"
+#include "utils.h"
+
+/*  traceCategories → Categories selected for every compilation of the process (none by default)  */
+unsigned traceCategories = 0;
+
+/*  categoryNames[] → Name of each category (bit i), as selected on the command line and written in the log  */
+static const char *categoryNames[] = { "scan", "parse", "semantic", "midcode", "assembly", "binary" };
+
+#define CATEGORIES (int)(sizeof(categoryNames) / sizeof(categoryNames[0]))
+
+/*  parseTraceCategories() → Reads a comma separated list of categories ("scan,parse,semantic,midcode,assembly,binary" or
+ *  "all"); false on an unknown one  */
+bool parseTraceCategories(const char *list, unsigned *categories) {
+    *categories = 0;
+
+    while (*list != '\0') {
+        size_t length = strcspn(list, ",");
+        bool known = false;
+
+        if (length == 3 && strncmp(list, "all", 3) == 0) {
+            *categories |= TraceAll;
+            known = true;
+        }
+        for (int i = 0; i < CATEGORIES && !known; i++) {
+            if (strlen(categoryNames[i]) == length && strncmp(list, categoryNames[i], length) == 0) {
+                *categories |= 1u << i;
+                known = true;
+            }
+        }
+        if (!known && length > 0) return false;
+
+        list += length;
+        if (*list == ',') list++;
+    }
+    return true;
+}
+
+/*  traceOpen() → Starts the trace log of a compilation when any category is selected; the back end stages append to it  */
+void traceOpen(CompilerContext *ctx, const char *path) {
+    if (!tracing(TraceAll)) return;
+
+    ctx->trace.file = fopen(path, "w");
+    if (ctx->trace.file == NULL) {
+        fprintf(ctx->listing, "> Misc Error\n     Could not create \"%s\".\n", path);
+        return;
+    }
+
+    ctx->trace.buffer = malloc(TRACE_BUFFER);
+    if (ctx->trace.buffer != NULL) setvbuf(ctx->trace.file, ctx->trace.buffer, _IOFBF, TRACE_BUFFER);
+}
+
+/*  traceToken() → Logs a token the scanner returned as a compact "line TOKEN lexeme" record  */
+void traceToken(CompilerContext *ctx, int token, const char *lexeme) {
+    if (ctx->trace.file == NULL) return;
+
+    if (ctx->firstToken) {
+        ctx->firstToken = false;
+        fprintf(ctx->trace.file, "@scan\n");
+    }
+    fprintf(ctx->trace.file, "%d\t%s\t%s\n", ctx->lineno, tokenToString(token), (token == 0) ? "" : lexeme);
+}
+
+/*  beginTrace() → Opens the section of a category in the trace log if it is selected; until endTrace() the listing
+ *  points to the log, so the dumps (AST, Symbol Table, Quadruples List, CFGs) land there  */
+bool beginTrace(CompilerContext *ctx, TraceCategory category) {
+    if (!tracing(category) || ctx->trace.file == NULL) return false;
+
+    for (int i = 0; i < CATEGORIES; i++) {
+        if (category == 1u << i) fprintf(ctx->trace.file, "@%s\n", categoryNames[i]);
+    }
+
+    ctx->trace.listing = ctx->listing;
+    ctx->listing = ctx->trace.file;
+    return true;
+}
+
+/*  endTrace() → Gives the listing back after a traced dump  */
+void endTrace(CompilerContext *ctx) {
+    if (ctx->trace.listing != NULL) ctx->listing = ctx->trace.listing;
+    ctx->trace.listing = NULL;
+}
+
+/*  traceClose() → Flushes and closes the trace log of a compilation  */
+void traceClose(CompilerContext *ctx) {
+    endTrace(ctx);
+
+    if (ctx->trace.file != NULL) fclose(ctx->trace.file);
+    free(ctx->trace.buffer);
+
+    ctx->trace = (TraceLog){ NULL, NULL, NULL };
+}
@@ -0,0 +1,71 @@
+/*-------------------------------------------------------------------------------------------------/
+ *  Tracing interface for a C- Compiler
+ *  File: trace.h
+ *---------------------------------*/
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "globals.h"
+
+/*--------------------------------------------/
+ *  Tracing structure
+ *---------------------------------*/
+
+/*  TraceCategory → What can be traced, one bit each; the Python back end stages trace the last two  */
+typedef enum {
+    TraceScan     = 1 << 0,
+    TraceParse    = 1 << 1,
+    TraceSemantic = 1 << 2,
+    TraceMidCode  = 1 << 3,
+    TraceAssembly = 1 << 4,
+    TraceBinary   = 1 << 5,
+    TraceAll      = (1 << 6) - 1
+} TraceCategory;
+
+/*  traceCategories → Categories selected for every compilation of the process (none by default)  */
+extern unsigned traceCategories;
+
+/*  tracing() → Whether a category is selected: a single bit test, or nothing at all when built with -DTRACE_DISABLED  */
+#ifdef TRACE_DISABLED
+#define tracing(category) false
+#else
+#define tracing(category) ((traceCategories & (category)) != 0)
+#endif
+
+/*  TRACE_BUFFER → Bytes the trace log buffers before it writes (traces never reach the terminal while compiling)  */
+#define TRACE_BUFFER (1 << 20)
+
+/*  TraceLog → Buffered trace log of one compilation (NULL when nothing is traced), and the listing it stands in for
+ *  while a dump is being traced  */
+typedef struct {
+    FILE *file;
+    FILE *listing;
+    char *buffer;
+} TraceLog;
+
+/*--------------------------------------------/
+ *  Tracing functions
+ *---------------------------------*/
+
+/*  parseTraceCategories() → Reads a comma separated list of categories ("scan,parse,semantic,midcode,assembly,binary" or
+ *  "all"); false on an unknown one  */
+bool parseTraceCategories(const char *list, unsigned *categories);
+
+/*  traceOpen() → Starts the trace log of a compilation when any category is selected; the back end stages append to it  */
+void traceOpen(CompilerContext *ctx, const char *path);
+
+/*  traceToken() → Logs a token the scanner returned as a compact "line TOKEN lexeme" record  */
+void traceToken(CompilerContext *ctx, int token, const char *lexeme);
+
+/*  beginTrace() → Opens the section of a category in the trace log if it is selected; until endTrace() the listing
+ *  points to the log, so the dumps (AST, Symbol Table, Quadruples List, CFGs) land there  */
+bool beginTrace(CompilerContext *ctx, TraceCategory category);
+
+/*  endTrace() → Gives the listing back after a traced dump  */
+void endTrace(CompilerContext *ctx);
+
+/*  traceClose() → Flushes and closes the trace log of a compilation  */
+void traceClose(CompilerContext *ctx);
+
+#endif
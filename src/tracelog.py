@@ -0,0 +1,112 @@
+import sys
+from typing import List, Optional, TextIO
+
+# Bytes a back end stage buffers before it writes to the trace log
+traceBuffer = 1 << 20
+
+bars = "----------------------------------------------------------------------------"
+
+# traceOption() → Takes "--trace <file>" out of the command line and opens that log for appending (the front end
+# started it, see trace.c); None, and nothing traced, without it
+def traceOption(argv: List[str]) -> Optional[TextIO]:
+    if ("--trace" not in argv):
+        return None
+
+    index = argv.index("--trace")
+    path = argv[index + 1] if index + 1 < len(argv) else None
+    del argv[index:index + 2]
+
+    return open(path, 'a', buffering=traceBuffer) if (path is not None) else None
+
+# section() → Starts the section of a category in the trace log; its records follow, one per line, fields split by tabs
+def section(trace: TextIO, category: str):
+    trace.write(f"@{category}\n")
+
+# renderScan() → "line TOKEN lexeme" records, printed as the scanner used to trace them, line jumps included
+def renderScan(records: List[str]):
+    print(f"\n> Lexical Analysis --------------------------------------------------------\n{bars}\n")
+    line = None
+
+    for record in records:
+        number, token, lexeme = (record.split("\t") + ["", ""])[:3]
+        if (number != line):
+            line = number
+            print(f"--- Line {line}")
+        if (lexeme == ""):
+            print(f"END OF FILE → ({token})")
+        else:
+            print(f"{lexeme} → ({token})")
+
+def renderParse(records: List[str]):
+    print(f"\n> Syntax Analysis ----------------------------------------------------------\n{bars}")
+    print("\n".join(records))
+    print("\n> END OF FILE → (EOF)")
+
+# renderAssembly() → "Q op src tgt dst" (quadruples read) and "I instr src tgt dst" (instructions generated) records
+def renderAssembly(records: List[str]):
+    print(f"\n> Assembly Code Tracing ----------------------------------------------------\n{bars}")
+
+    for i, record in enumerate(records):
+        kind, op, src, tgt, dst = record.split("\t")
+        if (kind == "Q"):
+            print(f"        > Quad. [{i:02}]: ({op}, {src}, {tgt}, {dst})")
+        else:
+            print(f"        > Instr. [{i:02}]: ({op}, {src}, {tgt}, {dst})")
+
+# renderBinary() → "instr src tgt dst word" records, one per encoded instruction
+def renderBinary(records: List[str]):
+    print(f"\n> Binary Code Tracing ------------------------------------------------------\n{bars} -")
+
+    for i, record in enumerate(records):
+        instr, src, tgt, dst, word = record.split("\t")
+        print(f"    > [{i}] {instr} {src} {tgt} {dst}\n        {word}")
+
+# The Semantic Analysis and Intermediate Code dumps carry their own headers: they are printed as they are
+renderers = {
+    "scan":     renderScan,
+    "parse":    renderParse,
+    "semantic": lambda records: print("\n".join(records)),
+    "midcode":  lambda records: print("\n".join(records)),
+    "assembly": renderAssembly,
+    "binary":   renderBinary,
+}
+
+# render() → Prints every section of a trace log (only those of "categories", when given) in the order they were logged
+def render(path: str, categories: Optional[List[str]] = None):
+    category = None
+    records = []
+
+    def flush():
+        if (category is not None and (categories is None or category in categories)):
+            renderers[category](records)
+
+    with open(path, 'r') as trace:
+        for line in trace:
+            line = line.rstrip("\n")
+            if (line.startswith("@") and line[1:] in renderers):
+                flush()
+                category = line[1:]
+                records = []
+            else:
+                records.append(line)
+    flush()
+
+def main(argv: List[str]):
+    # Usage: tracelog.py [trace.log] [--only scan,parse,semantic,midcode,assembly,binary]
+    categories = None
+    if ("--only" in argv):
+        index = argv.index("--only")
+        categories = argv[index + 1].split(",") if index + 1 < len(argv) else []
+        del argv[index:index + 2]
+
+    paths = [arg for arg in argv if not arg.startswith("-")]
+    path = paths[0] if len(paths) > 0 else "outputs/trace.log"
+
+    try:
+        render(path, categories)
+    except FileNotFoundError:
+        print(f"> Misc Error\n     Could not read \"{path}\".")
+        sys.exit(1)
+
+if __name__ == "__main__":
+    main(sys.argv[1:])
@@ -5,29 +5,28 @@
 
 #define _DEFAULT_SOURCE
 
+#include "context.h"
 #include "utils.h"
 #include "parser.tab.h"
 
+#include <time.h>
+#include <sys/resource.h>
+
 #define MAX_NAME 256
 #define MAX_FILES 100
 
-char source[512];
-
-static int indent = 0;
-
 #define INDENT indent += 2
-#define UNINDENT indent -= 2
 
 /*--------------------------------------------/
  *  Indentation and Design functions
  *---------------------------------*/
 
-void newLine(void) {
-    printf("\n");
+void newLine(CompilerContext *ctx) {
+    fprintf(ctx->listing, "\n");
 }
 
-void printBars(void) {
-    printf("\n----------------------------------------------------------------------------\n");
+void printBars(CompilerContext *ctx) {
+    fprintf(ctx->listing, "\n----------------------------------------------------------------------------\n");
 }
 
 /*--------------------------------------------/
@@ -35,11 +34,12 @@ void printBars(void) {
  *---------------------------------*/
 
 /*  inputSelect() → Searches for the input folder provided and lists the files, allowing you to select one to use   */
-void inputSelect(void) {
+void inputSelect(CompilerContext *ctx) {
   char files[MAX_FILES][MAX_NAME];
+  char source[512], midcode[512];
   int count = 0;
 
-  newLine();
+  newLine(ctx);
 
   const char *folder = INPUT_DIR;
   DIR *dir = opendir(folder);
@@ -65,7 +65,7 @@ void inputSelect(void) {
       exit(EXIT_FAILURE);
   }
 
-  newLine();
+  newLine(ctx);
 
   int choice;
   printf("> Enter the desired file number: ");
@@ -79,9 +79,9 @@ void inputSelect(void) {
   printf("\n> Chosen file: [%s]\n", files[choice]);
 
   snprintf(source, sizeof(source), "%s/%s", folder, files[choice]);
-  yyin = fopen(source, "r");
+  snprintf(midcode, sizeof(midcode), "%s/midcode.ir", OUTPUT_DIR);
 
-  if (!yyin) {
+  if (!openSource(ctx, source, midcode)) {
       perror("> Misc Error\n     Invalid file.\n");
       exit(EXIT_FAILURE);
   }
@@ -185,20 +185,94 @@ const char *declKindToString(DeclKind declKind) {
   }
 }
 
+/*  internName() → Canonical copy of a name (identifier, scope, register or label): equal names share one pointer   */
+char *internName(CompilerContext *ctx, const char *s) {
+    if (s == NULL) return NULL;
+    return intern(&ctx->names, &ctx->arena, s);
+}
+
+/*  allocOrDie() → Zeroed block of "size" bytes for the working arrays of the passes; running out of memory ends the compiler   */
+void *allocOrDie(size_t size) {
+    void *p = calloc(1, (size == 0) ? 1 : size);
+
+    if (p == NULL) {
+        printf("> Misc Error\n     Out of memory error.\n");
+        exit(EXIT_FAILURE);
+    }
+    return p;
+}
+
+/*  printMemoryReport() → Prints how much memory the compilation needed (arena and Quadruples List)   */
+void printMemoryReport(CompilerContext *ctx) {
+    size_t quads = ctx->quadruples.capacity * (sizeof(Operation) + 3 * sizeof(Address));
+
+    fprintf(ctx->listing, "\n> Memory: %.1f KiB used of %.1f KiB reserved in %d arena block(s), %d distinct name(s), %.1f KiB of quadruples → peak %.1f KiB\n",
+        ctx->arena.allocated / 1024.0, ctx->arena.reserved / 1024.0, ctx->arena.blocksCount, ctx->names.count, quads / 1024.0, contextMemory(ctx) / 1024.0);
+}
+
+/*  now() → Monotonic wall clock in seconds   */
+double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*  countLines() → Counts the source lines of a file (a last line without its newline included), 0 if it cannot be read   */
+long countLines(const char *path) {
+    FILE *file = fopen(path, "r");
+    long lines = 0;
+    int c, last = '\n';
+
+    if (file == NULL) return 0;
+
+    while ((c = fgetc(file)) != EOF) {
+        if (c == '\n') lines++;
+        last = c;
+    }
+    if (last != '\n') lines++;
+
+    fclose(file);
+    return lines;
+}
+
+/*  peakRSS() → Peak resident set size of the process, in KiB (since the kernel's peak was last reset through
+ *  /proc/self/clear_refs, where it can be)   */
+long peakRSS(void) {
+    FILE *status = fopen("/proc/self/status", "r");
+    char line[256];
+    long peak = -1;
+
+    if (status != NULL) {
+        while (fgets(line, sizeof(line), status) != NULL) {
+            if (sscanf(line, "VmHWM: %ld", &peak) == 1) break;
+        }
+        fclose(status);
+    }
+
+    if (peak < 0) {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        peak = usage.ru_maxrss;
+    }
+    return peak;
+}
+
 /*--------------------------------------------/
  *  Abstract Syntax Tree (AST) functions
  *---------------------------------*/
 
-TreeNode *newDeclNode(DeclKind kind) {
-    TreeNode *t = (TreeNode *)malloc(sizeof(TreeNode));
+TreeNode *newDeclNode(CompilerContext *ctx, DeclKind kind) {
+    TreeNode *t = (TreeNode *)arenaAlloc(&ctx->arena, sizeof(TreeNode));
+    ctx->metrics.astNodes++;
 
     if (t == NULL) {
-      printf("> Misc Error\n   Line %d - Out of memory error. (Declaration Node)\n", yylineno);
+      fprintf(ctx->listing, "> Misc Error\n   Line %d - Out of memory error. (Declaration Node)\n", ctx->lineno);
     } else {
       for (int i = 0; i < MAXCHILDREN; i++) t->child[i] = NULL;
       t->sibling = NULL;
       
-      t->lineno = yylineno;
+      t->lineno = ctx->lineno;
+      t->symbolId = NO_SYMBOL;
 
       t->nodekind = NodeDeclaration;
       t->kind.decl = kind;
@@ -206,16 +280,18 @@ TreeNode *newDeclNode(DeclKind kind) {
     return t;
 }
 
-TreeNode *newStmtNode(StmtKind kind) {
-    TreeNode *t = (TreeNode *)malloc(sizeof(TreeNode));
+TreeNode *newStmtNode(CompilerContext *ctx, StmtKind kind) {
+    TreeNode *t = (TreeNode *)arenaAlloc(&ctx->arena, sizeof(TreeNode));
+    ctx->metrics.astNodes++;
 
     if (t == NULL) {
-      printf("> Misc Error\n   Line %d - Out of memory error. (Statement Node)\n", yylineno);
+      fprintf(ctx->listing, "> Misc Error\n   Line %d - Out of memory error. (Statement Node)\n", ctx->lineno);
     } else {
       for (int i = 0; i < MAXCHILDREN; i++) t->child[i] = NULL;
       t->sibling = NULL;
       
-      t->lineno = yylineno;
+      t->lineno = ctx->lineno;
+      t->symbolId = NO_SYMBOL;
 
       t->nodekind = NodeStatement;
       t->kind.stmt = kind;
@@ -223,16 +299,18 @@ TreeNode *newStmtNode(StmtKind kind) {
     return t;
 }
 
-TreeNode *newExpNode(ExpKind kind) {
-    TreeNode *t = (TreeNode *)malloc(sizeof(TreeNode));
+TreeNode *newExpNode(CompilerContext *ctx, ExpKind kind) {
+    TreeNode *t = (TreeNode *)arenaAlloc(&ctx->arena, sizeof(TreeNode));
+    ctx->metrics.astNodes++;
 
     if (t == NULL) {
-      printf("> Misc Error\n   Line %d - Out of memory error. (Expression Node)\n", yylineno);
+      fprintf(ctx->listing, "> Misc Error\n   Line %d - Out of memory error. (Expression Node)\n", ctx->lineno);
     } else {
       for (int i = 0; i < MAXCHILDREN; i++) t->child[i] = NULL;
       t->sibling = NULL;
       
-      t->lineno = yylineno;
+      t->lineno = ctx->lineno;
+      t->symbolId = NO_SYMBOL;
 
       t->nodekind = NodeExpression;
       t->kind.exp = kind;
@@ -255,7 +333,7 @@ TreeNode *addSibling(TreeNode *t, TreeNode *sibling) {
 /*  insertScope() → [TODO]   */
 void insertScope(TreeNode *t, char *scope) {
   while (t != NULL) {
-    t->scope = strdup(scope);
+    t->scope = scope;
 
     for (int i=0; i<MAXCHILDREN; i++) {
       if (t->child[i] != NULL) {
@@ -268,44 +346,44 @@ void insertScope(TreeNode *t, char *scope) {
 }
 
 /*  printIndent() → Prints out indentation using the "indent" variable   */
-static void printIndent(void) {
-    for (int i = 0; i < indent; i++) printf(" ");
+static void printIndent(CompilerContext *ctx, int indent) {
+    for (int i = 0; i < indent; i++) fprintf(ctx->listing, " ");
 }
 
-/*  printTree() → Prints the Abstract Syntax Tree (AST) in a hierarchical format   */
-void printTree(TreeNode *t) {
+/*  printSubtree() → Prints a subtree of the AST, "indent" spaces deep   */
+static void printSubtree(CompilerContext *ctx, TreeNode *t, int indent) {
   INDENT;
   while (t != NULL) {
     switch (t->nodekind) {
       case NodeDeclaration:
         switch (t->kind.decl) {
           case DeclVariable:
-            printIndent();
-            printf("%s %s;", expTypeToString(t->type), t->attr.name);
-            printf(" → Variable declaration at line %d\n", t->lineno);
+            printIndent(ctx, indent);
+            fprintf(ctx->listing, "%s %s;", expTypeToString(t->type), t->attr.name);
+            fprintf(ctx->listing, " → Variable declaration at line %d\n", t->lineno);
             break;
           case DeclFunction:
-            printf("\n> Function declaration at line %d:\n", t->lineno);
-            printIndent();
-            printf("%s %s (...)\n", expTypeToString(t->type), t->attr.name);
+            fprintf(ctx->listing, "\n> Function declaration at line %d:\n", t->lineno);
+            printIndent(ctx, indent);
+            fprintf(ctx->listing, "%s %s (...)\n", expTypeToString(t->type), t->attr.name);
             break;
           case DeclParameter:
-            printIndent();
+            printIndent(ctx, indent);
             if (t->flags.isArray) {
-              printf("%s %s[]", expTypeToString(t->type), t->attr.arrayAttr.name);
-              printf(" → Parameter [Array]\n");
+              fprintf(ctx->listing, "%s %s[]", expTypeToString(t->type), t->attr.arrayAttr.name);
+              fprintf(ctx->listing, " → Parameter [Array]\n");
             } else {
-              printf("%s %s", expTypeToString(t->type), t->attr.name);
-              printf(" → Parameter\n");
+              fprintf(ctx->listing, "%s %s", expTypeToString(t->type), t->attr.name);
+              fprintf(ctx->listing, " → Parameter\n");
             }
             break;
             case DeclArray:
-              printIndent();
-              printf("%s %s[%d];", expTypeToString(t->type), t->attr.arrayAttr.name, t->attr.arrayAttr.size);
-              printf(" → Variable [Array] declaration at line %d\n", t->lineno);
+              printIndent(ctx, indent);
+              fprintf(ctx->listing, "%s %s[%d];", expTypeToString(t->type), t->attr.arrayAttr.name, t->attr.arrayAttr.size);
+              fprintf(ctx->listing, " → Variable [Array] declaration at line %d\n", t->lineno);
               break;
           default:
-            printf("- Unknown Declaration\n");
+            fprintf(ctx->listing, "- Unknown Declaration\n");
             break;
           }
           break;
@@ -313,73 +391,77 @@ void printTree(TreeNode *t) {
       case NodeStatement:
         switch (t->kind.stmt) {
           case StmtIf:
-            newLine();
-            printIndent();
-            printf("If (...)\n");
+            newLine(ctx);
+            printIndent(ctx, indent);
+            fprintf(ctx->listing, "If (...)\n");
             break;
           case StmtWhile:
-            newLine();
-            printIndent();
-            printf("While (...):\n");
+            newLine(ctx);
+            printIndent(ctx, indent);
+            fprintf(ctx->listing, "While (...):\n");
             break;
           case StmtAssign:
-            newLine();
-            printIndent();
-            printf("Assign [=] at line %d:\n", t->lineno);
+            newLine(ctx);
+            printIndent(ctx, indent);
+            fprintf(ctx->listing, "Assign [=] at line %d:\n", t->lineno);
             break;
           case StmtReturn:
-            newLine();
-            printIndent();
-            printf("Return at line %d:\n", t->lineno);
+            newLine(ctx);
+            printIndent(ctx, indent);
+            fprintf(ctx->listing, "Return at line %d:\n", t->lineno);
             break;
           case StmtCompound:
-            printIndent();
-            printf("{\n");
+            printIndent(ctx, indent);
+            fprintf(ctx->listing, "{\n");
             break;
           default:
-            printf("Unknown Statement\n");
+            fprintf(ctx->listing, "Unknown Statement\n");
             break;
         }
         break;
 
       case NodeExpression:
-        printIndent();
+        printIndent(ctx, indent);
         switch (t->kind.exp) {
           case  ExpOperator:
-            printf("Operator [%s] at line %d:\n", tokenToSymbol(t->attr.operator), t->lineno);
+            fprintf(ctx->listing, "Operator [%s] at line %d:\n", tokenToSymbol(t->attr.operator), t->lineno);
             break;
           case ExpConst:
-            printf("%d", t->attr.value);
-            printf(" → Constant\n");
+            fprintf(ctx->listing, "%d", t->attr.value);
+            fprintf(ctx->listing, " → Constant\n");
             break;
           case  ExpID:
             if (t->flags.isArray) {
-              printf("%s[↓]", t->attr.arrayAttr.name);
-              printf(" → ID [Array]\n");
+              fprintf(ctx->listing, "%s[↓]", t->attr.arrayAttr.name);
+              fprintf(ctx->listing, " → ID [Array]\n");
             } else {
-              printf("%s", t->attr.name);
-              printf(" → ID\n");
+              fprintf(ctx->listing, "%s", t->attr.name);
+              fprintf(ctx->listing, " → ID\n");
             }
             break;
           case ExpCall:
-            printf("%s(...);", t->attr.name);
-            printf(" → Call at line %d\n", t->lineno);
+            fprintf(ctx->listing, "%s(...);", t->attr.name);
+            fprintf(ctx->listing, " → Call at line %d\n", t->lineno);
             break;
           default:
-            printf("Unknown Expression\n");
+            fprintf(ctx->listing, "Unknown Expression\n");
             break;
         }
         break;
 
       default:
-        printf("Unknown Node Kind\n");
+        fprintf(ctx->listing, "Unknown Node Kind\n");
         break;
     }
 
     for (int i = 0; i < MAXCHILDREN; i++)
-      printTree(t->child[i]);
+      printSubtree(ctx, t->child[i], indent);
 
     t = t->sibling;
   }
-  UNINDENT;
+}
+
+/*  printTree() → Prints the Abstract Syntax Tree (AST) in a hierarchical format   */
+void printTree(CompilerContext *ctx, TreeNode *t) {
+  printSubtree(ctx, t, 0);
 }
\ No newline at end of file
@@ -12,16 +12,16 @@
  *  Indentation and Design functions
  *---------------------------------*/
  
-void newLine(void);
+void newLine(CompilerContext *ctx);
 
-void printBars(void);
+void printBars(CompilerContext *ctx);
 
 /*--------------------------------------------/
  *  Utility functions
  *---------------------------------*/
 
 /*  inputSelect() → Searches for the input folder provided and lists the files, allowing you to select one to use   */
-void inputSelect(void);
+void inputSelect(CompilerContext *ctx);
 
 /*  tokenToString() → Transforms a numeric token into a string token based on the table generated by the parser (YACC-Bison)   */
 const char *tokenToString(int token);
@@ -32,20 +32,39 @@ const char *expTypeToString(ExpType expType);
 /*  declKindToString() → Transforms a Declaration Kind enum into a string refered to that declaration type   */
 const char *declKindToString(DeclKind declKind);
 
+/*  internName() → Canonical copy of a name (identifier, scope, register or label): equal names share one pointer   */
+char *internName(CompilerContext *ctx, const char *s);
+
+/*  allocOrDie() → Zeroed block of "size" bytes for the working arrays of the passes; running out of memory ends the compiler   */
+void *allocOrDie(size_t size);
+
+/*  printMemoryReport() → Prints how much memory the compilation needed (arena and Quadruples List)   */
+void printMemoryReport(CompilerContext *ctx);
+
+/*  now() → Monotonic wall clock in seconds   */
+double now(void);
+
+/*  countLines() → Counts the source lines of a file (a last line without its newline included), 0 if it cannot be read   */
+long countLines(const char *path);
+
+/*  peakRSS() → Peak resident set size of the process, in KiB (since the kernel's peak was last reset through
+ *  /proc/self/clear_refs, where it can be)   */
+long peakRSS(void);
+
 /*--------------------------------------------/
  *  Abstract Syntax Tree (AST) functions
  *---------------------------------*/
 
-TreeNode *newDeclNode(DeclKind kind);
+TreeNode *newDeclNode(CompilerContext *ctx, DeclKind kind);
 
-TreeNode *newStmtNode(StmtKind kind);
+TreeNode *newStmtNode(CompilerContext *ctx, StmtKind kind);
 
-TreeNode *newExpNode(ExpKind kind);
+TreeNode *newExpNode(CompilerContext *ctx, ExpKind kind);
 
 TreeNode *addSibling(TreeNode *t, TreeNode *sibling);
 
 void insertScope(TreeNode *tree, char *scope);
 
-void printTree(TreeNode *t);
+void printTree(CompilerContext *ctx, TreeNode *t);
 
 #endif
\ No newline at end of file